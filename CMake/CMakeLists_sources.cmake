@@ -8,10 +8,24 @@ source/Algorithm/CORDIC_r.cpp
 source/Core/Angle.cpp
 source/Core/Angle.h
 source/Core/AngleDefine.h
+source/Core/ArrayView.h
+source/Core/BitMask.h
 source/Core/CMath.cpp
 source/Core/CMath.h
+source/Core/Half.cpp
+source/Core/Half.h
+source/Core/Parallel.cpp
+source/Core/Parallel.h
+source/Core/SIMD.cpp
+source/Core/SIMD.h
 source/Interpolation.cpp
 source/Interpolation.h
+source/IO/BinaryArchive.cpp
+source/IO/BinaryArchive.h
+source/IO/PointCloudReader.cpp
+source/IO/PointCloudReader.h
+source/Matrix/Affine3.cpp
+source/Matrix/Affine3.h
 source/Matrix/Matrix.h
 source/Matrix/Matrix2.cpp
 source/Matrix/Matrix2.h
@@ -19,19 +33,52 @@ source/Matrix/Matrix3.cpp
 source/Matrix/Matrix3.h
 source/Matrix/Matrix4.cpp
 source/Matrix/Matrix4.h
+source/Matrix/Matrix4d.cpp
+source/Matrix/Matrix4d.h
+source/Matrix/MatrixBatch.cpp
+source/Matrix/MatrixBatch.h
+source/Matrix/MatrixKernels.h
+source/Matrix/Skinning.cpp
+source/Matrix/Skinning.h
+source/Matrix/TMatrix.h
+source/Matrix/TransformHierarchy.cpp
+source/Matrix/TransformHierarchy.h
 source/pch.h
 source/Quaternion/Quaternion.cpp
 source/Quaternion/Quaternion.h
+source/Quaternion/QuaternionD.h
+source/Quaternion/QuaternionH.h
 source/Random.cpp
 source/Random.h
+source/Spatial/AABB.h
+source/Spatial/Culling.cpp
+source/Spatial/Culling.h
+source/Spatial/Frustum.cpp
+source/Spatial/Frustum.h
+source/Spatial/KDTree.h
+source/Spatial/PointTraits.h
+source/Spatial/SpatialHashGrid.h
+source/Spatial/SpatialSort.cpp
+source/Spatial/SpatialSort.h
 source/Test.cpp
 source/Test.h
+source/Vector/Compression.cpp
+source/Vector/Compression.h
 source/Vector/TVector2.h
 source/Vector/Vector.h
 source/Vector/Vector2.cpp
 source/Vector/Vector2.h
 source/Vector/Vector3.cpp
 source/Vector/Vector3.h
+source/Vector/Vector3SoA.cpp
+source/Vector/Vector3SoA.h
 source/Vector/Vector4.cpp
 source/Vector/Vector4.h
+source/Vector/VectorBatch.cpp
+source/Vector/VectorBatch.h
+source/Vector/VectorD.cpp
+source/Vector/VectorD.h
+source/Vector/VectorH.h
+source/Vector/VectorReduction.cpp
+source/Vector/VectorReduction.h
 	)
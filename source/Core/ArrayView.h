@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LibMath
+{
+	/**
+	 * @brief Non owning view over a contiguous array, used where a function hands out memory it keeps ownership of.
+	 *
+	 * @tparam T Type of the elements, usually const
+	 */
+	template <class T>
+	struct ArrayView
+	{
+		constexpr ArrayView() = default;
+		constexpr ArrayView(T* pointer, const size_t elementCount) : data(pointer), count(elementCount) {}
+
+		[[nodiscard]] constexpr size_t Size() const { return count; }
+		[[nodiscard]] constexpr bool Empty() const { return count == 0; }
+
+		constexpr T& operator[](const size_t index) const { return data[index]; }
+
+		constexpr T* begin() const { return data; }
+		constexpr T* end() const { return data + count; }
+
+		T* data = nullptr;/**< first element*/
+		size_t count = 0;/**< number of elements*/
+	};
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LibMath
+{
+	/**
+	 * @brief Number of 32 bit words of the bitmask of count objects, bit (i % 32) of word (i / 32) standing for object i.
+	 * Shared by the kernels writing visibility masks, Culling and MatrixBatch::ProjectPoints() for instance.
+	 *
+	 * @param count Number of objects
+	 * @return Number of words
+	 */
+	constexpr size_t MaskWordCount(const size_t count) { return (count + 31) / 32; }
+}
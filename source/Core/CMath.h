@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "Core/SIMD.h"
+
 namespace LibMath
 {
 	const float MY_FLT_EPSILON = 1.192092896e-07F; // smallest such that 1.0+FLT_EPSILON != 1.0
@@ -24,6 +30,50 @@ namespace LibMath
 
 	constexpr float NaN = static_cast<float>(1e+300 * 1e+300) * 0.f;
 
+	/**
+	 * @brief Accuracy requested from InverseSqrt and the fast normalization functions.
+	 */
+	enum class SqrtPrecision
+	{
+		ESTIMATE,		/**< Hardware estimate only, about 12 bits of precision*/
+		NEWTON_RAPHSON,	/**< Estimate refined by one Newton-Raphson step, about 22 bits of precision*/
+		EXACT,			/**< Correctly rounded sqrt followed by a division*/
+	};
+
+	/**
+	 * @brief Compute 1 / sqrt(value). Cheaper than a sqrt followed by a division unless EXACT is requested.
+	 *
+	 * @param value Strictly positive value
+	 * @param precision Accuracy of the result
+	 * @return The reciprocal square root of value
+	 */
+	inline float InverseSqrt(const float value, const SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON)
+	{
+		if (precision == SqrtPrecision::EXACT)
+		{
+			return 1.f / std::sqrt(value);
+		}
+
+#if LIBMATH_SSE
+		const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+#else
+		// Bit level initial guess, refined once more below to reach the hardware estimate precision
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		bits = 0x5f375a86u - (bits >> 1);
+		float estimate;
+		std::memcpy(&estimate, &bits, sizeof(estimate));
+		estimate *= 1.5f - 0.5f * value * estimate * estimate;
+#endif
+
+		if (precision == SqrtPrecision::ESTIMATE)
+		{
+			return estimate;
+		}
+
+		return estimate * (1.5f - 0.5f * value * estimate * estimate);
+	}
+
 	inline bool ApproxFloat(const float& a, const float& b, const float tolerance = MY_FLT_EPSILON)
 	{
 		return Absolute(a - b) < tolerance;
@@ -0,0 +1,111 @@
+#include "Half.h"
+
+#include "SIMD.h"
+
+namespace LibMath
+{
+#if LIBMATH_SSE
+	namespace
+	{
+		LIBMATH_TARGET("avx,f16c")
+		size_t ConvertToHalfF16C(const float* input, Half* output, const size_t count)
+		{
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), half);
+			}
+			return i;
+		}
+
+		LIBMATH_TARGET("avx,f16c")
+		size_t ConvertToFloatF16C(const Half* input, float* output, const size_t count)
+		{
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+				_mm256_storeu_ps(output + i, _mm256_cvtph_ps(half));
+			}
+			return i;
+		}
+	}
+#endif
+
+	void ConvertToHalf(const float* input, Half* output, const size_t count)
+	{
+		size_t i = 0;
+#if LIBMATH_SSE
+		if (SIMD::HasF16C())
+		{
+			i = ConvertToHalfF16C(input, output, count);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			output[i].bits = Half::FromFloat(input[i]);
+		}
+	}
+
+	void ConvertToFloat(const Half* input, float* output, const size_t count)
+	{
+		size_t i = 0;
+#if LIBMATH_SSE
+		if (SIMD::HasF16C())
+		{
+			i = ConvertToFloatF16C(input, output, count);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			output[i] = Half::ToFloat(input[i].bits);
+		}
+	}
+
+	void ConvertToBFloat16(const float* input, BFloat16* output, const size_t count)
+	{
+		size_t i = 0;
+#if LIBMATH_SSE
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i roundingBias = _mm_set1_epi32(0x7FFF);
+		const __m128i quietBit = _mm_set1_epi32(0x400000);
+		const __m128i packBias = _mm_set1_epi32(0x8000);
+		const __m128i unpackBias = _mm_set1_epi16(static_cast<short>(0x8000));
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 value = _mm_loadu_ps(input + i);
+			const __m128i bits = _mm_castps_si128(value);
+
+			const __m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(roundingBias, _mm_and_si128(_mm_srli_epi32(bits, 16), one)));
+			const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(value, value));
+			const __m128i result = _mm_srli_epi32(_mm_or_si128(_mm_and_si128(isNaN, _mm_or_si128(bits, quietBit)), _mm_andnot_si128(isNaN, rounded)), 16);
+
+			// Bias to the signed range so the saturating pack keeps the 16 bits intact
+			const __m128i biased = _mm_sub_epi32(result, packBias);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), _mm_xor_si128(_mm_packs_epi32(biased, biased), unpackBias));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			output[i].bits = BFloat16::FromFloat(input[i]);
+		}
+	}
+
+	void ConvertToFloat(const BFloat16* input, float* output, const size_t count)
+	{
+		size_t i = 0;
+#if LIBMATH_SSE
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i bits = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i));
+			_mm_storeu_ps(output + i, _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), bits)));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			output[i] = BFloat16::ToFloat(input[i].bits);
+		}
+	}
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace LibMath
+{
+	/**
+	 * IEEE 754 binary16 storage type: 1 sign bit, 5 exponent bits and 10 mantissa bits.
+	 * It is only meant to store values compactly, convert it to float to compute.
+	 */
+	struct Half
+	{
+		uint16_t bits = 0;
+
+		Half() = default;
+		explicit Half(const float value) : bits(FromFloat(value)) {}
+
+		explicit operator float() const { return ToFloat(bits); }
+
+		/**
+		 * @brief Convert a float to binary16 bits, rounding to nearest even.
+		 * Values too large become infinity, NaN stays NaN.
+		 *
+		 * @param value Float to convert
+		 * @return The binary16 bits
+		 */
+		static uint16_t FromFloat(const float value)
+		{
+			uint32_t floatBits;
+			std::memcpy(&floatBits, &value, sizeof(floatBits));
+
+			const uint32_t sign = floatBits & 0x80000000u;
+			floatBits ^= sign;
+
+			uint32_t result;
+			if (floatBits >= (127u + 16u) << 23)
+			{
+				// Overflow to infinity, quiet NaN for NaN
+				result = floatBits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+			}
+			else if (floatBits < 113u << 23)
+			{
+				// Subnormal result: let the float adder align and round the mantissa
+				const uint32_t magicBits = (127u - 15u + 23u - 10u + 1u) << 23;
+				float magic;
+				float shifted;
+				std::memcpy(&magic, &magicBits, sizeof(magic));
+				std::memcpy(&shifted, &floatBits, sizeof(shifted));
+				shifted += magic;
+				std::memcpy(&result, &shifted, sizeof(result));
+				result -= magicBits;
+			}
+			else
+			{
+				// Rebias the exponent and round the 13 dropped mantissa bits to nearest even
+				const uint32_t oddMantissa = (floatBits >> 13) & 1u;
+				result = (floatBits + ((15u - 127u) << 23) + 0xFFFu + oddMantissa) >> 13;
+			}
+
+			return static_cast<uint16_t>(result | (sign >> 16));
+		}
+
+		/**
+		 * @brief Convert binary16 bits to a float, exactly.
+		 *
+		 * @param halfBits The binary16 bits
+		 * @return The float value
+		 */
+		static float ToFloat(const uint16_t halfBits)
+		{
+			constexpr uint32_t shiftedExponent = 0x7C00u << 13;
+
+			uint32_t result = (halfBits & 0x7FFFu) << 13;
+			const uint32_t exponent = result & shiftedExponent;
+			result += (127u - 15u) << 23;
+
+			if (exponent == shiftedExponent)
+			{
+				// Infinity or NaN
+				result += (128u - 16u) << 23;
+			}
+			else if (exponent == 0)
+			{
+				// Subnormal: renormalize through a float subtraction
+				const uint32_t magicBits = 113u << 23;
+				float magic;
+				float value;
+				result += 1u << 23;
+				std::memcpy(&magic, &magicBits, sizeof(magic));
+				std::memcpy(&value, &result, sizeof(value));
+				value -= magic;
+				std::memcpy(&result, &value, sizeof(result));
+			}
+
+			result |= static_cast<uint32_t>(halfBits & 0x8000u) << 16;
+
+			float value;
+			std::memcpy(&value, &result, sizeof(value));
+			return value;
+		}
+	};
+
+	/**
+	 * bfloat16 storage type: the upper 16 bits of a float. It keeps the float range with
+	 * only 8 bits of precision, convert it to float to compute.
+	 */
+	struct BFloat16
+	{
+		uint16_t bits = 0;
+
+		BFloat16() = default;
+		explicit BFloat16(const float value) : bits(FromFloat(value)) {}
+
+		explicit operator float() const { return ToFloat(bits); }
+
+		/**
+		 * @brief Convert a float to bfloat16 bits, rounding to nearest even. NaN stays NaN.
+		 *
+		 * @param value Float to convert
+		 * @return The bfloat16 bits
+		 */
+		static uint16_t FromFloat(const float value)
+		{
+			uint32_t floatBits;
+			std::memcpy(&floatBits, &value, sizeof(floatBits));
+
+			if ((floatBits & 0x7FFFFFFFu) > 0x7F800000u)
+			{
+				// Keep NaN quiet, rounding could turn it into infinity
+				return static_cast<uint16_t>((floatBits >> 16) | 0x40u);
+			}
+
+			return static_cast<uint16_t>((floatBits + 0x7FFFu + ((floatBits >> 16) & 1u)) >> 16);
+		}
+
+		/**
+		 * @brief Convert bfloat16 bits to a float, exactly.
+		 *
+		 * @param bfloatBits The bfloat16 bits
+		 * @return The float value
+		 */
+		static float ToFloat(const uint16_t bfloatBits)
+		{
+			const uint32_t floatBits = static_cast<uint32_t>(bfloatBits) << 16;
+			float value;
+			std::memcpy(&value, &floatBits, sizeof(value));
+			return value;
+		}
+	};
+
+	static_assert(sizeof(Half) == 2, "Half must stay tightly packed to be used in arrays");
+	static_assert(sizeof(BFloat16) == 2, "BFloat16 must stay tightly packed to be used in arrays");
+
+	/**
+	 * @brief Convert an array of float to Half, with F16C when the CPU has it.
+	 *
+	 * @param input Array of float
+	 * @param output Array receiving the Half values
+	 * @param count Number of values in both arrays
+	 */
+	void ConvertToHalf(const float* input, Half* output, size_t count);
+
+	/**
+	 * @brief Convert an array of Half to float, with F16C when the CPU has it.
+	 *
+	 * @param input Array of Half
+	 * @param output Array receiving the float values
+	 * @param count Number of values in both arrays
+	 */
+	void ConvertToFloat(const Half* input, float* output, size_t count);
+
+	/**
+	 * @brief Convert an array of float to BFloat16, four values per SSE instruction.
+	 *
+	 * @param input Array of float
+	 * @param output Array receiving the BFloat16 values
+	 * @param count Number of values in both arrays
+	 */
+	void ConvertToBFloat16(const float* input, BFloat16* output, size_t count);
+
+	/**
+	 * @brief Convert an array of BFloat16 to float, four values per SSE instruction.
+	 *
+	 * @param input Array of BFloat16
+	 * @param output Array receiving the float values
+	 * @param count Number of values in both arrays
+	 */
+	void ConvertToFloat(const BFloat16* input, float* output, size_t count);
+}
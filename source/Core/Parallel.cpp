@@ -0,0 +1,153 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LibMath::Parallel
+{
+	namespace
+	{
+		/**
+		 * @brief State shared by the caller and the workers helping on one ForEachChunk call.
+		 */
+		struct Batch
+		{
+			std::function<void(size_t)> const* function = nullptr;
+			size_t chunkCount = 0;
+			std::atomic<size_t> nextChunk{ 0 };
+			std::atomic<size_t> doneChunks{ 0 };
+			std::mutex mutex;
+			std::condition_variable done;
+
+			void Execute()
+			{
+				for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+				{
+					(*function)(chunk);
+
+					if (++doneChunks == chunkCount)
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						done.notify_all();
+					}
+				}
+			}
+		};
+
+		class ThreadPool
+		{
+		public:
+			explicit ThreadPool(const unsigned int workerCount)
+			{
+				for (unsigned int i = 0; i < workerCount; i++)
+				{
+					m_workers.emplace_back([this] { WorkerLoop(); });
+				}
+			}
+
+			~ThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stop = true;
+				}
+				m_wakeUp.notify_all();
+
+				for (std::thread& worker : m_workers)
+				{
+					worker.join();
+				}
+			}
+
+			ThreadPool(const ThreadPool& other) = delete;
+			ThreadPool& operator=(const ThreadPool& other) = delete;
+
+			void Submit(const std::shared_ptr<Batch>& batch, const size_t helperCount)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					for (size_t i = 0; i < helperCount; i++)
+					{
+						m_jobs.push_back(batch);
+					}
+				}
+				m_wakeUp.notify_all();
+			}
+
+		private:
+			void WorkerLoop()
+			{
+				for (;;)
+				{
+					std::shared_ptr<Batch> batch;
+					{
+						std::unique_lock<std::mutex> lock(m_mutex);
+						m_wakeUp.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+						if (m_stop && m_jobs.empty())
+						{
+							return;
+						}
+
+						batch = std::move(m_jobs.front());
+						m_jobs.pop_front();
+					}
+
+					batch->Execute();
+				}
+			}
+
+			std::vector<std::thread> m_workers;
+			std::deque<std::shared_ptr<Batch>> m_jobs;
+			std::mutex m_mutex;
+			std::condition_variable m_wakeUp;
+			bool m_stop = false;
+		};
+
+		ThreadPool& GetPool()
+		{
+			static ThreadPool pool(ThreadCount() - 1);
+			return pool;
+		}
+	}
+
+	unsigned int ThreadCount()
+	{
+		static const unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+		return count;
+	}
+
+	void ForEachChunk(const size_t chunkCount, const std::function<void(size_t)>& chunkFunction)
+	{
+		if (chunkCount == 0)
+		{
+			return;
+		}
+
+		if (chunkCount == 1 || ThreadCount() == 1)
+		{
+			for (size_t chunk = 0; chunk < chunkCount; chunk++)
+			{
+				chunkFunction(chunk);
+			}
+			return;
+		}
+
+		auto batch = std::make_shared<Batch>();
+		batch->function = &chunkFunction;
+		batch->chunkCount = chunkCount;
+
+		GetPool().Submit(batch, std::min<size_t>(chunkCount - 1, ThreadCount() - 1));
+
+		// The caller works too, so it only ever waits on chunks already running on a worker
+		batch->Execute();
+
+		std::unique_lock<std::mutex> lock(batch->mutex);
+		batch->done.wait(lock, [&batch] { return batch->doneChunks == batch->chunkCount; });
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace LibMath
+{
+	/**
+	 * @brief Minimal fork-join helpers used by the batched kernels.
+	 * Work is executed by a lazily created pool of worker threads and by the calling thread,
+	 * which always participates so nested calls can never deadlock.
+	 */
+	namespace Parallel
+	{
+		/**
+		 * @brief Number of threads (workers + caller) the helpers use at most.
+		 *
+		 * @return The hardware concurrency, at least 1
+		 */
+		unsigned int ThreadCount();
+
+		/**
+		 * @brief Run chunkFunction(chunkIndex) for every chunk in [0, chunkCount), in parallel.
+		 * Returns once every chunk has been executed.
+		 *
+		 * @param chunkCount Number of chunks to execute
+		 * @param chunkFunction Function executed once per chunk index
+		 */
+		void ForEachChunk(size_t chunkCount, const std::function<void(size_t)>& chunkFunction);
+
+		/**
+		 * @brief Split [0, count) in contiguous ranges of at least minRangeSize elements and call
+		 * rangeFunction(begin, end) for each of them in parallel. Small inputs run on the calling thread.
+		 *
+		 * @tparam Function Callable as void(size_t begin, size_t end)
+		 * @param count Number of elements to process
+		 * @param minRangeSize Minimum number of elements worth sending to an other thread
+		 * @param rangeFunction Function processing one range
+		 */
+		template <class Function>
+		void For(const size_t count, const size_t minRangeSize, Function&& rangeFunction)
+		{
+			const size_t grain = minRangeSize > 0 ? minRangeSize : 1;
+			size_t rangeCount = count / grain;
+			if (rangeCount > ThreadCount())
+			{
+				rangeCount = ThreadCount();
+			}
+
+			if (rangeCount <= 1)
+			{
+				if (count > 0)
+				{
+					rangeFunction(size_t(0), count);
+				}
+				return;
+			}
+
+			ForEachChunk(rangeCount, [&](const size_t range)
+			{
+				rangeFunction(count * range / rangeCount, count * (range + 1) / rangeCount);
+			});
+		}
+
+		/**
+		 * @brief Run two functions in parallel and wait for both.
+		 *
+		 * @param first Function executed on any thread
+		 * @param second Function executed on any thread
+		 */
+		template <class First, class Second>
+		void Invoke(First&& first, Second&& second)
+		{
+			ForEachChunk(2, [&](const size_t index)
+			{
+				if (index == 0)
+				{
+					first();
+				}
+				else
+				{
+					second();
+				}
+			});
+		}
+	
+		/**
+		 * @brief Deterministic parallel reduction. [0, count) is cut in chunks of chunkSize elements whatever
+		 * the number of threads, each chunk is reduced by rangeFunction(begin, end) and the partial results are
+		 * combined pairwise as a balanced tree in chunk order. The result only depends on count and chunkSize.
+		 *
+		 * @tparam T Type of the partial results
+		 * @tparam RangeFunction Callable as T(size_t begin, size_t end)
+		 * @tparam CombineFunction Callable as T(const T& first, const T& second)
+		 * @param count Number of elements to reduce
+		 * @param chunkSize Number of elements reduced by one call to rangeFunction
+		 * @param identity Result of an empty reduction
+		 * @param rangeFunction Function reducing one chunk
+		 * @param combineFunction Function combining two consecutive partial results
+		 * @return The reduction of the whole range
+		 */
+		template <class T, class RangeFunction, class CombineFunction>
+		T Reduce(const size_t count, const size_t chunkSize, const T& identity, RangeFunction&& rangeFunction, CombineFunction&& combineFunction)
+		{
+			if (count == 0)
+			{
+				return identity;
+			}
+
+			const size_t grain = chunkSize > 0 ? chunkSize : 1;
+			const size_t chunkCount = (count + grain - 1) / grain;
+			std::vector<T> partials(chunkCount, identity);
+
+			For(chunkCount, 1, [&](const size_t begin, const size_t end)
+			{
+				for (size_t chunk = begin; chunk < end; chunk++)
+				{
+					partials[chunk] = rangeFunction(chunk * grain, std::min(count, (chunk + 1) * grain));
+				}
+			});
+
+			for (size_t step = 1; step < chunkCount; step *= 2)
+			{
+				for (size_t i = 0; i + step < chunkCount; i += 2 * step)
+				{
+					partials[i] = combineFunction(partials[i], partials[i + step]);
+				}
+			}
+
+			return partials[0];
+		}
+	}
+}
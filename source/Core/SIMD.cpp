@@ -0,0 +1,73 @@
+#include "SIMD.h"
+
+#if LIBMATH_SSE && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace LibMath::SIMD
+{
+	namespace
+	{
+		struct CPUFeatures
+		{
+			bool avx2 = false;
+			bool fma = false;
+			bool f16c = false;
+			bool bmi2 = false;
+
+			CPUFeatures()
+			{
+#if LIBMATH_SSE && defined(_MSC_VER)
+				int info[4];
+				__cpuid(info, 0);
+				const int maxLeaf = info[0];
+
+				__cpuid(info, 1);
+				const bool osSavesAVX = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+				const bool avx = osSavesAVX && (info[2] & (1 << 28)) != 0;
+				fma = avx && (info[2] & (1 << 12)) != 0;
+				f16c = avx && (info[2] & (1 << 29)) != 0;
+
+				if (maxLeaf >= 7)
+				{
+					__cpuidex(info, 7, 0);
+					avx2 = avx && (info[1] & (1 << 5)) != 0;
+					bmi2 = (info[1] & (1 << 8)) != 0;
+				}
+#elif LIBMATH_SSE
+				__builtin_cpu_init();
+				avx2 = __builtin_cpu_supports("avx2");
+				fma = __builtin_cpu_supports("fma");
+				f16c = __builtin_cpu_supports("f16c");
+				bmi2 = __builtin_cpu_supports("bmi2");
+#endif
+			}
+		};
+
+		const CPUFeatures& GetFeatures()
+		{
+			static const CPUFeatures features;
+			return features;
+		}
+	}
+
+	bool HasAVX2()
+	{
+		return GetFeatures().avx2;
+	}
+
+	bool HasFMA()
+	{
+		return GetFeatures().fma;
+	}
+
+	bool HasF16C()
+	{
+		return GetFeatures().f16c;
+	}
+
+	bool HasBMI2()
+	{
+		return GetFeatures().bmi2;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * LIBMATH_SSE is set to 1 whenever SSE2 can be used without any runtime check
+ * (every x64 target and x86 builds compiled with SSE2). Every kernel relying on
+ * it must keep a scalar path for the other targets.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LIBMATH_SSE 1
+#include <immintrin.h>
+#else
+#define LIBMATH_SSE 0
+#endif
+
+/**
+ * LIBMATH_TARGET(features) enables instruction sets beyond the compilation flags for one
+ * function, so AVX2/FMA/F16C/BMI2 kernels can live next to the baseline ones. Such a function
+ * must only be called after checking the matching SIMD::Has*() function.
+ * MSVC accepts every intrinsic without it.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define LIBMATH_TARGET(features) __attribute__((target(features)))
+#else
+#define LIBMATH_TARGET(features)
+#endif
+
+namespace LibMath::SIMD
+{
+	/*
+	* @name Runtime detection of the optional instruction sets, false on non x86 targets
+	*/
+	/*@{*/
+	bool HasAVX2();
+	bool HasFMA();
+	bool HasF16C();
+	bool HasBMI2();
+	/*@}*/
+
+#if LIBMATH_SSE
+	/**
+	 * @brief Load 4 consecutive Vector3 (12 floats) and transpose them into one register per component.
+	 *
+	 * @param data Pointer on the x component of the first Vector3
+	 * @param x Receives (x0, x1, x2, x3)
+	 * @param y Receives (y0, y1, y2, y3)
+	 * @param z Receives (z0, z1, z2, z3)
+	 */
+	inline void LoadVector3x4(const float* data, __m128& x, __m128& y, __m128& z)
+	{
+		const __m128 a = _mm_loadu_ps(data);		// x0 y0 z0 x1
+		const __m128 b = _mm_loadu_ps(data + 4);	// y1 z1 x2 y2
+		const __m128 c = _mm_loadu_ps(data + 8);	// z2 x3 y3 z3
+
+		x = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 2, 3, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 1, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	/**
+	 * @brief Transpose one register per component back into 4 consecutive Vector3 (12 floats).
+	 *
+	 * @param data Pointer on the x component of the first Vector3
+	 * @param x (x0, x1, x2, x3)
+	 * @param y (y0, y1, y2, y3)
+	 * @param z (z0, z1, z2, z3)
+	 */
+	inline void StoreVector3x4(float* data, const __m128 x, const __m128 y, const __m128 z)
+	{
+		const __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+		_mm_storeu_ps(data, a);
+		_mm_storeu_ps(data + 4, b);
+		_mm_storeu_ps(data + 8, c);
+	}
+
+	/**
+	 * @brief Select lanes from two registers without requiring SSE4.1.
+	 *
+	 * @param mask All bits set in the lanes to take from ifTrue
+	 * @param ifTrue Lanes used where the mask is set
+	 * @param ifFalse Lanes used where the mask is cleared
+	 * @return The blended register
+	 */
+	inline __m128 Select(const __m128 mask, const __m128 ifTrue, const __m128 ifFalse)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+	}
+#endif
+}
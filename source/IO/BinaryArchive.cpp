@@ -0,0 +1,457 @@
+#include "BinaryArchive.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LibMath
+{
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Archive payloads expect tightly packed Vector3");
+	static_assert(sizeof(Vector4) == 4 * sizeof(float), "Archive payloads expect tightly packed Vector4");
+	static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Archive payloads expect tightly packed Quaternion");
+	static_assert(sizeof(Matrix4) == 16 * sizeof(float), "Archive payloads expect tightly packed Matrix4");
+
+	namespace
+	{
+		constexpr char ARCHIVE_MAGIC[4] = { 'L', 'M', 'B', 'A' };
+		constexpr uint32_t ARCHIVE_VERSION = 1;
+		constexpr uint64_t ARCHIVE_ALIGNMENT = 64;
+		constexpr uint64_t FILE_HEADER_SIZE = 64;
+		constexpr uint64_t BLOCK_HEADER_SIZE = 64;
+		constexpr size_t BLOCK_NAME_SIZE = 32;
+
+		/**
+		 * @brief Floats gathered on the stack before each write of a SOA component.
+		 */
+		constexpr size_t WRITE_BUFFER_SIZE = 4096;
+
+		/*
+		* @name Header fields offsets
+		*/
+		/*@{*/
+		constexpr size_t FILE_VERSION_OFFSET = 4;
+		constexpr size_t FILE_BLOCK_COUNT_OFFSET = 8;
+		constexpr size_t BLOCK_TYPE_OFFSET = 32;
+		constexpr size_t BLOCK_LAYOUT_OFFSET = 36;
+		constexpr size_t BLOCK_COUNT_OFFSET = 40;
+		constexpr size_t BLOCK_PAYLOAD_SIZE_OFFSET = 48;
+		constexpr size_t BLOCK_STRIDE_OFFSET = 56;
+		/*@}*/
+
+		constexpr uint64_t Align(const uint64_t value)
+		{
+			return (value + ARCHIVE_ALIGNMENT - 1) & ~(ARCHIVE_ALIGNMENT - 1);
+		}
+
+		template <class T>
+		void StoreField(unsigned char* header, const size_t offset, const T value)
+		{
+			std::memcpy(header + offset, &value, sizeof(T));
+		}
+
+		template <class T>
+		T LoadField(const unsigned char* header, const size_t offset)
+		{
+			T value;
+			std::memcpy(&value, header + offset, sizeof(T));
+			return value;
+		}
+
+		int ComponentCountOf(const ArchiveElementType type)
+		{
+			switch (type)
+			{
+			case ArchiveElementType::VECTOR3: return 3;
+			case ArchiveElementType::VECTOR4: return 4;
+			case ArchiveElementType::QUATERNION: return 4;
+			case ArchiveElementType::MATRIX4: return 16;
+			}
+			return 0;
+		}
+
+		uint64_t PayloadSize(const ArchiveLayout layout, const uint64_t count, const int componentCount, const uint64_t componentStride)
+		{
+			// The last SOA component is not padded, like an AOS payload
+			return layout == ArchiveLayout::AOS ? count * componentCount * sizeof(float) : componentStride * (componentCount - 1) + count * sizeof(float);
+		}
+	}
+
+	//--------------------------------------------------------------------------Writer--------------------------------------------------------------------------
+
+	BinaryArchiveWriter::~BinaryArchiveWriter()
+	{
+		Close();
+	}
+
+	bool BinaryArchiveWriter::Open(const std::string& path)
+	{
+		Close();
+
+#if defined(_MSC_VER)
+		if (fopen_s(&m_file, path.c_str(), "wb") != 0)
+		{
+			m_file = nullptr;
+		}
+#else
+		m_file = std::fopen(path.c_str(), "wb");
+#endif
+		if (m_file == nullptr)
+		{
+			return false;
+		}
+
+		m_failed = false;
+		m_blockCount = 0;
+		m_fileEnd = FILE_HEADER_SIZE;
+		m_inBlock = false;
+
+		// The block count is patched by Close()
+		return WritePadding(FILE_HEADER_SIZE);
+	}
+
+	bool BinaryArchiveWriter::Close()
+	{
+		if (m_file == nullptr)
+		{
+			return false;
+		}
+
+		m_failed |= m_inBlock;
+
+		unsigned char header[FILE_HEADER_SIZE] = {};
+		std::memcpy(header, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+		StoreField(header, FILE_VERSION_OFFSET, ARCHIVE_VERSION);
+		StoreField(header, FILE_BLOCK_COUNT_OFFSET, m_blockCount);
+
+		m_failed |= !Seek(0) || std::fwrite(header, 1, sizeof(header), m_file) != sizeof(header);
+		m_failed |= std::fclose(m_file) != 0;
+		m_file = nullptr;
+		m_inBlock = false;
+
+		return !m_failed;
+	}
+
+	bool BinaryArchiveWriter::BeginBlock(const std::string& name, const ArchiveElementType type, const ArchiveLayout layout, const uint64_t count)
+	{
+		const int componentCount = ComponentCountOf(type);
+		if (m_file == nullptr || m_inBlock || componentCount == 0 || name.size() >= BLOCK_NAME_SIZE)
+		{
+			return false;
+		}
+
+		m_blockType = type;
+		m_blockLayout = layout;
+		m_blockElementCount = count;
+		m_blockWritten = 0;
+		m_componentCount = componentCount;
+		m_componentStride = layout == ArchiveLayout::SOA ? Align(count * sizeof(float)) : 0;
+
+		unsigned char header[BLOCK_HEADER_SIZE] = {};
+		std::memcpy(header, name.c_str(), name.size());
+		StoreField(header, BLOCK_TYPE_OFFSET, static_cast<uint32_t>(type));
+		StoreField(header, BLOCK_LAYOUT_OFFSET, static_cast<uint32_t>(layout));
+		StoreField(header, BLOCK_COUNT_OFFSET, count);
+		StoreField(header, BLOCK_PAYLOAD_SIZE_OFFSET, PayloadSize(layout, count, componentCount, m_componentStride));
+		StoreField(header, BLOCK_STRIDE_OFFSET, m_componentStride);
+
+		// Blocks always start aligned: the file header and every payload are padded
+		if (!Seek(m_fileEnd) || std::fwrite(header, 1, sizeof(header), m_file) != sizeof(header))
+		{
+			m_failed = true;
+			return false;
+		}
+
+		m_payloadOffset = m_fileEnd + BLOCK_HEADER_SIZE;
+		m_inBlock = true;
+		return true;
+	}
+
+	bool BinaryArchiveWriter::AppendFloats(const float* elements, const size_t count, const int componentCount)
+	{
+		if (!m_inBlock || componentCount != m_componentCount || m_blockWritten + count > m_blockElementCount)
+		{
+			return false;
+		}
+
+		if (m_blockLayout == ArchiveLayout::AOS)
+		{
+			const size_t floatCount = count * componentCount;
+			if (!Seek(m_payloadOffset + m_blockWritten * componentCount * sizeof(float)) || std::fwrite(elements, sizeof(float), floatCount, m_file) != floatCount)
+			{
+				m_failed = true;
+				return false;
+			}
+		}
+		else
+		{
+			float buffer[WRITE_BUFFER_SIZE];
+			for (int component = 0; component < componentCount; component++)
+			{
+				if (!Seek(m_payloadOffset + component * m_componentStride + m_blockWritten * sizeof(float)))
+				{
+					m_failed = true;
+					return false;
+				}
+
+				for (size_t first = 0; first < count; first += WRITE_BUFFER_SIZE)
+				{
+					const size_t size = std::min(WRITE_BUFFER_SIZE, count - first);
+					for (size_t i = 0; i < size; i++)
+					{
+						buffer[i] = elements[(first + i) * componentCount + component];
+					}
+
+					if (std::fwrite(buffer, sizeof(float), size, m_file) != size)
+					{
+						m_failed = true;
+						return false;
+					}
+				}
+			}
+		}
+
+		m_blockWritten += count;
+		return true;
+	}
+
+	bool BinaryArchiveWriter::Append(const Vector3SoA& vectors)
+	{
+		const size_t count = vectors.Size();
+		if (!m_inBlock || m_blockType != ArchiveElementType::VECTOR3 || m_blockWritten + count > m_blockElementCount)
+		{
+			return false;
+		}
+
+		if (m_blockLayout == ArchiveLayout::AOS)
+		{
+			Vector3 buffer[WRITE_BUFFER_SIZE / 3];
+			constexpr size_t bufferSize = WRITE_BUFFER_SIZE / 3;
+			for (size_t first = 0; first < count; first += bufferSize)
+			{
+				const size_t size = std::min(bufferSize, count - first);
+				for (size_t i = 0; i < size; i++)
+				{
+					buffer[i] = vectors.Get(first + i);
+				}
+
+				if (!AppendFloats(&buffer[0].x, size, 3))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		const float* components[3] = { vectors.X(), vectors.Y(), vectors.Z() };
+		for (int component = 0; component < 3; component++)
+		{
+			if (!Seek(m_payloadOffset + component * m_componentStride + m_blockWritten * sizeof(float)) || std::fwrite(components[component], sizeof(float), count, m_file) != count)
+			{
+				m_failed = true;
+				return false;
+			}
+		}
+
+		m_blockWritten += count;
+		return true;
+	}
+
+	bool BinaryArchiveWriter::EndBlock()
+	{
+		if (!m_inBlock || m_blockWritten != m_blockElementCount)
+		{
+			return false;
+		}
+
+		const uint64_t payloadSize = PayloadSize(m_blockLayout, m_blockElementCount, m_componentCount, m_componentStride);
+		if (!Seek(m_payloadOffset + payloadSize) || !WritePadding(Align(payloadSize) - payloadSize))
+		{
+			m_failed = true;
+			return false;
+		}
+
+		m_inBlock = false;
+		m_blockCount++;
+		m_fileEnd = m_payloadOffset + Align(payloadSize);
+		return true;
+	}
+
+	bool BinaryArchiveWriter::WriteBlock(const std::string& name, const Vector3SoA& vectors, const ArchiveLayout layout)
+	{
+		return BeginBlock(name, ArchiveElementType::VECTOR3, layout, vectors.Size()) && Append(vectors) && EndBlock();
+	}
+
+	bool BinaryArchiveWriter::Seek(const uint64_t offset)
+	{
+#if defined(_MSC_VER)
+		return _fseeki64(m_file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+		return fseeko(m_file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+	}
+
+	bool BinaryArchiveWriter::WritePadding(const uint64_t size)
+	{
+		static const unsigned char zeros[ARCHIVE_ALIGNMENT] = {};
+		return size <= ARCHIVE_ALIGNMENT && std::fwrite(zeros, 1, static_cast<size_t>(size), m_file) == size;
+	}
+
+	//--------------------------------------------------------------------------Reader--------------------------------------------------------------------------
+
+	BinaryArchiveReader::~BinaryArchiveReader()
+	{
+		Close();
+	}
+
+	bool BinaryArchiveReader::Open(const std::string& path)
+	{
+		Close();
+
+#if defined(_WIN32)
+		const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		const HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		CloseHandle(file);
+		if (mapping == nullptr)
+		{
+			return false;
+		}
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+		{
+			CloseHandle(mapping);
+			return false;
+		}
+
+		m_mapping = mapping;
+		m_data = static_cast<const unsigned char*>(view);
+		m_size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			return false;
+		}
+
+		struct stat status;
+		void* view = MAP_FAILED;
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		}
+		close(file);
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		m_data = static_cast<const unsigned char*>(view);
+		m_size = static_cast<uint64_t>(status.st_size);
+#endif
+
+		if (m_size < FILE_HEADER_SIZE || std::memcmp(m_data, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || LoadField<uint32_t>(m_data, FILE_VERSION_OFFSET) != ARCHIVE_VERSION)
+		{
+			Close();
+			return false;
+		}
+
+		const uint64_t blockCount = LoadField<uint64_t>(m_data, FILE_BLOCK_COUNT_OFFSET);
+		uint64_t offset = FILE_HEADER_SIZE;
+		for (uint64_t i = 0; i < blockCount; i++)
+		{
+			if (m_size - offset < BLOCK_HEADER_SIZE)
+			{
+				Close();
+				return false;
+			}
+
+			const unsigned char* header = m_data + offset;
+			ArchiveBlock block;
+			block.name.assign(reinterpret_cast<const char*>(header), std::find(header, header + BLOCK_NAME_SIZE, '\0') - header);
+			block.type = static_cast<ArchiveElementType>(LoadField<uint32_t>(header, BLOCK_TYPE_OFFSET));
+			block.layout = static_cast<ArchiveLayout>(LoadField<uint32_t>(header, BLOCK_LAYOUT_OFFSET));
+			block.count = LoadField<uint64_t>(header, BLOCK_COUNT_OFFSET);
+			block.componentStride = LoadField<uint64_t>(header, BLOCK_STRIDE_OFFSET);
+			block.payload = header + BLOCK_HEADER_SIZE;
+
+			// Reject anything the writer could not have produced before trusting the sizes
+			const int componentCount = ComponentCountOf(block.type);
+			const uint64_t available = m_size - offset - BLOCK_HEADER_SIZE;
+			const bool validLayout = block.layout == ArchiveLayout::AOS ? block.componentStride == 0 : block.layout == ArchiveLayout::SOA && block.componentStride == Align(block.count * sizeof(float));
+			if (componentCount == 0 || block.count > available / sizeof(float) || !validLayout)
+			{
+				Close();
+				return false;
+			}
+
+			const uint64_t payloadSize = PayloadSize(block.layout, block.count, componentCount, block.componentStride);
+			if (LoadField<uint64_t>(header, BLOCK_PAYLOAD_SIZE_OFFSET) != payloadSize || Align(payloadSize) > available)
+			{
+				Close();
+				return false;
+			}
+
+			offset += BLOCK_HEADER_SIZE + Align(payloadSize);
+			m_blocks.push_back(std::move(block));
+		}
+
+		return true;
+	}
+
+	void BinaryArchiveReader::Close()
+	{
+		if (m_data != nullptr)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(m_data);
+			CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+			munmap(const_cast<unsigned char*>(m_data), static_cast<size_t>(m_size));
+#endif
+		}
+
+		m_data = nullptr;
+		m_size = 0;
+		m_mapping = nullptr;
+		m_blocks.clear();
+	}
+
+	size_t BinaryArchiveReader::FindBlock(const std::string& name) const
+	{
+		for (size_t i = 0; i < m_blocks.size(); i++)
+		{
+			if (m_blocks[i].name == name)
+			{
+				return i;
+			}
+		}
+		return m_blocks.size();
+	}
+
+	ArrayView<const float> BinaryArchiveReader::GetComponent(const size_t index, const int component) const
+	{
+		const ArchiveBlock& block = GetBlock(index);
+		if (block.layout != ArchiveLayout::SOA || component < 0 || component >= ComponentCountOf(block.type))
+		{
+			return ArrayView<const float>();
+		}
+		return ArrayView<const float>(reinterpret_cast<const float*>(block.payload + component * block.componentStride), static_cast<size_t>(block.count));
+	}
+}
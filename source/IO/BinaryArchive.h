@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Core/ArrayView.h"
+#include "Matrix/Matrix4.h"
+#include "Quaternion/Quaternion.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector3SoA.h"
+#include "Vector/Vector4.h"
+
+namespace LibMath
+{
+	/*
+	* Binary archive layout, little endian:
+	* - a 64 bytes file header: magic "LMBA", format version, number of blocks
+	* - for each block, a 64 bytes block header (name, element type, layout, count, payload size)
+	*   followed by its payload padded to 64 bytes.
+	* An AOS payload is the array of elements as laid out in memory. A SOA payload stores one float
+	* array per component, each one starting on a 64 bytes boundary. Every payload is therefore aligned
+	* on 64 bytes in the file and, once mapped, in memory.
+	*/
+
+	/**
+	 * @brief Type of the elements stored in a block.
+	 */
+	enum class ArchiveElementType : uint32_t
+	{
+		VECTOR3 = 1,
+		VECTOR4 = 2,
+		QUATERNION = 3,
+		MATRIX4 = 4,
+	};
+
+	/**
+	 * @brief Memory layout of a block.
+	 */
+	enum class ArchiveLayout : uint32_t
+	{
+		AOS = 0,	/**< Array of elements*/
+		SOA = 1,	/**< One float array per component*/
+	};
+
+	/**
+	 * @brief Description of a block of an archive.
+	 */
+	struct ArchiveBlock
+	{
+		std::string name;
+		ArchiveElementType type = ArchiveElementType::VECTOR3;
+		ArchiveLayout layout = ArchiveLayout::AOS;
+		uint64_t count = 0;/**< number of elements*/
+		const unsigned char* payload = nullptr;/**< first byte of the payload in the mapped file*/
+		uint64_t componentStride = 0;/**< bytes between two component arrays of a SOA block*/
+	};
+
+	/**
+	 * @brief Archive element type of the supported types.
+	 */
+	template <class T>
+	struct ArchiveElement;
+
+	template <> struct ArchiveElement<Vector3> { static constexpr ArchiveElementType Type = ArchiveElementType::VECTOR3; static constexpr int ComponentCount = 3; };
+	template <> struct ArchiveElement<Vector4> { static constexpr ArchiveElementType Type = ArchiveElementType::VECTOR4; static constexpr int ComponentCount = 4; };
+	template <> struct ArchiveElement<Quaternion> { static constexpr ArchiveElementType Type = ArchiveElementType::QUATERNION; static constexpr int ComponentCount = 4; };
+	template <> struct ArchiveElement<Matrix4> { static constexpr ArchiveElementType Type = ArchiveElementType::MATRIX4; static constexpr int ComponentCount = 16; };
+
+	/**
+	 * Writes an archive block after block, without keeping the data in memory.
+	 * <p>
+	 * A block is either written at once with WriteBlock() or streamed: BeginBlock() with the final
+	 * element count, as many Append() as needed, then EndBlock(). Every function returns false when
+	 * the file could not be written or the calls do not match the declared block.
+	 */
+	class BinaryArchiveWriter
+	{
+	public:
+		BinaryArchiveWriter() = default;
+		~BinaryArchiveWriter();
+
+		BinaryArchiveWriter(const BinaryArchiveWriter& other) = delete;
+		BinaryArchiveWriter& operator=(const BinaryArchiveWriter& other) = delete;
+
+		/**
+		 * @brief Create or truncate the archive file.
+		 *
+		 * @param path Path of the file
+		 * @return True if the file could be created
+		 */
+		bool Open(const std::string& path);
+
+		/**
+		 * @brief Finish the archive: the file header gets the final block count.
+		 *
+		 * @return True if every block was complete and the file was written
+		 */
+		bool Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_file != nullptr; }
+
+		/**
+		 * @brief Start a block of count elements.
+		 *
+		 * @param name Name used to find the block back, at most 31 characters
+		 * @param type Type of the elements
+		 * @param layout Layout of the payload
+		 * @param count Number of elements the block will contain
+		 * @return True if the block header was written
+		 */
+		bool BeginBlock(const std::string& name, ArchiveElementType type, ArchiveLayout layout, uint64_t count);
+
+		/**
+		 * @brief Append elements to the current block, their type must match the block.
+		 *
+		 * @param elements Array of elements
+		 * @param count Number of elements
+		 * @return True if the elements were written
+		 */
+		template <class T>
+		bool Append(const T* elements, const size_t count)
+		{
+			return ArchiveElement<T>::Type == m_blockType && AppendFloats(reinterpret_cast<const float*>(elements), count, ArchiveElement<T>::ComponentCount);
+		}
+
+		/**
+		 * @brief Append the content of a Vector3SoA to the current block, which must hold Vector3.
+		 *
+		 * @param vectors Vectors to append
+		 * @return True if the vectors were written
+		 */
+		bool Append(const Vector3SoA& vectors);
+
+		/**
+		 * @brief Finish the current block, every declared element must have been appended.
+		 *
+		 * @return True if the block is complete
+		 */
+		bool EndBlock();
+
+		/**
+		 * @brief Write a whole block at once.
+		 *
+		 * @param name Name used to find the block back, at most 31 characters
+		 * @param elements Array of elements
+		 * @param count Number of elements
+		 * @param layout Layout of the payload
+		 * @return True if the block was written
+		 */
+		template <class T>
+		bool WriteBlock(const std::string& name, const T* elements, const size_t count, const ArchiveLayout layout = ArchiveLayout::AOS)
+		{
+			return BeginBlock(name, ArchiveElement<T>::Type, layout, count) && Append(elements, count) && EndBlock();
+		}
+
+		bool WriteBlock(const std::string& name, const Vector3SoA& vectors, ArchiveLayout layout = ArchiveLayout::SOA);
+
+	private:
+		bool AppendFloats(const float* elements, size_t count, int componentCount);
+		bool Seek(uint64_t offset);
+		bool WritePadding(uint64_t size);
+
+		std::FILE* m_file = nullptr;
+		bool m_failed = false;
+		uint64_t m_blockCount = 0;
+		uint64_t m_fileEnd = 0;/**< end of the last complete block*/
+
+		/*
+		* @name Block being written
+		*/
+		/*@{*/
+		bool m_inBlock = false;
+		ArchiveElementType m_blockType = ArchiveElementType::VECTOR3;
+		ArchiveLayout m_blockLayout = ArchiveLayout::AOS;
+		uint64_t m_blockElementCount = 0;
+		uint64_t m_blockWritten = 0;
+		uint64_t m_payloadOffset = 0;
+		uint64_t m_componentStride = 0;
+		int m_componentCount = 0;
+		/*@}*/
+	};
+
+	/**
+	 * Maps an archive in memory and exposes its blocks without copying them.
+	 * <p>
+	 * The views handed out stay valid until Close() or the destruction of the reader.
+	 */
+	class BinaryArchiveReader
+	{
+	public:
+		BinaryArchiveReader() = default;
+		~BinaryArchiveReader();
+
+		BinaryArchiveReader(const BinaryArchiveReader& other) = delete;
+		BinaryArchiveReader& operator=(const BinaryArchiveReader& other) = delete;
+
+		/**
+		 * @brief Map an archive and validate its structure.
+		 *
+		 * @param path Path of the file
+		 * @return True if the file is a valid archive
+		 */
+		bool Open(const std::string& path);
+
+		/**
+		 * @brief Unmap the archive, invalidating every view.
+		 */
+		void Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_data != nullptr; }
+		[[nodiscard]] size_t GetBlockCount() const { return m_blocks.size(); }
+
+		/**
+		 * @brief Description of a block. GetArray() and GetComponent() read blocks through it, so every index is asserted in debug builds.
+		 *
+		 * @param index Index of the block, lower than GetBlockCount()
+		 */
+		[[nodiscard]] const ArchiveBlock& GetBlock(const size_t index) const
+		{
+			assert(index < m_blocks.size() && "block index out of the archive");
+			return m_blocks[index];
+		}
+
+		/**
+		 * @brief Find a block by name.
+		 *
+		 * @param name Name of the block
+		 * @return Index of the first block with this name, GetBlockCount() if there is none
+		 */
+		[[nodiscard]] size_t FindBlock(const std::string& name) const;
+
+		/**
+		 * @brief Elements of an AOS block.
+		 *
+		 * @param index Index of the block, lower than GetBlockCount()
+		 * @return The elements, an empty view if the block is SOA or holds an other type
+		 */
+		template <class T>
+		[[nodiscard]] ArrayView<const T> GetArray(const size_t index) const
+		{
+			const ArchiveBlock& block = GetBlock(index);
+			if (block.type != ArchiveElement<T>::Type || block.layout != ArchiveLayout::AOS)
+			{
+				return ArrayView<const T>();
+			}
+			return ArrayView<const T>(reinterpret_cast<const T*>(block.payload), static_cast<size_t>(block.count));
+		}
+
+		/**
+		 * @brief One component array of a SOA block: x, y, z (, w) for vectors, X, Y, Z, W for Quaternion, raw[component] for Matrix4.
+		 *
+		 * @param index Index of the block, lower than GetBlockCount()
+		 * @param component Index of the component
+		 * @return The component values, an empty view if the block is AOS or has no such component
+		 */
+		[[nodiscard]] ArrayView<const float> GetComponent(size_t index, int component) const;
+
+	private:
+		const unsigned char* m_data = nullptr;
+		uint64_t m_size = 0;
+		void* m_mapping = nullptr;/**< mapping handle on Windows*/
+		std::vector<ArchiveBlock> m_blocks;
+	};
+}
@@ -0,0 +1,897 @@
+#include "PointCloudReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include "Core/Parallel.h"
+
+namespace LibMath
+{
+	namespace
+	{
+		/**
+		 * @brief Bytes of text parsed by one task, lines are never split between two tasks.
+		 */
+		constexpr size_t TEXT_PIECE_SIZE = 1 << 20;
+
+		/**
+		 * @brief Binary vertices converted by one task.
+		 */
+		constexpr size_t BINARY_PIECE_SIZE = 1 << 16;
+
+		constexpr size_t MIN_CHUNK_SIZE = 1 << 16;
+
+		enum PropertyType
+		{
+			INVALID = 0,
+			INT8,
+			UINT8,
+			INT16,
+			UINT16,
+			INT32,
+			UINT32,
+			FLOAT32,
+			FLOAT64,
+		};
+
+		/**
+		 * @brief Destination of the PLY properties, matching m_propertyIndices.
+		 */
+		constexpr std::string_view TARGET_NAMES[6] = { "x", "y", "z", "nx", "ny", "nz" };
+
+		PropertyType ParsePropertyType(const std::string_view name)
+		{
+			if (name == "char" || name == "int8") return INT8;
+			if (name == "uchar" || name == "uint8") return UINT8;
+			if (name == "short" || name == "int16") return INT16;
+			if (name == "ushort" || name == "uint16") return UINT16;
+			if (name == "int" || name == "int32") return INT32;
+			if (name == "uint" || name == "uint32") return UINT32;
+			if (name == "float" || name == "float32") return FLOAT32;
+			if (name == "double" || name == "float64") return FLOAT64;
+			return INVALID;
+		}
+
+		size_t PropertySize(const int type)
+		{
+			switch (type)
+			{
+			case INT8:
+			case UINT8: return 1;
+			case INT16:
+			case UINT16: return 2;
+			case INT32:
+			case UINT32:
+			case FLOAT32: return 4;
+			case FLOAT64: return 8;
+			default: return 0;
+			}
+		}
+
+		template <class T>
+		T LoadScalar(const char* data, const bool swap)
+		{
+			unsigned char bytes[sizeof(T)];
+			std::memcpy(bytes, data, sizeof(T));
+			if (swap)
+			{
+				std::reverse(bytes, bytes + sizeof(T));
+			}
+
+			T value;
+			std::memcpy(&value, bytes, sizeof(T));
+			return value;
+		}
+
+		float LoadProperty(const char* data, const int type, const bool swap)
+		{
+			switch (type)
+			{
+			case INT8: return static_cast<float>(LoadScalar<int8_t>(data, swap));
+			case UINT8: return static_cast<float>(LoadScalar<uint8_t>(data, swap));
+			case INT16: return static_cast<float>(LoadScalar<int16_t>(data, swap));
+			case UINT16: return static_cast<float>(LoadScalar<uint16_t>(data, swap));
+			case INT32: return static_cast<float>(LoadScalar<int32_t>(data, swap));
+			case UINT32: return static_cast<float>(LoadScalar<uint32_t>(data, swap));
+			case FLOAT32: return LoadScalar<float>(data, swap);
+			case FLOAT64: return static_cast<float>(LoadScalar<double>(data, swap));
+			default: return 0.f;
+			}
+		}
+
+		bool IsBlank(const char character)
+		{
+			return character == ' ' || character == '\t' || character == '\r';
+		}
+
+		/**
+		 * @brief Parse the number following cursor, skipping the blanks before it.
+		 */
+		bool ParseFloat(const char*& cursor, const char* end, float& value)
+		{
+			while (cursor < end && IsBlank(*cursor))
+			{
+				cursor++;
+			}
+
+			if (cursor < end && *cursor == '+')
+			{
+				cursor++;
+			}
+
+			const std::from_chars_result result = std::from_chars(cursor, end, value);
+			cursor = result.ptr;
+			return result.ec == std::errc();
+		}
+
+		/**
+		 * @brief Split text on the line following every TEXT_PIECE_SIZE bytes.
+		 *
+		 * @return The start of each piece, followed by the end of the text
+		 */
+		std::vector<const char*> SplitLines(const char* begin, const char* end)
+		{
+			std::vector<const char*> bounds(1, begin);
+			const char* cursor = begin;
+			while (static_cast<size_t>(end - cursor) > TEXT_PIECE_SIZE)
+			{
+				const char* newline = static_cast<const char*>(std::memchr(cursor + TEXT_PIECE_SIZE, '\n', end - cursor - TEXT_PIECE_SIZE));
+				if (newline == nullptr)
+				{
+					break;
+				}
+
+				cursor = newline + 1;
+				bounds.push_back(cursor);
+			}
+
+			if (bounds.back() != end)
+			{
+				bounds.push_back(end);
+			}
+			return bounds;
+		}
+
+		const char* FindLine(const std::string_view text, const std::string_view keyword)
+		{
+			for (size_t position = 0; position < text.size();)
+			{
+				size_t lineEnd = text.find('\n', position);
+				lineEnd = lineEnd == std::string_view::npos ? text.size() : lineEnd;
+				std::string_view line = text.substr(position, lineEnd - position);
+				while (!line.empty() && IsBlank(line.back()))
+				{
+					line.remove_suffix(1);
+				}
+
+				if (line == keyword)
+				{
+					return text.data() + position;
+				}
+				position = lineEnd + 1;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * @brief Vertices of an OBJ piece, appended to the output once every piece is parsed.
+		 */
+		struct ObjPiece
+		{
+			Vector3SoA positions;
+			Vector3SoA normals;
+			PointCloudReader::Accumulator statistics;
+			bool failed = false;
+		};
+
+		void ParseObjPiece(const char* cursor, const char* end, const bool readNormals, const bool computeStatistics, ObjPiece& piece)
+		{
+			while (cursor < end)
+			{
+				while (cursor < end && IsBlank(*cursor))
+				{
+					cursor++;
+				}
+
+				const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+				lineEnd = lineEnd == nullptr ? end : lineEnd;
+
+				if (lineEnd - cursor > 2 && cursor[0] == 'v')
+				{
+					const bool isPosition = IsBlank(cursor[1]);
+					const bool isNormal = cursor[1] == 'n' && IsBlank(cursor[2]);
+					if (isPosition || (isNormal && readNormals))
+					{
+						const char* values = cursor + (isPosition ? 1 : 2);
+						Vector3 vector;
+						if (!ParseFloat(values, lineEnd, vector.x) || !ParseFloat(values, lineEnd, vector.y) || !ParseFloat(values, lineEnd, vector.z))
+						{
+							piece.failed = true;
+							return;
+						}
+
+						if (isPosition)
+						{
+							piece.positions.PushBack(vector);
+							if (computeStatistics)
+							{
+								piece.statistics.Add(vector);
+							}
+						}
+						else
+						{
+							piece.normals.PushBack(vector);
+						}
+					}
+				}
+
+				cursor = std::min(lineEnd + 1, end);
+			}
+		}
+
+		void AppendPieces(const std::vector<ObjPiece>& pieces, Vector3SoA& output, Vector3SoA ObjPiece::* member)
+		{
+			std::vector<size_t> offsets(pieces.size() + 1, output.Size());
+			for (size_t i = 0; i < pieces.size(); i++)
+			{
+				offsets[i + 1] = offsets[i] + (pieces[i].*member).Size();
+			}
+
+			output.Resize(offsets.back());
+			Parallel::ForEachChunk(pieces.size(), [&](const size_t i)
+			{
+				const Vector3SoA& source = pieces[i].*member;
+				std::copy(source.X(), source.X() + source.Size(), output.X() + offsets[i]);
+				std::copy(source.Y(), source.Y() + source.Size(), output.Y() + offsets[i]);
+				std::copy(source.Z(), source.Z() + source.Size(), output.Z() + offsets[i]);
+			});
+		}
+	}
+
+	void PointCloudReader::Accumulator::Add(const Vector3& position)
+	{
+		bounds.Extend(position);
+		sum[0] += position.x;
+		sum[1] += position.y;
+		sum[2] += position.z;
+		count++;
+	}
+
+	void PointCloudReader::Accumulator::Merge(const Accumulator& other)
+	{
+		bounds.Merge(other.bounds);
+		sum[0] += other.sum[0];
+		sum[1] += other.sum[1];
+		sum[2] += other.sum[2];
+		count += other.count;
+	}
+
+	PointCloudReader::PointCloudReader(const size_t chunkSize) :
+		m_chunkSize(std::max(chunkSize, MIN_CHUNK_SIZE))
+	{
+	}
+
+	PointCloudReader::~PointCloudReader()
+	{
+		Close();
+	}
+
+	bool PointCloudReader::Open(const std::string& path, const bool computeStatistics)
+	{
+		Close();
+
+#if defined(_MSC_VER)
+		if (fopen_s(&m_file, path.c_str(), "rb") != 0)
+		{
+			m_file = nullptr;
+		}
+#else
+		m_file = std::fopen(path.c_str(), "rb");
+#endif
+		if (m_file == nullptr)
+		{
+			return false;
+		}
+
+		// Measured once so the vertex count of a header can be checked against the size of the file
+#if defined(_MSC_VER)
+		const bool measured = _fseeki64(m_file, 0, SEEK_END) == 0;
+		const int64_t fileSize = measured ? _ftelli64(m_file) : -1;
+		const bool rewound = _fseeki64(m_file, 0, SEEK_SET) == 0;
+#else
+		const bool measured = fseeko(m_file, 0, SEEK_END) == 0;
+		const int64_t fileSize = measured ? static_cast<int64_t>(ftello(m_file)) : -1;
+		const bool rewound = fseeko(m_file, 0, SEEK_SET) == 0;
+#endif
+		if (!rewound)
+		{
+			Close();
+			return false;
+		}
+		m_fileSize = fileSize > 0 ? static_cast<uint64_t>(fileSize) : 0;
+
+		m_buffer.resize(m_chunkSize);
+		m_computeStatistics = computeStatistics;
+
+		if (!FillBuffer())
+		{
+			Close();
+			return false;
+		}
+
+		const std::string_view start(m_buffer.data(), std::min<size_t>(m_bufferEnd, 4));
+		if (start == "ply\n" || start == "ply\r")
+		{
+			if (!ReadHeader())
+			{
+				Close();
+				return false;
+			}
+		}
+		else
+		{
+			m_format = PointCloudFormat::OBJ;
+			m_hasNormals = true;
+		}
+
+		return true;
+	}
+
+	void PointCloudReader::Close()
+	{
+		if (m_file != nullptr)
+		{
+			std::fclose(m_file);
+		}
+
+		m_file = nullptr;
+		m_fileSize = 0;
+		m_format = PointCloudFormat::UNKNOWN;
+		m_failed = false;
+		m_endOfFile = false;
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+		m_bufferBegin = 0;
+		m_bufferEnd = 0;
+		m_vertexCount = 0;
+		m_remainingVertices = 0;
+		m_reserveCount = 0;
+		m_vertexStride = 0;
+		std::fill(std::begin(m_propertyIndices), std::end(m_propertyIndices), -1);
+		m_properties.clear();
+		m_hasNormals = false;
+		m_computeStatistics = false;
+		m_statistics = Accumulator();
+	}
+
+	bool PointCloudReader::ReadBatch(Vector3SoA& positions, Vector3SoA* normals)
+	{
+		if (m_file == nullptr || m_failed)
+		{
+			return false;
+		}
+
+		const bool read = m_format == PointCloudFormat::PLY_BINARY_LITTLE_ENDIAN || m_format == PointCloudFormat::PLY_BINARY_BIG_ENDIAN ?
+			ReadBinary(positions, normals) : ReadText(positions, normals);
+		return read && !m_failed;
+	}
+
+	PointCloudStatistics PointCloudReader::GetStatistics() const
+	{
+		PointCloudStatistics statistics;
+		statistics.bounds = m_statistics.bounds;
+		statistics.positionCount = m_statistics.count;
+		if (m_statistics.count > 0)
+		{
+			const double inverseCount = 1.0 / static_cast<double>(m_statistics.count);
+			statistics.centroid = Vector3(static_cast<float>(m_statistics.sum[0] * inverseCount), static_cast<float>(m_statistics.sum[1] * inverseCount), static_cast<float>(m_statistics.sum[2] * inverseCount));
+		}
+		return statistics;
+	}
+
+	bool PointCloudReader::ReadHeader()
+	{
+		const std::string_view text(m_buffer.data(), m_bufferEnd);
+		const char* endHeader = FindLine(text, "end_header");
+		if (endHeader == nullptr)
+		{
+			return false;
+		}
+
+		const char* headerEnd = static_cast<const char*>(std::memchr(endHeader, '\n', text.data() + text.size() - endHeader));
+		if (headerEnd == nullptr)
+		{
+			return false;
+		}
+
+		// Elements stored before the vertices are skipped, as lines or as bytes
+		uint64_t skippedLines = 0;
+		uint64_t skippedBytes = 0;
+		bool inVertex = false;
+		bool vertexFound = false;
+		bool listBeforeVertex = false;
+		bool listInVertex = false;
+		size_t elementStride = 0;
+		uint64_t elementCount = 0;
+
+		const auto finishElement = [&]()
+		{
+			if (!vertexFound && elementCount > 0)
+			{
+				skippedLines += elementCount;
+				skippedBytes += elementCount * elementStride;
+			}
+		};
+
+		for (size_t position = 0; position < static_cast<size_t>(endHeader - text.data());)
+		{
+			const size_t lineEnd = text.find('\n', position);
+			std::string_view line = text.substr(position, lineEnd - position);
+			position = lineEnd + 1;
+
+			std::string_view tokens[5];
+			size_t tokenCount = 0;
+			for (size_t cursor = 0; cursor < line.size() && tokenCount < 5;)
+			{
+				while (cursor < line.size() && IsBlank(line[cursor]))
+				{
+					cursor++;
+				}
+
+				const size_t tokenStart = cursor;
+				while (cursor < line.size() && !IsBlank(line[cursor]))
+				{
+					cursor++;
+				}
+
+				if (cursor > tokenStart)
+				{
+					tokens[tokenCount++] = line.substr(tokenStart, cursor - tokenStart);
+				}
+			}
+
+			if (tokenCount == 0)
+			{
+				continue;
+			}
+
+			if (tokens[0] == "format" && tokenCount >= 2)
+			{
+				if (tokens[1] == "ascii") m_format = PointCloudFormat::PLY_ASCII;
+				else if (tokens[1] == "binary_little_endian") m_format = PointCloudFormat::PLY_BINARY_LITTLE_ENDIAN;
+				else if (tokens[1] == "binary_big_endian") m_format = PointCloudFormat::PLY_BINARY_BIG_ENDIAN;
+				else return false;
+			}
+			else if (tokens[0] == "element" && tokenCount >= 3)
+			{
+				if (inVertex)
+				{
+					vertexFound = true;
+				}
+				finishElement();
+
+				elementCount = 0;
+				elementStride = 0;
+				const std::from_chars_result result = std::from_chars(tokens[2].data(), tokens[2].data() + tokens[2].size(), elementCount);
+				if (result.ec != std::errc())
+				{
+					return false;
+				}
+
+				inVertex = !vertexFound && tokens[1] == "vertex";
+				if (inVertex)
+				{
+					m_vertexCount = elementCount;
+				}
+			}
+			else if (tokens[0] == "property" && tokenCount >= 3)
+			{
+				if (tokens[1] == "list")
+				{
+					// Lists make the size of the elements variable: they are only supported after the vertices,
+					// or before them in ascii files where the skipped elements are whole lines
+					listBeforeVertex |= !vertexFound;
+					listInVertex |= inVertex;
+					continue;
+				}
+
+				const PropertyType type = ParsePropertyType(tokens[1]);
+				if (type == INVALID)
+				{
+					return false;
+				}
+
+				if (inVertex)
+				{
+					for (int target = 0; target < 6; target++)
+					{
+						if (tokens[2] == TARGET_NAMES[target])
+						{
+							m_propertyIndices[target] = static_cast<int>(m_properties.size());
+						}
+					}
+
+					Property property;
+					property.type = type;
+					property.offset = m_vertexStride;
+					m_properties.push_back(property);
+					m_vertexStride += PropertySize(type);
+				}
+				else
+				{
+					elementStride += PropertySize(type);
+				}
+			}
+		}
+
+		if (inVertex)
+		{
+			vertexFound = true;
+		}
+		finishElement();
+
+		const bool binary = m_format != PointCloudFormat::PLY_ASCII;
+		if (m_format == PointCloudFormat::UNKNOWN || !vertexFound || (binary && listBeforeVertex) || listInVertex
+			|| m_propertyIndices[0] < 0 || m_propertyIndices[1] < 0 || m_propertyIndices[2] < 0)
+		{
+			return false;
+		}
+
+		m_hasNormals = m_propertyIndices[3] >= 0 && m_propertyIndices[4] >= 0 && m_propertyIndices[5] >= 0;
+		m_remainingVertices = m_vertexCount;
+		m_bufferBegin = static_cast<size_t>(headerEnd + 1 - m_buffer.data());
+
+		// A binary vertex takes its stride, an ascii one at least a digit and a separator per property
+		const uint64_t payloadSize = m_fileSize > m_bufferBegin ? m_fileSize - m_bufferBegin : 0;
+		const uint64_t minimumVertexSize = binary ? m_vertexStride : 2 * m_properties.size();
+		m_reserveCount = std::min<uint64_t>(m_vertexCount, payloadSize / minimumVertexSize);
+
+		return SkipElements(binary ? 0 : skippedLines, binary ? skippedBytes : 0);
+	}
+
+	bool PointCloudReader::SkipElements(uint64_t lineCount, uint64_t byteCount)
+	{
+		while (lineCount > 0 || byteCount > 0)
+		{
+			if (m_bufferBegin == m_bufferEnd)
+			{
+				if (m_endOfFile || !FillBuffer() || m_bufferBegin == m_bufferEnd)
+				{
+					return false;
+				}
+			}
+
+			const size_t skipped = static_cast<size_t>(std::min<uint64_t>(byteCount, m_bufferEnd - m_bufferBegin));
+			m_bufferBegin += skipped;
+			byteCount -= skipped;
+
+			while (lineCount > 0 && m_bufferBegin < m_bufferEnd)
+			{
+				const char* begin = m_buffer.data() + m_bufferBegin;
+				const char* newline = static_cast<const char*>(std::memchr(begin, '\n', m_bufferEnd - m_bufferBegin));
+				m_bufferBegin = newline == nullptr ? m_bufferEnd : static_cast<size_t>(newline + 1 - m_buffer.data());
+				lineCount -= newline == nullptr ? 0 : 1;
+			}
+		}
+		return true;
+	}
+
+	bool PointCloudReader::FillBuffer()
+	{
+		// Keep the bytes not parsed yet at the start of the buffer
+		const size_t remaining = m_bufferEnd - m_bufferBegin;
+		std::memmove(m_buffer.data(), m_buffer.data() + m_bufferBegin, remaining);
+		m_bufferBegin = 0;
+		m_bufferEnd = remaining;
+
+		if (m_endOfFile || m_bufferEnd == m_buffer.size())
+		{
+			return true;
+		}
+
+		m_bufferEnd += std::fread(m_buffer.data() + m_bufferEnd, 1, m_buffer.size() - m_bufferEnd, m_file);
+		if (std::ferror(m_file))
+		{
+			m_failed = true;
+			return false;
+		}
+
+		m_endOfFile = m_bufferEnd < m_buffer.size();
+		return true;
+	}
+
+	bool PointCloudReader::ReadBinary(Vector3SoA& positions, Vector3SoA* normals)
+	{
+		if (m_remainingVertices == 0)
+		{
+			return false;
+		}
+
+		if (!FillBuffer())
+		{
+			return false;
+		}
+
+		const size_t count = static_cast<size_t>(std::min<uint64_t>(m_remainingVertices, (m_bufferEnd - m_bufferBegin) / m_vertexStride));
+		if (count == 0)
+		{
+			// Truncated file, or vertices larger than a chunk
+			m_failed = true;
+			return false;
+		}
+
+		const bool readNormals = normals != nullptr && m_hasNormals;
+		const size_t first = positions.Size();
+		positions.Resize(first + count);
+		if (readNormals)
+		{
+			normals->Resize(first + count);
+		}
+
+		Property properties[6];
+		for (int target = 0; target < 6; target++)
+		{
+			properties[target] = m_propertyIndices[target] >= 0 ? m_properties[m_propertyIndices[target]] : Property();
+		}
+
+		const char* vertices = m_buffer.data() + m_bufferBegin;
+		float* outputs[6] = { positions.X() + first, positions.Y() + first, positions.Z() + first, nullptr, nullptr, nullptr };
+		if (readNormals)
+		{
+			outputs[3] = normals->X() + first;
+			outputs[4] = normals->Y() + first;
+			outputs[5] = normals->Z() + first;
+		}
+
+		const bool swap = m_format == PointCloudFormat::PLY_BINARY_BIG_ENDIAN;
+		const bool computeStatistics = m_computeStatistics;
+		const size_t stride = m_vertexStride;
+		const int targetCount = readNormals ? 6 : 3;
+
+		const Accumulator statistics = Parallel::Reduce(count, BINARY_PIECE_SIZE, Accumulator(),
+			[&](const size_t begin, const size_t end)
+			{
+				for (int target = 0; target < targetCount; target++)
+				{
+					const char* source = vertices + properties[target].offset;
+					float* output = outputs[target];
+					for (size_t i = begin; i < end; i++)
+					{
+						output[i] = LoadProperty(source + i * stride, properties[target].type, swap);
+					}
+				}
+
+				Accumulator range;
+				if (computeStatistics)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						range.Add(Vector3(outputs[0][i], outputs[1][i], outputs[2][i]));
+					}
+				}
+				return range;
+			},
+			[](Accumulator first, const Accumulator& second) { first.Merge(second); return first; });
+
+		m_statistics.Merge(statistics);
+		m_bufferBegin += count * m_vertexStride;
+		m_remainingVertices -= count;
+		return true;
+	}
+
+	bool PointCloudReader::ReadText(Vector3SoA& positions, Vector3SoA* normals)
+	{
+		const bool isPly = m_format == PointCloudFormat::PLY_ASCII;
+		while (!isPly || m_remainingVertices > 0)
+		{
+			if (!FillBuffer())
+			{
+				return false;
+			}
+
+			const char* begin = m_buffer.data() + m_bufferBegin;
+			const char* end = m_buffer.data() + m_bufferEnd;
+			if (begin == end)
+			{
+				// A PLY file ending before its last vertex is truncated
+				m_failed = isPly;
+				return false;
+			}
+
+			// Only parse complete lines, the last one is kept for the next chunk
+			if (!m_endOfFile)
+			{
+				const char* lastNewline = begin;
+				for (const char* cursor = end; cursor > begin; cursor--)
+				{
+					if (cursor[-1] == '\n')
+					{
+						lastNewline = cursor;
+						break;
+					}
+				}
+
+				if (lastNewline == begin)
+				{
+					// A single line longer than a chunk
+					m_failed = true;
+					return false;
+				}
+				end = lastNewline;
+			}
+
+			const std::vector<const char*> bounds = SplitLines(begin, end);
+			const size_t pieceCount = bounds.size() - 1;
+			const bool computeStatistics = m_computeStatistics;
+			const size_t first = positions.Size();
+
+			if (!isPly)
+			{
+				std::vector<ObjPiece> pieces(pieceCount);
+				Parallel::ForEachChunk(pieceCount, [&](const size_t i)
+				{
+					ParseObjPiece(bounds[i], bounds[i + 1], normals != nullptr, computeStatistics, pieces[i]);
+				});
+
+				for (const ObjPiece& piece : pieces)
+				{
+					m_failed |= piece.failed;
+					m_statistics.Merge(piece.statistics);
+				}
+
+				AppendPieces(pieces, positions, &ObjPiece::positions);
+				if (normals != nullptr)
+				{
+					AppendPieces(pieces, *normals, &ObjPiece::normals);
+				}
+
+				m_bufferBegin += end - begin;
+				if (m_failed || positions.Size() > first || (normals != nullptr && normals->Size() > first))
+				{
+					return !m_failed;
+				}
+
+				if (m_endOfFile && m_bufferBegin == m_bufferEnd)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			// Every line of an ascii PLY is a vertex: count them to write each piece in place
+			std::vector<size_t> offsets(pieceCount + 1, 0);
+			Parallel::ForEachChunk(pieceCount, [&](const size_t i)
+			{
+				offsets[i + 1] = static_cast<size_t>(std::count(bounds[i], bounds[i + 1], '\n'));
+				if (bounds[i + 1] > bounds[i] && bounds[i + 1][-1] != '\n')
+				{
+					offsets[i + 1]++;
+				}
+			});
+
+			for (size_t i = 0; i < pieceCount; i++)
+			{
+				offsets[i + 1] = std::min<size_t>(offsets[i] + offsets[i + 1], static_cast<size_t>(m_remainingVertices));
+			}
+			const size_t count = offsets.back();
+
+			const bool readNormals = normals != nullptr && m_hasNormals;
+			positions.Resize(first + count);
+			if (readNormals)
+			{
+				normals->Resize(first + count);
+			}
+
+			float* outputs[6] = { positions.X() + first, positions.Y() + first, positions.Z() + first, nullptr, nullptr, nullptr };
+			if (readNormals)
+			{
+				outputs[3] = normals->X() + first;
+				outputs[4] = normals->Y() + first;
+				outputs[5] = normals->Z() + first;
+			}
+
+			// Column of every property, -1 for the ones not read
+			std::vector<int> columnTargets(m_properties.size(), -1);
+			for (int target = 0; target < (readNormals ? 6 : 3); target++)
+			{
+				columnTargets[m_propertyIndices[target]] = target;
+			}
+
+			size_t columnCount = 0;
+			for (size_t column = 0; column < columnTargets.size(); column++)
+			{
+				columnCount = columnTargets[column] >= 0 ? column + 1 : columnCount;
+			}
+
+			std::vector<Accumulator> statistics(pieceCount);
+			std::vector<const char*> pieceEnds(pieceCount, nullptr);
+			Parallel::ForEachChunk(pieceCount, [&](const size_t i)
+			{
+				const char* cursor = bounds[i];
+				for (size_t vertex = offsets[i]; vertex < offsets[i + 1]; vertex++)
+				{
+					const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', bounds[i + 1] - cursor));
+					lineEnd = lineEnd == nullptr ? bounds[i + 1] : lineEnd;
+
+					for (size_t column = 0; column < columnCount; column++)
+					{
+						float value;
+						if (!ParseFloat(cursor, lineEnd, value))
+						{
+							return;
+						}
+
+						if (columnTargets[column] >= 0)
+						{
+							outputs[columnTargets[column]][vertex] = value;
+						}
+					}
+
+					if (computeStatistics)
+					{
+						statistics[i].Add(Vector3(outputs[0][vertex], outputs[1][vertex], outputs[2][vertex]));
+					}
+					cursor = lineEnd == bounds[i + 1] ? lineEnd : lineEnd + 1;
+				}
+				pieceEnds[i] = cursor;
+			});
+
+			for (size_t i = 0; i < pieceCount; i++)
+			{
+				// A piece stops early on a malformed line
+				m_failed |= pieceEnds[i] == nullptr;
+				m_statistics.Merge(statistics[i]);
+			}
+
+			if (m_failed)
+			{
+				return false;
+			}
+
+			// Lines after the last vertex belong to other elements and are never read
+			m_bufferBegin += end - begin;
+			m_remainingVertices -= count;
+			if (count > 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ReadPointCloud(const std::string& path, Vector3SoA& outPositions, Vector3SoA* outNormals, PointCloudStatistics* outStatistics)
+	{
+		outPositions.Clear();
+		if (outNormals != nullptr)
+		{
+			outNormals->Clear();
+		}
+
+		PointCloudReader reader;
+		if (!reader.Open(path, outStatistics != nullptr))
+		{
+			return false;
+		}
+
+		if (reader.GetReserveCount() > 0)
+		{
+			outPositions.Reserve(static_cast<size_t>(reader.GetReserveCount()));
+			if (outNormals != nullptr && reader.HasNormals())
+			{
+				outNormals->Reserve(static_cast<size_t>(reader.GetReserveCount()));
+			}
+		}
+
+		while (reader.ReadBatch(outPositions, outNormals))
+		{
+		}
+
+		if (outStatistics != nullptr)
+		{
+			*outStatistics = reader.GetStatistics();
+		}
+		return !reader.HasFailed();
+	}
+}
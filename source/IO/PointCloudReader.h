@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Spatial/AABB.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector3SoA.h"
+
+namespace LibMath
+{
+	/**
+	 * @brief Encoding of a point cloud file.
+	 */
+	enum class PointCloudFormat
+	{
+		UNKNOWN,
+		PLY_ASCII,
+		PLY_BINARY_LITTLE_ENDIAN,
+		PLY_BINARY_BIG_ENDIAN,
+		OBJ,
+	};
+
+	/**
+	 * @brief Bounds and centroid of the positions read so far.
+	 */
+	struct PointCloudStatistics
+	{
+		AABB bounds;
+		Vector3 centroid;
+		uint64_t positionCount = 0;
+	};
+
+	/**
+	 * Streams the vertices of PLY (ascii and binary) and OBJ files into Vector3SoA.
+	 * <p>
+	 * The file is read chunk after chunk, every chunk being parsed by all the threads, so the memory used
+	 * beside the output stays around the chunk size. Only vertex positions and normals are read: faces and
+	 * any other property are skipped. PLY positions and normals come from the x, y, z and nx, ny, nz
+	 * properties of the "vertex" element, OBJ ones from the "v" and "vn" lines. Vertex elements with a list
+	 * property are rejected.
+	 */
+	class PointCloudReader
+	{
+	public:
+		/**
+		 * @brief Bytes read from the file at once.
+		 */
+		static constexpr size_t DEFAULT_CHUNK_SIZE = 1 << 24;
+
+		/**
+		 * Constructor
+		 *
+		 * @param chunkSize Bytes read from the file at once, the PLY header must fit in it
+		 */
+		explicit PointCloudReader(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		~PointCloudReader();
+
+		PointCloudReader(const PointCloudReader& other) = delete;
+		PointCloudReader& operator=(const PointCloudReader& other) = delete;
+
+		/**
+		 * @brief Open a file and read its header. Files starting with "ply" are read as PLY, any other as OBJ.
+		 *
+		 * @param path Path of the file
+		 * @param computeStatistics True to update GetStatistics() while reading the positions
+		 * @return True if the file could be opened and its header is supported
+		 */
+		bool Open(const std::string& path, bool computeStatistics = false);
+
+		void Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_file != nullptr; }
+		[[nodiscard]] PointCloudFormat GetFormat() const { return m_format; }
+
+		/**
+		 * @brief Whether the file may contain normals: always true for OBJ, true for PLY if the vertices have nx, ny and nz.
+		 */
+		[[nodiscard]] bool HasNormals() const { return m_hasNormals; }
+
+		/**
+		 * @brief Number of vertices declared by a PLY header, 0 for OBJ as it can only be known by reading the file.
+		 */
+		[[nodiscard]] uint64_t GetVertexCount() const { return m_vertexCount; }
+
+		/**
+		 * @brief Vertices worth reserving before reading: GetVertexCount() capped to what the rest of the file can hold,
+		 * so a corrupt header cannot trigger a huge allocation. 0 for OBJ, or when the file size is unknown.
+		 */
+		[[nodiscard]] uint64_t GetReserveCount() const { return m_reserveCount; }
+
+		/**
+		 * @brief Read the next chunk of the file and append its vertices.
+		 *
+		 * @param positions Container receiving the positions
+		 * @param normals Optional, container receiving the normals
+		 * @return True if vertices were appended, false once the file is over or on error
+		 */
+		bool ReadBatch(Vector3SoA& positions, Vector3SoA* normals = nullptr);
+
+		/**
+		 * @brief Whether a read failed or the file is malformed.
+		 */
+		[[nodiscard]] bool HasFailed() const { return m_failed; }
+
+		/**
+		 * @brief Statistics of the positions appended since Open(), if it was asked to compute them.
+		 */
+		[[nodiscard]] PointCloudStatistics GetStatistics() const;
+
+		/**
+		 * @brief Running bounds and sum of the positions, in double to keep the centroid of large clouds precise.
+		 */
+		struct Accumulator
+		{
+			AABB bounds;
+			double sum[3] = { 0.0, 0.0, 0.0 };
+			uint64_t count = 0;
+
+			void Add(const Vector3& position);
+			void Merge(const Accumulator& other);
+		};
+
+	private:
+		/**
+		 * @brief Vertex property of a PLY file.
+		 */
+		struct Property
+		{
+			int type = 0;
+			size_t offset = 0;/**< bytes from the start of a binary vertex*/
+		};
+
+		bool ReadHeader();
+		bool SkipElements(uint64_t lineCount, uint64_t byteCount);
+		bool FillBuffer();
+		bool ReadBinary(Vector3SoA& positions, Vector3SoA* normals);
+		bool ReadText(Vector3SoA& positions, Vector3SoA* normals);
+
+		std::FILE* m_file = nullptr;
+		uint64_t m_fileSize = 0;/**< 0 when the file cannot be measured*/
+		PointCloudFormat m_format = PointCloudFormat::UNKNOWN;
+		size_t m_chunkSize = DEFAULT_CHUNK_SIZE;
+		bool m_failed = false;
+		bool m_endOfFile = false;
+
+		/*
+		* @name Bytes read from the file and not parsed yet: [m_bufferBegin, m_bufferEnd)
+		*/
+		/*@{*/
+		std::vector<char> m_buffer;
+		size_t m_bufferBegin = 0;
+		size_t m_bufferEnd = 0;
+		/*@}*/
+
+		/*
+		* @name PLY vertex element
+		*/
+		/*@{*/
+		uint64_t m_vertexCount = 0;
+		uint64_t m_remainingVertices = 0;
+		uint64_t m_reserveCount = 0;
+		size_t m_vertexStride = 0;/**< bytes of a binary vertex*/
+		int m_propertyIndices[6] = { -1, -1, -1, -1, -1, -1 };/**< index of x, y, z, nx, ny, nz in m_properties*/
+		std::vector<Property> m_properties;
+		/*@}*/
+
+		bool m_hasNormals = false;
+		bool m_computeStatistics = false;
+		Accumulator m_statistics;
+	};
+
+	/**
+	 * @brief Read every vertex of a PLY or OBJ file.
+	 *
+	 * @param path Path of the file
+	 * @param outPositions Container receiving the positions, replaced
+	 * @param outNormals Optional, container receiving the normals, replaced
+	 * @param outStatistics Optional, receives the bounds and centroid of the positions computed while reading
+	 * @return True if the whole file could be read
+	 */
+	bool ReadPointCloud(const std::string& path, Vector3SoA& outPositions, Vector3SoA* outNormals = nullptr, PointCloudStatistics* outStatistics = nullptr);
+}
@@ -0,0 +1,109 @@
+#include "Affine3.h"
+
+#include "Matrix/MatrixKernels.h"
+
+namespace LibMath
+{
+	static_assert(sizeof(Affine3) == 12 * sizeof(float), "Affine3 must stay 48 bytes");
+
+	Affine3 Affine3::FromTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+	{
+		// Dividing by the squared norm gives the rotation of the normalized quaternion without a square root
+		const float norm = rotation.X * rotation.X + rotation.Y * rotation.Y + rotation.Z * rotation.Z + rotation.W * rotation.W;
+		const float factor = norm > 0.f ? 2.f / norm : 0.f;
+
+		const float factorX = factor * rotation.X;
+		const float factorY = factor * rotation.Y;
+		const float factorZ = factor * rotation.Z;
+
+		const float xx = factorX * rotation.X;
+		const float yy = factorY * rotation.Y;
+		const float zz = factorZ * rotation.Z;
+		const float xy = factorX * rotation.Y;
+		const float xz = factorX * rotation.Z;
+		const float xw = factorX * rotation.W;
+		const float yz = factorY * rotation.Z;
+		const float yw = factorY * rotation.W;
+		const float zw = factorZ * rotation.W;
+
+		Affine3 result;
+
+		result.raw[0] = (1.f - yy - zz) * scale.x;
+		result.raw[1] = (xy - zw) * scale.y;
+		result.raw[2] = (xz + yw) * scale.z;
+		result.raw[3] = translation.x;
+
+		result.raw[4] = (xy + zw) * scale.x;
+		result.raw[5] = (1.f - xx - zz) * scale.y;
+		result.raw[6] = (yz - xw) * scale.z;
+		result.raw[7] = translation.y;
+
+		result.raw[8] = (xz - yw) * scale.x;
+		result.raw[9] = (yz + xw) * scale.y;
+		result.raw[10] = (1.f - xx - yy) * scale.z;
+		result.raw[11] = translation.z;
+
+		return result;
+	}
+
+	Matrix4 Affine3::ToMatrix4() const
+	{
+		Matrix4 result;
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				result.raw[c * 4 + r] = raw[r * 4 + c];
+			}
+		}
+		result.raw[15] = 1.f;
+
+		return result;
+	}
+
+	Affine3 Affine3::operator*(const Affine3& other) const
+	{
+		Affine3 result;
+		MatrixKernels::Compose(raw, other.raw, result.raw);
+		return result;
+	}
+
+	Affine3& Affine3::operator*=(const Affine3& other)
+	{
+		MatrixKernels::Compose(raw, other.raw, raw);
+		return *this;
+	}
+
+	Affine3 Affine3::GetInverse() const
+	{
+		Affine3 inverse;
+
+		// Cofactors of the linear part, the determinant reuses the first column of them
+		const float cofactor00 = raw[5] * raw[10] - raw[6] * raw[9];
+		const float cofactor01 = raw[6] * raw[8] - raw[4] * raw[10];
+		const float cofactor02 = raw[4] * raw[9] - raw[5] * raw[8];
+
+		const float determinant = raw[0] * cofactor00 + raw[1] * cofactor01 + raw[2] * cofactor02;
+		if (determinant == 0.f) return inverse;
+
+		const float inverseDeterminant = 1.f / determinant;
+
+		inverse.raw[0] = cofactor00 * inverseDeterminant;
+		inverse.raw[1] = (raw[2] * raw[9] - raw[1] * raw[10]) * inverseDeterminant;
+		inverse.raw[2] = (raw[1] * raw[6] - raw[2] * raw[5]) * inverseDeterminant;
+
+		inverse.raw[4] = cofactor01 * inverseDeterminant;
+		inverse.raw[5] = (raw[0] * raw[10] - raw[2] * raw[8]) * inverseDeterminant;
+		inverse.raw[6] = (raw[2] * raw[4] - raw[0] * raw[6]) * inverseDeterminant;
+
+		inverse.raw[8] = cofactor02 * inverseDeterminant;
+		inverse.raw[9] = (raw[1] * raw[8] - raw[0] * raw[9]) * inverseDeterminant;
+		inverse.raw[10] = (raw[0] * raw[5] - raw[1] * raw[4]) * inverseDeterminant;
+
+		// The inverse translation brings the translation back to the origin
+		inverse.SetTranslation(-inverse.TransformDirection(GetTranslation()));
+
+		return inverse;
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Matrix/Matrix4.h"
+#include "Quaternion/Quaternion.h"
+#include "Vector/Vector3.h"
+
+namespace LibMath
+{
+	/**
+	 * Affine transformation stored as a 3x4 matrix: a 3x3 linear part followed by a translation.
+	 * <p>
+	 * The implicit last row of a Matrix4 (0, 0, 0, 1) is not stored, so an Affine3 takes 48 bytes instead
+	 * of 64 and composing, transforming and inverting it costs far fewer operations. raw is stored row after
+	 * row, each row being 16 bytes: raw[row * 4 + column], column 3 holding the translation.
+	 * Composition follows Matrix4: (a * b) applies b first, then a.
+	 */
+	struct Affine3
+	{
+		constexpr Affine3() = default;
+		constexpr Affine3(const Affine3& other) = default;
+		constexpr Affine3& operator=(const Affine3& other) = default;
+		~Affine3() = default;
+
+		/**
+		 * Constructor setting the diagonal of the linear part, without translation
+		 *
+		 * @param diagonalValue Value of the diagonal, 1 for the identity
+		 */
+		constexpr Affine3(const float diagonalValue) :
+			raw{ diagonalValue, 0.f, 0.f, 0.f,
+				0.f, diagonalValue, 0.f, 0.f,
+				0.f, 0.f, diagonalValue, 0.f } {}
+
+		/**
+		 * Constructor keeping the first three rows of a Matrix4, whose last row is expected to be (0, 0, 0, 1)
+		 *
+		 * @param matrix Affine Matrix4
+		 */
+		explicit constexpr Affine3(const Matrix4& matrix) :
+			raw{ matrix.raw[0], matrix.raw[4], matrix.raw[8], matrix.raw[12],
+				matrix.raw[1], matrix.raw[5], matrix.raw[9], matrix.raw[13],
+				matrix.raw[2], matrix.raw[6], matrix.raw[10], matrix.raw[14] } {}
+
+		/*
+		 * @brief Create an identity transformation
+		 * @return an Affine3
+		 */
+		static constexpr Affine3 Identity() { return Affine3(1.f); }
+
+		/*
+		 * @brief Create a translation
+		 * @param vector with the 3 translation components
+		 * @return an Affine3
+		 */
+		static constexpr Affine3 Translation(const Vector3& translation)
+		{
+			Affine3 result = Identity();
+			result.SetTranslation(translation);
+			return result;
+		}
+
+		/*
+		 * @brief Create a scaling
+		 * @param vector with the 3 scaling components
+		 * @return an Affine3
+		 */
+		static constexpr Affine3 Scaling(const Vector3& scale)
+		{
+			Affine3 result;
+			result.raw[0] = scale.x;
+			result.raw[5] = scale.y;
+			result.raw[10] = scale.z;
+			return result;
+		}
+
+		/*
+		 * @brief Create a rotation
+		 * @param quaternion
+		 * @return an Affine3
+		 */
+		static Affine3 Rotation(const Quaternion& quaternion) { return Affine3(Matrix4::Rotation(quaternion)); }
+
+		/*
+		 * @brief Create Translation(translation) * Rotation(rotation) * Scaling(scale) directly, without any product.
+		 * The rotation does not have to be normalized
+		 * @param translation, rotation, scale
+		 * @return an Affine3
+		 */
+		static Affine3 FromTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+
+		/*
+		 * @brief Convert to a Matrix4, adding the (0, 0, 0, 1) last row
+		 * @return a matrix4
+		 */
+		[[nodiscard]] Matrix4 ToMatrix4() const;
+
+		/**
+		 * @brief Compose two transformations, other being applied first.
+		 */
+		Affine3 operator*(const Affine3& other) const;
+		Affine3& operator*=(const Affine3& other);
+
+		/*
+		 * @brief Transform a point: linear part then translation
+		 * @param point
+		 * @return the transformed point
+		 */
+		[[nodiscard]] constexpr Vector3 TransformPoint(const Vector3& point) const
+		{
+			return Vector3(raw[0] * point.x + raw[1] * point.y + raw[2] * point.z + raw[3],
+				raw[4] * point.x + raw[5] * point.y + raw[6] * point.z + raw[7],
+				raw[8] * point.x + raw[9] * point.y + raw[10] * point.z + raw[11]);
+		}
+
+		/*
+		 * @brief Transform a direction: linear part only
+		 * @param direction
+		 * @return the transformed direction
+		 */
+		[[nodiscard]] constexpr Vector3 TransformDirection(const Vector3& direction) const
+		{
+			return Vector3(raw[0] * direction.x + raw[1] * direction.y + raw[2] * direction.z,
+				raw[4] * direction.x + raw[5] * direction.y + raw[6] * direction.z,
+				raw[8] * direction.x + raw[9] * direction.y + raw[10] * direction.z);
+		}
+
+		/*
+		 * @brief called with the transformation you want the inverse from: inverse of the 3x3 part, then of the translation
+		 * @return this transformation now inversed, zero if the linear part is singular
+		 */
+		void Inverse() { *this = GetInverse(); }
+		[[nodiscard]] Affine3 GetInverse() const;
+
+		/*
+		 * @brief Determinant of the linear part
+		 * @return a float determinant
+		 */
+		[[nodiscard]] constexpr float Determinant() const
+		{
+			return raw[0] * (raw[5] * raw[10] - raw[6] * raw[9])
+				- raw[1] * (raw[4] * raw[10] - raw[6] * raw[8])
+				+ raw[2] * (raw[4] * raw[9] - raw[5] * raw[8]);
+		}
+
+		[[nodiscard]] constexpr Vector3 GetTranslation() const { return Vector3(raw[3], raw[7], raw[11]); }
+		constexpr void SetTranslation(const Vector3& translation) { raw[3] = translation.x; raw[7] = translation.y; raw[11] = translation.z; }
+
+		constexpr bool operator==(const Affine3& other) const
+		{
+			for (int i = 0; i < 12; i++)
+				if (raw[i] != other.raw[i])
+					return false;
+
+			return true;
+		}
+		constexpr bool operator!=(const Affine3& other) const { return !(*this == other); }
+
+		constexpr float const* Data() const { return raw; }
+
+		float raw[12]{};
+	};
+}
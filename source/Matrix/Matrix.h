@@ -3,3 +3,5 @@
 #include "Matrix2.h"
 #include "Matrix3.h"
 #include "Matrix4.h"
+#include "Affine3.h"
+#include "TMatrix.h"
@@ -14,7 +14,7 @@ namespace LibMath
          *
          * @param ptr Pointer on row
          */
-        explicit row3(float* ptr) : m_ptr(ptr) {}
+        explicit constexpr row3(float* ptr) : m_ptr(ptr) {}
 
         /**
 		 * Retrieves value in row at given index
@@ -22,7 +22,7 @@ namespace LibMath
 		 * @param idx index of the value to retrieve
 		 * @return Value at given index
 		 */
-		float& operator[](const int idx) const { return m_ptr[idx]; }
+		constexpr float& operator[](const int idx) const { return m_ptr[idx]; }
 
 		/*
 		* @name Pointer on constant row
@@ -42,7 +42,7 @@ namespace LibMath
          * 
          * @param ptr Pointer on row
          */
-        explicit const_row3(const float* ptr) : m_ptr(ptr) {}
+        explicit constexpr const_row3(const float* ptr) : m_ptr(ptr) {}
 
         /**
 		 * Retrieves value in row at given index
@@ -50,7 +50,7 @@ namespace LibMath
 		 * @param idx index of the value to retrieve
 		 * @return Value at given index
 		 */
-		float operator[](const int idx) const { return m_ptr[idx]; }
+		constexpr float operator[](const int idx) const { return m_ptr[idx]; }
 
 
 		/*
@@ -69,7 +69,7 @@ namespace LibMath
         /**
 		 * Default constructor. Initialize every values to 0.f
 		 */
-		Matrix3() = default;
+		constexpr Matrix3() = default;
 
         /**
 		 * Constructor allowing initialization of every values.
@@ -84,14 +84,15 @@ namespace LibMath
 		 * @param h [2][1] value
 		 * @param i [2][2] value
 		 */
-		Matrix3(const float& a, const float& b, const float& c, const float& d, const float& e, const float& f, const float& g, const float& h, const float& i);
+		constexpr Matrix3(const float& a, const float& b, const float& c, const float& d, const float& e, const float& f, const float& g, const float& h, const float& i) :
+			m_row{ a, b, c, d, e, f, g, h, i } {}
 
         /**
 		 * Copy constructor
 		 * 
 		 * @param other Matrix3 to copy
 		 */
-		Matrix3(Matrix3 const& other) = default;
+		constexpr Matrix3(Matrix3 const& other) = default;
 
         /**
 		 * Replace current Matrix3 by other Matrix3.
@@ -99,7 +100,7 @@ namespace LibMath
 		 * @param other Matrix3 to replace current Matrix3 by
 		 * @return reference of current Matrix3 after replacement
 		 */
-		Matrix3& operator=(const Matrix3& other) = default;
+		constexpr Matrix3& operator=(const Matrix3& other) = default;
 
         /**
 		 * Constructor that initialize every values to 0.f except for the diagonal that is set to the diagonalValue float parameter.
@@ -108,7 +109,7 @@ namespace LibMath
 		 * 
 		 * @param diagonalValue float used to set diagonal values
 		 */
-		Matrix3(const float& diagonalValue);
+		constexpr Matrix3(const float& diagonalValue) : m_row{ diagonalValue, 0.f, 0.f, 0.f, diagonalValue, 0.f, 0.f, 0.f, diagonalValue } {}
 
         /**
 		 * Destructor.
@@ -127,7 +128,7 @@ namespace LibMath
 		 * 
 		 * @return 3x3 Identity matrix
 		 */
-		static Matrix3 IdentityMatrix() { return Matrix3(1.f); }
+		static constexpr Matrix3 IdentityMatrix() { return Matrix3(1.f); }
 
 		/**
          * Gives rotation Matrix3 for given Radian.
@@ -144,7 +145,7 @@ namespace LibMath
 		 * @param y Value of the y axis translation
 		 * @return Translation Matrix3 for given values
 		 */
-		static Matrix3 TranslationMatrix(const float& x, const float& y);
+		static constexpr Matrix3 TranslationMatrix(const float& x, const float& y) { return Matrix3(1.f, 0.f, 0.f, 0.f, 1.f, 0.f, x, y, 1.f); }
 
         /**
 		 * Gives scale Matrix3 of x and y ratio. Used to scale a Matrix3 by x and y ratio.
@@ -153,7 +154,7 @@ namespace LibMath
 		 * @param y Scale on the y axis
 		 * @return Scale Matrix3 for given ratios
 		 */
-		static Matrix3 ScaleMatrix(const float& x, const float& y);
+		static constexpr Matrix3 ScaleMatrix(const float& x, const float& y) { return Matrix3(x, 0.f, 0.f, 0.f, y, 0.f, 0.f, 0.f, 1.f); }
 
         /**
 		 * Transposes given Matrix3
@@ -224,7 +225,14 @@ namespace LibMath
 		 * @param other Matrix3 to check equality on
 		 * @return bool true if equal, false if not
 		 */
-		bool operator==(const Matrix3& other) const;
+		constexpr bool operator==(const Matrix3& other) const
+		{
+			for (auto i = 0; i < 9; i++)
+				if (m_row[i] != other.m_row[i])
+					return false;
+
+			return true;
+		}
 
         /**
 		 * Checks inequality between current Matrix3 and other Matrix3
@@ -232,7 +240,7 @@ namespace LibMath
 		 * @param other Matrix3 to check inequality on
 		 * @return bool false if equal, true if not
 		 */
-		bool operator!=(const Matrix3& other) const { return !(*this == other); }
+		constexpr bool operator!=(const Matrix3& other) const { return !(*this == other); }
 
         /**
 		 * Retrieves row at given index in rows array
@@ -240,7 +248,7 @@ namespace LibMath
 		 * @param idx index of the row to retrieve
 		 * @return Row at index idx
 		 */
-		row3 operator[](const int idx) { return row3(&m_row[idx * 3]); }
+		constexpr row3 operator[](const int idx) { return row3(&m_row[idx * 3]); }
 
         /**
 		 * Retrieves row constant value at given index in rows array
@@ -248,7 +256,7 @@ namespace LibMath
 		 * @param idx index of the row to retrieve
 		 * @return Constant row value at index idx
 		 */
-		const_row3 operator[](const int idx) const { return const_row3(&m_row[idx * 3]); }
+		constexpr const_row3 operator[](const int idx) const { return const_row3(&m_row[idx * 3]); }
 
         /**
 		 * Adds other Matrix3 to current Matrix3, by adding every single current values to the other corresponding ones.
@@ -256,7 +264,13 @@ namespace LibMath
 		 * @param other Matrix3 to add to current Matrix3
 		 * @return reference on current Matrix3 after addition
 		 */
-		Matrix3& operator+=(const Matrix3& other);
+		constexpr Matrix3& operator+=(const Matrix3& other)
+		{
+			for (auto i = 0; i < 9; i++)
+				m_row[i] += other.m_row[i];
+
+			return (*this);
+		}
 
         /**
 		 * Subtracts other Matrix3 from current Matrix3.
@@ -264,7 +278,13 @@ namespace LibMath
 		 * @param other Matrix3 to subtract from current Matrix3
 		 * @return reference on current Matrix3 after subtraction
 		 */
-		Matrix3& operator-=(const Matrix3& other);
+		constexpr Matrix3& operator-=(const Matrix3& other)
+		{
+			for (auto i = 0; i < 9; i++)
+				m_row[i] -= other.m_row[i];
+
+			return (*this);
+		}
 
         /**
 		 * Multiplies current Matrix3 by other Matrix3.
@@ -272,7 +292,7 @@ namespace LibMath
 		 * @param other Matrix3 to multiply current Matrix3 by
 		 * @return reference on current Matrix3 after multiplication
 		 */
-		Matrix3& operator*=(const Matrix3& other);
+		constexpr Matrix3& operator*=(const Matrix3& other) { *this = *this * other; return *this; }
 
         /**
 		 * Divides current Matrix3 by other float. Each current Matrix3 values are divided by other float.
@@ -280,7 +300,13 @@ namespace LibMath
 		 * @param other float to divide current Matrix3 by
 		 * @return reference on current Matrix3 after division
 		 */
-		Matrix3& operator/=(const float& other);
+		constexpr Matrix3& operator/=(const float& other)
+		{
+			for (auto i = 0; i < 9; i++)
+				m_row[i] /= other;
+
+			return (*this);
+		}
 
         /**
 		 * Multiplies current Matrix3 by other float. Each current Matrix3 is multiplied by other float.
@@ -288,7 +314,13 @@ namespace LibMath
 		 * @param other float to multiply current Matrix3 by
 		 * @return reference on current Matrix3 after multiplication
 		 */
-		Matrix3& operator*=(const float& other);
+		constexpr Matrix3& operator*=(const float& other)
+		{
+			for (auto i = 0; i < 9; i++)
+				m_row[i] *= other;
+
+			return (*this);
+		}
 
         /**
 		 * Adds two Matrix3 together, by adding every single lhs values to the rhs corresponding ones.
@@ -297,7 +329,7 @@ namespace LibMath
 		 * @param rhs Operator on the right side of the operator
 		 * @return Matrix3 result of lhs and rhs addition
 		 */
-		friend Matrix3 operator+(Matrix3 lhs, const Matrix3& rhs);
+		friend constexpr Matrix3 operator+(Matrix3 lhs, const Matrix3& rhs) { lhs += rhs; return lhs; }
 
         /**
 		 * Subtracts lhs Matrix3 from rhs Matrix3.
@@ -306,7 +338,7 @@ namespace LibMath
 		 * @param rhs Operator on the right side of the operator
 		 * @return Matrix3 result of lhs and rhs subtraction
 		 */
-		friend Matrix3 operator-(Matrix3 lhs, const Matrix3& rhs);
+		friend constexpr Matrix3 operator-(Matrix3 lhs, const Matrix3& rhs) { lhs -= rhs; return lhs; }
 
         /**
 		 * Multiplies two Matrix3 together.
@@ -315,7 +347,23 @@ namespace LibMath
 		 * @param rhs Operator on the right side of the operator
 		 * @return Matrix3 result after multiplication
 		 */
-		friend Matrix3 operator*(Matrix3 lhs, const Matrix3& rhs);
+		friend constexpr Matrix3 operator*(Matrix3 lhs, const Matrix3& rhs)
+		{
+			Matrix3 result;
+
+			for (auto row = 0; row < 3; ++row)
+			{
+				for (auto col = 0; col < 3; ++col)
+				{
+					for (auto a = 0; a < 3; ++a)
+					{
+						result.m_row[row * 3 + col] += lhs.m_row[a * 3 + col] * rhs.m_row[row * 3 + a];
+					}
+				}
+			}
+
+			return result;
+		}
 
         /**
 		 * Gives the division result of lhs Matrix3 by rhs float.
@@ -324,7 +372,7 @@ namespace LibMath
 		 * @param rhs Operator on the right side of the operator
 		 * @return Matrix3 result after division of lhs by rhs
 		 */
-		friend Matrix3 operator/(Matrix3 lhs, const float& rhs);
+		friend constexpr Matrix3 operator/(Matrix3 lhs, const float& rhs) { lhs /= rhs; return lhs; }
 
         /**
 		 * Gives the multiplication result of lhs Matrix3 by rhs float
@@ -333,7 +381,7 @@ namespace LibMath
 		 * @param rhs Operator on the right side of the operator
 		 * @return Matrix3 result after multiplication of rhs by lhs
 		 */
-		friend Matrix3 operator*(Matrix3 lhs, const float& rhs);
+		friend constexpr Matrix3 operator*(Matrix3 lhs, const float& rhs) { lhs *= rhs; return lhs; }
 
 		/*
 		* @name Matrix3 values
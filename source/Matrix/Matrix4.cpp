@@ -1,34 +1,363 @@
 #include "Matrix4.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Core/SIMD.h"
+#include "Matrix/Affine3.h"
+#include "Matrix/Matrix3.h"
+#include "Matrix/MatrixKernels.h"
 #include "Vector/Vector.h"
 
 namespace LibMath
 {
-	Matrix4::Matrix4(float diagonalValue)
+	namespace
 	{
-		Clear();
-		/*gridview = new(raw)GridView;*/
+		/**
+		 * @brief Column-major product: column c of output is the columns of lhs weighted by column c of rhs.
+		 * Every kernel reads its inputs before writing an output column, so output may alias lhs or rhs.
+		 */
+		using MultiplyFunction = void (*)(const float* lhs, const float* rhs, float* output);
+
+		MultiplyFunction SelectMultiply()
+		{
+#if LIBMATH_SSE
+			if (SIMD::HasAVX2() && SIMD::HasFMA())
+			{
+				return MatrixKernels::MatrixColumnsFMA::Product;
+			}
+			return MatrixKernels::MatrixColumns::Product;
+#else
+			return MatrixKernels::MultiplyScalar;
+#endif
+		}
+
+		void Multiply(const float* lhs, const float* rhs, float* output)
+		{
+			static const MultiplyFunction multiply = SelectMultiply();
+			multiply(lhs, rhs, output);
+		}
+
+#if LIBMATH_SSE
+		/*
+		* @name Lane selection, X and Y taken from first, Z and W from second
+		*/
+		/*@{*/
+		template <int X, int Y, int Z, int W>
+		__m128 Shuffle(const __m128 first, const __m128 second) { return _mm_shuffle_ps(first, second, _MM_SHUFFLE(W, Z, Y, X)); }
+
+		template <int X, int Y, int Z, int W>
+		__m128 Swizzle(const __m128 vector) { return _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(W, Z, Y, X)); }
+		/*@}*/
+
+		/*
+		* @name Products of 2x2 matrices stored as (m00, m01, m10, m11), # being the adjugate
+		*/
+		/*@{*/
+		__m128 Multiply2x2(const __m128 a, const __m128 b)
+		{
+			return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+
+		__m128 AdjugateMultiply2x2(const __m128 a, const __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+		}
+
+		__m128 MultiplyAdjugate2x2(const __m128 a, const __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+		/*@}*/
+
+		/**
+		 * @brief General inverse by blocks of 2x2 matrices (Cramer's rule), the determinant being computed once
+		 * from the same blocks. The transposed matrix gives the transposed inverse, so the storage order does not matter.
+		 *
+		 * @return The determinant, output is left untouched if it is 0
+		 */
+		float InverseSSE(const float* matrix, float* output)
+		{
+			const __m128 column0 = _mm_loadu_ps(matrix);
+			const __m128 column1 = _mm_loadu_ps(matrix + 4);
+			const __m128 column2 = _mm_loadu_ps(matrix + 8);
+			const __m128 column3 = _mm_loadu_ps(matrix + 12);
+
+			// The four 2x2 blocks | A B |
+			//                     | C D |
+			const __m128 a = _mm_movelh_ps(column0, column1);
+			const __m128 b = _mm_movehl_ps(column1, column0);
+			const __m128 c = _mm_movelh_ps(column2, column3);
+			const __m128 d = _mm_movehl_ps(column3, column2);
+
+			// (|A|, |B|, |C|, |D|)
+			const __m128 blockDeterminants = _mm_sub_ps(
+				_mm_mul_ps(Shuffle<0, 2, 0, 2>(column0, column2), Shuffle<1, 3, 1, 3>(column1, column3)),
+				_mm_mul_ps(Shuffle<1, 3, 1, 3>(column0, column2), Shuffle<0, 2, 0, 2>(column1, column3)));
+			const __m128 determinantA = Swizzle<0, 0, 0, 0>(blockDeterminants);
+			const __m128 determinantB = Swizzle<1, 1, 1, 1>(blockDeterminants);
+			const __m128 determinantC = Swizzle<2, 2, 2, 2>(blockDeterminants);
+			const __m128 determinantD = Swizzle<3, 3, 3, 3>(blockDeterminants);
+
+			const __m128 adjugateDC = AdjugateMultiply2x2(d, c);
+			const __m128 adjugateAB = AdjugateMultiply2x2(a, b);
+
+			// Blocks of the adjugate, before their final shuffle
+			__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Multiply2x2(b, adjugateDC));
+			__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Multiply2x2(c, adjugateAB));
+			__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), MultiplyAdjugate2x2(d, adjugateAB));
+			__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), MultiplyAdjugate2x2(a, adjugateDC));
+
+			// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+			__m128 trace = _mm_mul_ps(adjugateAB, Swizzle<0, 2, 1, 3>(adjugateDC));
+			trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+			trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+			const __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+
+			const float scalarDeterminant = _mm_cvtss_f32(determinant);
+			if (scalarDeterminant == 0.f)
+			{
+				return 0.f;
+			}
+
+			const __m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), determinant);
+			x = _mm_mul_ps(x, inverseDeterminant);
+			y = _mm_mul_ps(y, inverseDeterminant);
+			z = _mm_mul_ps(z, inverseDeterminant);
+			w = _mm_mul_ps(w, inverseDeterminant);
+
+			_mm_storeu_ps(output, Shuffle<3, 1, 3, 1>(x, y));
+			_mm_storeu_ps(output + 4, Shuffle<2, 0, 2, 0>(x, y));
+			_mm_storeu_ps(output + 8, Shuffle<3, 1, 3, 1>(z, w));
+			_mm_storeu_ps(output + 12, Shuffle<2, 0, 2, 0>(z, w));
+
+			return scalarDeterminant;
+		}
+
+		__m128 Cross(const __m128 a, const __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)), _mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+		}
+
+		/**
+		 * @brief Inverse of the 3x3 part from the cross products of its columns, which are the rows of the
+		 * adjugate, then of the translation. The last row of matrix must be (0, 0, 0, 1).
+		 *
+		 * @return The determinant of the 3x3 part, output is left untouched if it is 0
+		 */
+		float InverseAffineSSE(const float* matrix, float* output)
+		{
+			const __m128 column0 = _mm_loadu_ps(matrix);
+			const __m128 column1 = _mm_loadu_ps(matrix + 4);
+			const __m128 column2 = _mm_loadu_ps(matrix + 8);
+			const __m128 translation = _mm_loadu_ps(matrix + 12);
+
+			__m128 row0 = Cross(column1, column2);
+			__m128 row1 = Cross(column2, column0);
+			__m128 row2 = Cross(column0, column1);
+			__m128 row3 = _mm_setzero_ps();
+
+			const __m128 products = _mm_mul_ps(column0, row0);
+			const float determinant = _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(products, Swizzle<1, 1, 1, 1>(products)), Swizzle<2, 2, 2, 2>(products)));
+			if (determinant == 0.f)
+			{
+				return 0.f;
+			}
+
+			const __m128 inverseDeterminant = _mm_set1_ps(1.f / determinant);
+			row0 = _mm_mul_ps(row0, inverseDeterminant);
+			row1 = _mm_mul_ps(row1, inverseDeterminant);
+			row2 = _mm_mul_ps(row2, inverseDeterminant);
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+			__m128 inverseTranslation = _mm_mul_ps(row0, Swizzle<0, 0, 0, 0>(translation));
+			inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(row1, Swizzle<1, 1, 1, 1>(translation)));
+			inverseTranslation = _mm_add_ps(inverseTranslation, _mm_mul_ps(row2, Swizzle<2, 2, 2, 2>(translation)));
+			inverseTranslation = _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), inverseTranslation);
+
+			_mm_storeu_ps(output, row0);
+			_mm_storeu_ps(output + 4, row1);
+			_mm_storeu_ps(output + 8, row2);
+			_mm_storeu_ps(output + 12, inverseTranslation);
+
+			return determinant;
+		}
+#endif
+
+		/**
+		 * @brief Quaternion of an orthonormal rotation, m[row][column], without trigonometry.
+		 * The largest of w, x, y and z is computed from the diagonal and divides the others, which keeps
+		 * the result accurate close to 180 degrees. MatrixBatch::Decompose() follows the same operations.
+		 */
+		Quaternion RotationToQuaternion(const float m[3][3])
+		{
+			const float trace = m[0][0] + m[1][1] + m[2][2];
+
+			if (trace > 0.f)
+			{
+				const float largest = .5f * std::sqrt(1.f + m[0][0] + m[1][1] + m[2][2]);
+				const float factor = .25f / largest;
+				return Quaternion((m[2][1] - m[1][2]) * factor, (m[0][2] - m[2][0]) * factor, (m[1][0] - m[0][1]) * factor, largest);
+			}
+			if (m[0][0] >= m[1][1] && m[0][0] >= m[2][2])
+			{
+				const float largest = .5f * std::sqrt(1.f + m[0][0] - m[1][1] - m[2][2]);
+				const float factor = .25f / largest;
+				return Quaternion(largest, (m[0][1] + m[1][0]) * factor, (m[0][2] + m[2][0]) * factor, (m[2][1] - m[1][2]) * factor);
+			}
+			if (m[1][1] >= m[2][2])
+			{
+				const float largest = .5f * std::sqrt(1.f - m[0][0] + m[1][1] - m[2][2]);
+				const float factor = .25f / largest;
+				return Quaternion((m[0][1] + m[1][0]) * factor, largest, (m[1][2] + m[2][1]) * factor, (m[0][2] - m[2][0]) * factor);
+			}
+
+			const float largest = .5f * std::sqrt(1.f - m[0][0] - m[1][1] + m[2][2]);
+			const float factor = .25f / largest;
+			return Quaternion((m[0][2] + m[2][0]) * factor, (m[1][2] + m[2][1]) * factor, largest, (m[1][0] - m[0][1]) * factor);
+		}
 
-		raw[0] = diagonalValue;
-		raw[5] = diagonalValue;
-		raw[10] = diagonalValue;
-		raw[15] = diagonalValue;
+		/**
+		 * @brief Determinant of m[row][column], expanded along the first column like the batched kernels.
+		 */
+		float Determinant3(const float m[3][3])
+		{
+			return m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2])
+				+ m[1][0] * (m[2][1] * m[0][2] - m[0][1] * m[2][2])
+				+ m[2][0] * (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
+		}
+
+		/**
+		 * @brief Polar iterations stop once no coefficient moves more than this.
+		 */
+		constexpr float POLAR_TOLERANCE = 1e-6f;
+		constexpr int POLAR_MAX_ITERATIONS = 32;
 	}
 
+	bool Matrix4::Decompose(Vector3& outTranslation, Quaternion& outRotation, Vector3& outScale) const
+	{
+		outTranslation = Vector3(raw[12], raw[13], raw[14]);
+
+		float scale[3];
+		for (int c = 0; c < 3; c++)
+		{
+			scale[c] = std::sqrt(raw[c * 4] * raw[c * 4] + raw[c * 4 + 1] * raw[c * 4 + 1] + raw[c * 4 + 2] * raw[c * 4 + 2]);
+		}
+
+		if (scale[0] == 0.f || scale[1] == 0.f || scale[2] == 0.f)
+		{
+			outScale = Vector3(scale[0], scale[1], scale[2]);
+			outRotation = Quaternion();
+			return false;
+		}
+
+		float rotation[3][3];
+		for (int c = 0; c < 3; c++)
+		{
+			const float inverseScale = 1.f / scale[c];
+			for (int r = 0; r < 3; r++)
+			{
+				rotation[r][c] = raw[c * 4 + r] * inverseScale;
+			}
+		}
+
+		// A mirrored basis is a rotation with a negative scale, given to x
+		if (Determinant3(rotation) < 0.f)
+		{
+			scale[0] = -scale[0];
+			for (int r = 0; r < 3; r++)
+			{
+				rotation[r][0] = -rotation[r][0];
+			}
+		}
+
+		outScale = Vector3(scale[0], scale[1], scale[2]);
+		outRotation = RotationToQuaternion(rotation);
+		return true;
+	}
 
-	Matrix4 Matrix4::Orthographic(float l, float r, float b, float t, float n, float f)
+	bool Matrix4::DecomposePolar(Vector3& outTranslation, Quaternion& outRotation, Matrix3& outStretch) const
 	{
-		Matrix4 result;
+		outTranslation = Vector3(raw[12], raw[13], raw[14]);
 
-		result.raw[0] = 2 / (r - l);
-		result.raw[5] = 2 / (t - b);
-		result.raw[10] = -2 / (f - n);
+		float linear[3][3];
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				linear[r][c] = raw[c * 4 + r];
+			}
+		}
 
-		result.raw[12] = -(r + l) / (r - l);
-		result.raw[13] = -(t + b) / (t - b);
-		result.raw[14] = -(f + n) / (f - n);
-		result.raw[15] = 1.f;
+		// A mirrored matrix is decomposed as -rotation * -stretch, so the rotation stays proper
+		const float sign = Determinant3(linear) < 0.f ? -1.f : 1.f;
 
-		return result;
+		float rotation[3][3];
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				rotation[r][c] = sign * linear[r][c];
+			}
+		}
+
+		// rotation = (rotation + rotation^-T) / 2 converges quadratically to the closest orthonormal matrix
+		for (int iteration = 0; iteration < POLAR_MAX_ITERATIONS; iteration++)
+		{
+			const float determinant = Determinant3(rotation);
+			if (determinant == 0.f)
+			{
+				outRotation = Quaternion();
+				outStretch = Matrix3();
+				return false;
+			}
+
+			const float halfInverseDeterminant = .5f / determinant;
+			float next[3][3];
+			float change = 0.f;
+			for (int r = 0; r < 3; r++)
+			{
+				const int r1 = (r + 1) % 3;
+				const int r2 = (r + 2) % 3;
+				for (int c = 0; c < 3; c++)
+				{
+					const int c1 = (c + 1) % 3;
+					const int c2 = (c + 2) % 3;
+					const float cofactor = rotation[r1][c1] * rotation[r2][c2] - rotation[r1][c2] * rotation[r2][c1];
+					next[r][c] = .5f * rotation[r][c] + halfInverseDeterminant * cofactor;
+					change = std::max(change, std::fabs(next[r][c] - rotation[r][c]));
+				}
+			}
+
+			for (int r = 0; r < 3; r++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					rotation[r][c] = next[r][c];
+				}
+			}
+
+			if (change <= POLAR_TOLERANCE)
+			{
+				break;
+			}
+		}
+
+		// stretch = rotation^T * linear, symmetric up to rounding
+		float stretch[3][3];
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				stretch[r][c] = rotation[0][r] * linear[0][c] + rotation[1][r] * linear[1][c] + rotation[2][r] * linear[2][c];
+			}
+		}
+
+		outStretch = Matrix3(stretch[0][0], .5f * (stretch[0][1] + stretch[1][0]), .5f * (stretch[0][2] + stretch[2][0]),
+			.5f * (stretch[1][0] + stretch[0][1]), stretch[1][1], .5f * (stretch[1][2] + stretch[2][1]),
+			.5f * (stretch[2][0] + stretch[0][2]), .5f * (stretch[2][1] + stretch[1][2]), stretch[2][2]);
+		outRotation = RotationToQuaternion(rotation);
+		return true;
 	}
 
 	Matrix4 Matrix4::Perspective(Radian fov, float ar, float n, float f)
@@ -161,6 +490,11 @@ namespace LibMath
 		return result;
 	}
 
+	Matrix4 Matrix4::FromTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+	{
+		return Affine3::FromTRS(translation, rotation, scale).ToMatrix4();
+	}
+
 	//glm rotate order Z -> X -> Y
 	Matrix4 Matrix4::Rotation(Radian x, Radian y, Radian z)
 	{
@@ -202,98 +536,94 @@ namespace LibMath
 		}
 	}
 
-	Matrix4 Matrix4::Scaling(float x, float y, float z)
+	Matrix4& Matrix4::PreTranslate(const float x, const float y, const float z)
 	{
-		Matrix4 result;
-
-		result.raw[0] = x;
-		result.raw[5] = y;
-		result.raw[10] = z;
-		result.raw[15] = 1.f;
-
-		return result;
+		// Row r gains translation[r] times the last row
+		for (int c = 0; c < 4; c++)
+		{
+			const float w = raw[c * 4 + 3];
+			raw[c * 4] += x * w;
+			raw[c * 4 + 1] += y * w;
+			raw[c * 4 + 2] += z * w;
+		}
+		return *this;
 	}
 
-	Matrix4 Matrix4::Scaling(const Vector3& vec)
+	Matrix4& Matrix4::PostTranslate(const float x, const float y, const float z)
 	{
-		Matrix4 result;
-
-		result.raw[0] = vec.x;
-		result.raw[5] = vec.y;
-		result.raw[10] = vec.z;
-		result.raw[15] = 1.f;
-
-		return result;
+		for (int r = 0; r < 4; r++)
+		{
+			raw[12 + r] += raw[r] * x + raw[4 + r] * y + raw[8 + r] * z;
+		}
+		return *this;
 	}
 
-	Matrix4 Matrix4::Translation(float x, float y, float z)
+	Matrix4& Matrix4::PreScale(const float x, const float y, const float z)
 	{
-		Matrix4 result = Identity();
-
-		result.raw[12] = x;
-		result.raw[13] = y;
-		result.raw[14] = z;
-
-		return result;
+		for (int c = 0; c < 4; c++)
+		{
+			raw[c * 4] *= x;
+			raw[c * 4 + 1] *= y;
+			raw[c * 4 + 2] *= z;
+		}
+		return *this;
 	}
 
-	Matrix4 Matrix4::Translation(const Vector3& vec)
+	Matrix4& Matrix4::PostScale(const float x, const float y, const float z)
 	{
-		Matrix4 result = Identity();
-
-		result.raw[12] = vec.x;
-		result.raw[13] = vec.y;
-		result.raw[14] = vec.z;
-
-		return result;
+		for (int r = 0; r < 4; r++)
+		{
+			raw[r] *= x;
+			raw[4 + r] *= y;
+			raw[8 + r] *= z;
+		}
+		return *this;
 	}
 
-	bool Matrix4::operator==(const Matrix4& other) const
+	Matrix4& Matrix4::PreMultiply3x3(const Matrix4& rotation)
 	{
-		if (this == &other) return true;
-
-		for (int i = 0; i < 16; i++)
-			if (raw[i] != other.raw[i])
-				return false;
+		const float* m = rotation.raw;
 
-		return true;
+		// Each column keeps its last row, its first three rows are rotated
+		for (int c = 0; c < 4; c++)
+		{
+			const float x = raw[c * 4];
+			const float y = raw[c * 4 + 1];
+			const float z = raw[c * 4 + 2];
+			raw[c * 4] = m[0] * x + m[4] * y + m[8] * z;
+			raw[c * 4 + 1] = m[1] * x + m[5] * y + m[9] * z;
+			raw[c * 4 + 2] = m[2] * x + m[6] * y + m[10] * z;
+		}
+		return *this;
 	}
 
-	Matrix4 Matrix4::operator*(Matrix4 const& other) const
+	Matrix4& Matrix4::PostMultiply3x3(const Matrix4& rotation)
 	{
-		Matrix4 result;
+		const float* m = rotation.raw;
 
-		for (int row = 0; row < 4; row++)
+		// The translation column is kept, the first three columns are mixed
+		for (int r = 0; r < 4; r++)
 		{
-			for (int col = 0; col < 4; col++)
-			{
-				for (int a = 0; a < 4; a++)
-				{
-					result[row][col] += (*this)[a][col] * other[row][a];
-				}
-			}
+			const float column0 = raw[r];
+			const float column1 = raw[4 + r];
+			const float column2 = raw[8 + r];
+			raw[r] = column0 * m[0] + column1 * m[1] + column2 * m[2];
+			raw[4 + r] = column0 * m[4] + column1 * m[5] + column2 * m[6];
+			raw[8 + r] = column0 * m[8] + column1 * m[9] + column2 * m[10];
 		}
+		return *this;
+	}
 
+	Matrix4 Matrix4::operator*(Matrix4 const& other) const
+	{
+		Matrix4 result;
+		Multiply(raw, other.raw, result.raw);
 		return result;
 	}
 
 	Matrix4& Matrix4::operator*=(Matrix4 const& other)
 	{
-		Matrix4 result;
-
-		for (int row = 0; row < 4; row++)
-		{
-			for (int col = 0; col < 4; col++)
-			{
-				for (int a = 0; a < 4; a++)
-				{
-					result[row][col] += (*this)[a][col] * other[row][a];
-				}
-			}
-		}
-
-		*this = result;
-
+		Multiply(raw, other.raw, raw);
 		return *this;
 	}
 
@@ -488,11 +818,17 @@ namespace LibMath
 
 	Matrix4 Matrix4::GetInverse() const
 	{
-		Matrix4 inverse;
+		float determinant;
+		return GetInverse(determinant);
+	}
 
-		const float determinant = Determinant();
-		if (determinant == 0) return inverse;
+	Matrix4 Matrix4::GetInverse(float& outDeterminant) const
+	{
+		Matrix4 inverse;
 
+#if LIBMATH_SSE
+		outDeterminant = InverseSSE(raw, inverse.raw);
+#else
 		const float cof0 = GetMinor(Data()[5], Data()[9], Data()[13], Data()[6], Data()[10], Data()[14],
 			Data()[7], Data()[11], Data()[15]);
 		const float cof1 = GetMinor(Data()[1], Data()[9], Data()[13], Data()[2], Data()[10], Data()[14],
@@ -503,7 +839,8 @@ namespace LibMath
 			Data()[3], Data()[7], Data()[11]);
 
 		const float det = Data()[0] * cof0 - Data()[4] * cof1 + Data()[8] * cof2 - Data()[12] * cof3;
-		if (fabs(det) == 0) return inverse;
+		outDeterminant = det;
+		if (det == 0) return inverse;
 
 		const float cof4 = GetMinor(Data()[4], Data()[8], Data()[12], Data()[6], Data()[10], Data()[14],
 			Data()[7], Data()[11], Data()[15]);
@@ -550,7 +887,38 @@ namespace LibMath
 		inverse[1][3] = detInv * cof7;
 		inverse[2][3] = -detInv * cof11;
 		inverse[3][3] = detInv * cof15;
+#endif
+
+		return inverse;
+	}
+
+	Matrix4 Matrix4::GetInverseRigid() const
+	{
+		Matrix4 inverse;
 
+		for (int c = 0; c < 3; c++)
+		{
+			for (int r = 0; r < 3; r++)
+			{
+				inverse.raw[c * 4 + r] = raw[r * 4 + c];
+			}
+
+			inverse.raw[12 + c] = -(raw[c * 4] * raw[12] + raw[c * 4 + 1] * raw[13] + raw[c * 4 + 2] * raw[14]);
+		}
+		inverse.raw[15] = 1.f;
+
+		return inverse;
+	}
+
+	Matrix4 Matrix4::GetInverseAffine() const
+	{
+#if LIBMATH_SSE
+		Matrix4 inverse;
+		InverseAffineSSE(raw, inverse.raw);
 		return inverse;
+#else
+		const Affine3 inverse = Affine3(*this).GetInverse();
+		return inverse == Affine3() ? Matrix4() : inverse.ToMatrix4();
+#endif
 	}
 }
\ No newline at end of file
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <cstring>
-
 #include "Core/Angle.h"
 #include "Vector/Vector.h"
 #include "Quaternion/Quaternion.h"
@@ -9,38 +7,39 @@
 namespace LibMath
 {
 	struct Vector3;
+	struct Matrix3;
 
 	struct const_col
 	{
-		const_col(float const* ptr) : m_ptr(ptr) {}
+		constexpr const_col(float const* ptr) : m_ptr(ptr) {}
 		float const* m_ptr;
 
-		float operator[](int idx) const { return m_ptr[idx * 4]; }
+		constexpr float operator[](int idx) const { return m_ptr[idx * 4]; }
 	};
 
 	struct col
 	{
-		col(float* ptr) : m_ptr(ptr) {}
+		constexpr col(float* ptr) : m_ptr(ptr) {}
 		float* m_ptr;
 
-		float& operator[](int idx) { return m_ptr[idx * 4]; }
+		constexpr float& operator[](int idx) { return m_ptr[idx * 4]; }
 	};
 
 	struct row
 	{
-		row(float* ptr) : m_ptr(ptr) {}
+		constexpr row(float* ptr) : m_ptr(ptr) {}
 		float* m_ptr;
 
-		float& operator[](int idx) { return m_ptr[idx]; }
-		row& operator=(const_col const& other) { for (int i = 0; i < 4; i++) (*this)[i] = other[i]; return *this; }
+		constexpr float& operator[](int idx) { return m_ptr[idx]; }
+		constexpr row& operator=(const_col const& other) { for (int i = 0; i < 4; i++) (*this)[i] = other[i]; return *this; }
 	};
 
 	struct const_row
 	{
-		const_row(float const* ptr) : m_ptr(ptr) {}
+		constexpr const_row(float const* ptr) : m_ptr(ptr) {}
 		float const* m_ptr;
 
-		float operator[](int idx) const { return m_ptr[idx]; }
+		constexpr float operator[](int idx) const { return m_ptr[idx]; }
 	};
 
 	struct GridRow
@@ -55,23 +54,41 @@ namespace LibMath
 
 	struct Matrix4
 	{
-		Matrix4() { Clear(); /*gridview = new(raw)GridView;*/ }
-		Matrix4(Matrix4 const& other) = default;
-		Matrix4& operator=(const Matrix4& other) = default;
-		Matrix4(float diagonalValue);
+		constexpr Matrix4() = default;
+		constexpr Matrix4(Matrix4 const& other) = default;
+		constexpr Matrix4& operator=(const Matrix4& other) = default;
+		constexpr Matrix4(float diagonalValue) :
+			raw{ diagonalValue, 0.f, 0.f, 0.f,
+				0.f, diagonalValue, 0.f, 0.f,
+				0.f, 0.f, diagonalValue, 0.f,
+				0.f, 0.f, 0.f, diagonalValue } {}
 		~Matrix4() = default;
 
 		/*
 		 * @brief Create an identity matrix (diagonal == 1)
 		 * @return a matrix4
 		 */
-		static Matrix4 Identity() { return Matrix4(1.f); }
+		static constexpr Matrix4 Identity() { return Matrix4(1.f); }
 		/*
 		 * @brief Create a orthographic matrix
 		 * @param 6 float : left, right, bot, top, near, far
 		 * @return a matrix4
 		 */
-		static Matrix4 Orthographic(float left, float right, float bottom, float top, float near, float far);
+		static constexpr Matrix4 Orthographic(float l, float r, float b, float t, float n, float f)
+		{
+			Matrix4 result;
+
+			result.raw[0] = 2 / (r - l);
+			result.raw[5] = 2 / (t - b);
+			result.raw[10] = -2 / (f - n);
+
+			result.raw[12] = -(r + l) / (r - l);
+			result.raw[13] = -(t + b) / (t - b);
+			result.raw[14] = -(f + n) / (f - n);
+			result.raw[15] = 1.f;
+
+			return result;
+		}
 		/*
 		 * @brief Create a perspective matrix 
 		 * @param Radian fov, float aspect ration (width/height), float near and far
@@ -115,84 +132,165 @@ namespace LibMath
 		 * @param 3 floats with scaling components
 		 * @return a matrix4
 		 */
-		static Matrix4 Scaling(float x, float y, float z);
+		static constexpr Matrix4 Scaling(float x, float y, float z)
+		{
+			Matrix4 result;
+
+			result.raw[0] = x;
+			result.raw[5] = y;
+			result.raw[10] = z;
+			result.raw[15] = 1.f;
+
+			return result;
+		}
 		/*
 		 * @brief Create a scaling matrix
 		 * @param vector with the 3 scaling components
 		 * @return a matrix4
 		 */
-		static Matrix4 Scaling(const Vector3& vec);
+		static constexpr Matrix4 Scaling(const Vector3& vec) { return Scaling(vec.x, vec.y, vec.z); }
 		/*
 		 * @brief Create a translation matrix
 		 * @param 3 floats with translation components
 		 * @return a matrix4
 		 */
-		static Matrix4 Translation(float x, float y, float z);
+		static constexpr Matrix4 Translation(float x, float y, float z)
+		{
+			Matrix4 result = Identity();
+
+			result.raw[12] = x;
+			result.raw[13] = y;
+			result.raw[14] = z;
+
+			return result;
+		}
 		/*
 		 * @brief Create a translation matrix
 		 * @param vector with the 3 translation components
 		 * @return a matrix4
 		 */
-		static Matrix4 Translation(const Vector3& vec);
+		static constexpr Matrix4 Translation(const Vector3& vec) { return Translation(vec.x, vec.y, vec.z); }
 
 		/*
-		 * @brief Modifies a rotation matrix
+		 * @brief Create Translation(translation) * Rotation(rotation) * Scaling(scale), writing the 16 floats directly
+		 * instead of multiplying three matrices. The rotation does not have to be normalized
+		 * @param translation, rotation, scale
+		 * @return a matrix4
+		 */
+		static Matrix4 FromTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+
+		/*
+		 * @brief Modifies a rotation matrix, same as PreRotate()
 		 * @param quaternion
 		 * @return the modified matrix4
 		 */
-		 //Maybe swap order of multiplication
-		Matrix4& Rotate(Quaternion const& quaternion) { *this = Rotation(quaternion) * (*this); return *this; }
+		Matrix4& Rotate(Quaternion const& quaternion) { return PreRotate(quaternion); }
 
 		/*
-		 * @brief Modifies a rotation matrix
+		 * @brief Modifies a rotation matrix, same as PreRotate()
 		 * @param 3 radian x, y, z
 		 * @return the modified matrix4
 		 */
-		Matrix4& Rotate(Radian x, Radian y, Radian z) { *this = Rotation(x, y, z)* (*this); return *this; }
+		Matrix4& Rotate(Radian x, Radian y, Radian z) { return PreMultiply3x3(Rotation(x, y, z)); }
 
 		/*
-		 * @brief Modifies a rotation matrix
+		 * @brief Modifies a rotation matrix, same as PreRotate()
 		 * @param vector with the 3 rotation components + bool is radian or degree
 		 * @return the modified matrix4
 		 */
-		Matrix4& Rotate(const Vector3& vec, bool radian) { *this = Rotation(vec, radian)* (*this); return *this; }
+		Matrix4& Rotate(const Vector3& vec, bool radian) { return PreMultiply3x3(Rotation(vec, radian)); }
 
 		/*
-		 * @brief Modifies a scaling matrix
+		 * @brief Modifies a scaling matrix, same as PreScale()
 		 * @param 3 floats with scaling components
 		 * @return the modified matrix4
 		 */
-		Matrix4& Scale(float x, float y, float z) { *this = Scaling(x, y, z)* (*this); return *this; }
+		Matrix4& Scale(float x, float y, float z) { return PreScale(x, y, z); }
 
 		/*
-		 * @brief Modifies a scaling matrix
+		 * @brief Modifies a scaling matrix, same as PreScale()
 		 * @param vector with the 3 scaling components
 		 * @return the modified matrix4
 		 */
-		Matrix4& Scale(const Vector3& vec) { *this = Scaling(vec)* (*this); return *this; }
+		Matrix4& Scale(const Vector3& vec) { return PreScale(vec.x, vec.y, vec.z); }
 
 		/*
-		 * @brief Modifies a translation matrix
+		 * @brief Modifies a translation matrix, same as PreTranslate()
 		 * @param 3 floats with translation components
 		 * @return the modified matrix4
 		 */
-		Matrix4& Translate(float x, float y, float z) { *this = Translation(x, y, z)* (*this); return *this; }
+		Matrix4& Translate(float x, float y, float z) { return PreTranslate(x, y, z); }
 
 		/*
-		 * @brief Modifies a translation matrix
+		 * @brief Modifies a translation matrix, same as PreTranslate()
 		 * @param vector with the 3 translation components
 		 * @return the modified matrix4
 		 */
-		Matrix4& Translate(const Vector3& vec) { *this = Translation(vec)* (*this); return *this; }
+		Matrix4& Translate(const Vector3& vec) { return PreTranslate(vec.x, vec.y, vec.z); }
+
+		/*
+		 * @brief *this = Translation(x, y, z) * (*this): translates after the current transformation, in world space.
+		 * Only adds the translation weighted by the last row, without building the translation matrix
+		 * @param 3 floats with translation components
+		 * @return the modified matrix4
+		 */
+		Matrix4& PreTranslate(float x, float y, float z);
+		Matrix4& PreTranslate(const Vector3& vec) { return PreTranslate(vec.x, vec.y, vec.z); }
+
+		/*
+		 * @brief *this = (*this) * Translation(x, y, z): translates before the current transformation, in local space.
+		 * Only the translation column changes
+		 * @param 3 floats with translation components
+		 * @return the modified matrix4
+		 */
+		Matrix4& PostTranslate(float x, float y, float z);
+		Matrix4& PostTranslate(const Vector3& vec) { return PostTranslate(vec.x, vec.y, vec.z); }
+
+		/*
+		 * @brief *this = Scaling(x, y, z) * (*this): scales the first three rows
+		 * @param 3 floats with scaling components
+		 * @return the modified matrix4
+		 */
+		Matrix4& PreScale(float x, float y, float z);
+		Matrix4& PreScale(const Vector3& vec) { return PreScale(vec.x, vec.y, vec.z); }
+
+		/*
+		 * @brief *this = (*this) * Scaling(x, y, z): scales the first three columns
+		 * @param 3 floats with scaling components
+		 * @return the modified matrix4
+		 */
+		Matrix4& PostScale(float x, float y, float z);
+		Matrix4& PostScale(const Vector3& vec) { return PostScale(vec.x, vec.y, vec.z); }
 
-		bool operator==(const Matrix4& other) const;
-		bool operator!=(const Matrix4& other) const { return !(*this == other); }
+		/*
+		 * @brief *this = Rotation(quaternion) * (*this): only the first three rows change
+		 * @param quaternion
+		 * @return the modified matrix4
+		 */
+		Matrix4& PreRotate(Quaternion const& quaternion) { return PreMultiply3x3(Rotation(quaternion)); }
+
+		/*
+		 * @brief *this = (*this) * Rotation(quaternion): only the first three columns change
+		 * @param quaternion
+		 * @return the modified matrix4
+		 */
+		Matrix4& PostRotate(Quaternion const& quaternion) { return PostMultiply3x3(Rotation(quaternion)); }
+
+		constexpr bool operator==(const Matrix4& other) const
+		{
+			for (int i = 0; i < 16; i++)
+				if (raw[i] != other.raw[i])
+					return false;
 
-		row operator[](int idx) { return row(&raw[idx * 4]); }
-		const_row operator[](int idx) const { return const_row(&raw[idx * 4]); }
+			return true;
+		}
+		constexpr bool operator!=(const Matrix4& other) const { return !(*this == other); }
 
-		LibMath::col col(int idx) { return LibMath::col(&raw[idx]); }
-		const_col col(int idx) const { return const_col(&raw[idx]); }
+		constexpr row operator[](int idx) { return row(&raw[idx * 4]); }
+		constexpr const_row operator[](int idx) const { return const_row(&raw[idx * 4]); }
+
+		constexpr LibMath::col col(int idx) { return LibMath::col(&raw[idx]); }
+		constexpr const_col col(int idx) const { return const_col(&raw[idx]); }
 
 		Matrix4 operator*(Matrix4 const& other) const;
 		Matrix4& operator*=(Matrix4 const& other);
@@ -211,7 +309,7 @@ namespace LibMath
 		 * @brief called from the matrix you want the translation from
 		 * @return this matrix now transposed
 		 */
-		[[nodiscard]] Vector4 GetTranslation() const { return Vector4((*this)[3][0], (*this)[3][1], (*this)[3][2], (*this)[3][3]); }
+		[[nodiscard]] constexpr Vector4 GetTranslation() const { return Vector4(raw[12], raw[13], raw[14], raw[15]); }
 		static Vector4 GetTranslation(Matrix4& Matrix4) { return Matrix4.GetTranslation(); }
 
 		/*
@@ -224,12 +322,53 @@ namespace LibMath
 
 		/*
 		 * @brief called with the matrix you want the inverse from
-		 * @return this matrix now inversed
+		 * @return this matrix now inversed, zero if the matrix is singular
 		 */
 		void Inverse() { *this = GetInverse(); }
 		[[nodiscard]] Matrix4 GetInverse() const;
 		static void Inverse(Matrix4& Matrix4) { Matrix4.Inverse(); }
 
+		/*
+		 * @brief called with the matrix you want the inverse from
+		 * @param outDeterminant receives the determinant, 0 if the matrix is singular
+		 * @return the inverse matrix, zero if the matrix is singular
+		 */
+		[[nodiscard]] Matrix4 GetInverse(float& outDeterminant) const;
+
+		/*
+		 * @brief called with a rotation and translation matrix, without scale, like camera or bone matrices.
+		 * The rotation is transposed and the translation rotated back: much cheaper than GetInverse()
+		 * @return this matrix now inversed
+		 */
+		void InverseRigid() { *this = GetInverseRigid(); }
+		[[nodiscard]] Matrix4 GetInverseRigid() const;
+		static void InverseRigid(Matrix4& Matrix4) { Matrix4.InverseRigid(); }
+
+		/*
+		 * @brief called with an affine matrix, whose last row is (0, 0, 0, 1).
+		 * Only the 3x3 part is inverted, then the translation: cheaper than GetInverse()
+		 * @return this matrix now inversed, zero if the matrix is singular
+		 */
+		void InverseAffine() { *this = GetInverseAffine(); }
+		[[nodiscard]] Matrix4 GetInverseAffine() const;
+		static void InverseAffine(Matrix4& Matrix4) { Matrix4.InverseAffine(); }
+
+		/*
+		 * @brief split an affine matrix in translation, rotation and scale, matrix = T * R * S, without trigonometry.
+		 * A mirrored matrix gets a negative scale.x. Shear is lost, use DecomposePolar() for such matrices
+		 * @param outTranslation, outRotation, outScale receive the components
+		 * @return false if a scale is zero, the rotation is then the identity
+		 */
+		bool Decompose(Vector3& outTranslation, Quaternion& outRotation, Vector3& outScale) const;
+
+		/*
+		 * @brief split an affine matrix, shear included, in translation, rotation and a symmetric stretch:
+		 * matrix = T * R * stretch. The rotation is the closest one to the 3x3 part, found by iterations
+		 * @param outTranslation, outRotation, outStretch receive the components, outStretch[i][j] scaling axis j into axis i
+		 * @return false if the 3x3 part is singular, the rotation is then the identity and the stretch zero
+		 */
+		bool DecomposePolar(Vector3& outTranslation, Quaternion& outRotation, Matrix3& outStretch) const;
+
 		/*
 		 * @brief called with the matrix you want the adjoint from
 		 * @return this matrix now inversed
@@ -248,15 +387,21 @@ namespace LibMath
 		/*
 		 * @brief erase all values from a matrix
 		 */
-		void Clear() { std::memset(&raw, 0, sizeof(raw)); }
+		constexpr void Clear() { for (float& value : raw) value = 0.f; }
 
-		float const* Data() const { return raw; }
+		constexpr float const* Data() const { return raw; }
 
-		float raw[16];
+		float raw[16]{};
 		//GridView* gridview;
 
 	private:
 
+		/*
+		 * @brief Multiply by the 3x3 part of a rotation matrix, its translation and last row being ignored
+		 */
+		Matrix4& PreMultiply3x3(const Matrix4& rotation);
+		Matrix4& PostMultiply3x3(const Matrix4& rotation);
+
 		static float GetMinor(float p_minor0, float p_minor1, float p_minor2, float p_minor3, float p_minor4, float p_minor5, float p_minor6, float p_minor7, float p_minor8);
 		float Determinant(int ignoredRow, int ignoredCol) const;
 	};
@@ -0,0 +1,301 @@
+#include "Matrix4d.h"
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+#include "Matrix/Matrix4.h"
+
+namespace LibMath
+{
+	namespace
+	{
+		/**
+		 * @brief Matrices rebased by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_REBASE_COUNT = 1 << 13;
+
+		/**
+		 * @brief Column-major product: column c of output is the columns of lhs weighted by column c of rhs.
+		 * Every kernel reads its inputs before writing an output column, so output may alias lhs or rhs.
+		 */
+		using MultiplyFunction = void (*)(const double* lhs, const double* rhs, double* output);
+
+		/**
+		 * @brief output = matrix * (x, y, z, w)
+		 */
+		using TransformFunction = void (*)(const double* matrix, double x, double y, double z, double w, double* output);
+
+		void MultiplyScalar(const double* lhs, const double* rhs, double* output)
+		{
+			double left[16];
+			for (int i = 0; i < 16; i++)
+			{
+				left[i] = lhs[i];
+			}
+
+			for (int c = 0; c < 4; c++)
+			{
+				const double weights[4] = { rhs[c * 4], rhs[c * 4 + 1], rhs[c * 4 + 2], rhs[c * 4 + 3] };
+				for (int r = 0; r < 4; r++)
+				{
+					output[c * 4 + r] = left[r] * weights[0] + left[4 + r] * weights[1] + left[8 + r] * weights[2] + left[12 + r] * weights[3];
+				}
+			}
+		}
+
+		void TransformScalar(const double* m, const double x, const double y, const double z, const double w, double* output)
+		{
+			for (int r = 0; r < 4; r++)
+			{
+				output[r] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r] * w;
+			}
+		}
+
+		void RebaseScalar(const Matrix4d* matrices, const Vector3d& origin, Matrix4* output, const size_t begin, const size_t end)
+		{
+			const double shift[4] = { origin.x, origin.y, origin.z, 0.0 };
+			for (size_t i = begin; i < end; i++)
+			{
+				const double* m = matrices[i].raw;
+				for (int c = 0; c < 4; c++)
+				{
+					for (int r = 0; r < 4; r++)
+					{
+						output[i].raw[c * 4 + r] = static_cast<float>(m[c * 4 + r] - shift[r] * m[c * 4 + 3]);
+					}
+				}
+			}
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief One column of four doubles per AVX register.
+		 */
+		LIBMATH_TARGET("avx,fma")
+		void MultiplyFMA(const double* lhs, const double* rhs, double* output)
+		{
+			const __m256d column0 = _mm256_loadu_pd(lhs);
+			const __m256d column1 = _mm256_loadu_pd(lhs + 4);
+			const __m256d column2 = _mm256_loadu_pd(lhs + 8);
+			const __m256d column3 = _mm256_loadu_pd(lhs + 12);
+
+			for (int c = 0; c < 4; c++)
+			{
+				__m256d result = _mm256_mul_pd(column0, _mm256_broadcast_sd(rhs + c * 4));
+				result = _mm256_fmadd_pd(column1, _mm256_broadcast_sd(rhs + c * 4 + 1), result);
+				result = _mm256_fmadd_pd(column2, _mm256_broadcast_sd(rhs + c * 4 + 2), result);
+				result = _mm256_fmadd_pd(column3, _mm256_broadcast_sd(rhs + c * 4 + 3), result);
+				_mm256_storeu_pd(output + c * 4, result);
+			}
+		}
+
+		LIBMATH_TARGET("avx,fma")
+		void TransformFMA(const double* m, const double x, const double y, const double z, const double w, double* output)
+		{
+			__m256d result = _mm256_mul_pd(_mm256_loadu_pd(m), _mm256_set1_pd(x));
+			result = _mm256_fmadd_pd(_mm256_loadu_pd(m + 4), _mm256_set1_pd(y), result);
+			result = _mm256_fmadd_pd(_mm256_loadu_pd(m + 8), _mm256_set1_pd(z), result);
+			result = _mm256_fmadd_pd(_mm256_loadu_pd(m + 12), _mm256_set1_pd(w), result);
+			_mm256_storeu_pd(output, result);
+		}
+
+		/**
+		 * @brief Same operations as RebaseScalar(), one column per register, so both give the same floats.
+		 */
+		LIBMATH_TARGET("avx2")
+		void RebaseAVX2(const Matrix4d* matrices, const Vector3d& origin, Matrix4* output, const size_t begin, const size_t end)
+		{
+			const __m256d shift = _mm256_setr_pd(origin.x, origin.y, origin.z, 0.0);
+			for (size_t i = begin; i < end; i++)
+			{
+				const double* m = matrices[i].raw;
+				for (int c = 0; c < 4; c++)
+				{
+					const __m256d column = _mm256_loadu_pd(m + c * 4);
+					const __m256d w = _mm256_permute4x64_pd(column, _MM_SHUFFLE(3, 3, 3, 3));
+					_mm_storeu_ps(output[i].raw + c * 4, _mm256_cvtpd_ps(_mm256_sub_pd(column, _mm256_mul_pd(shift, w))));
+				}
+			}
+		}
+#endif
+
+		bool HasFMAKernels()
+		{
+#if LIBMATH_SSE
+			return SIMD::HasAVX2() && SIMD::HasFMA();
+#else
+			return false;
+#endif
+		}
+
+		void Multiply(const double* lhs, const double* rhs, double* output)
+		{
+#if LIBMATH_SSE
+			static const MultiplyFunction multiply = HasFMAKernels() ? MultiplyFMA : MultiplyScalar;
+#else
+			static const MultiplyFunction multiply = MultiplyScalar;
+#endif
+			multiply(lhs, rhs, output);
+		}
+
+		void Transform(const double* m, const double x, const double y, const double z, const double w, double* output)
+		{
+#if LIBMATH_SSE
+			static const TransformFunction transform = HasFMAKernels() ? TransformFMA : TransformScalar;
+#else
+			static const TransformFunction transform = TransformScalar;
+#endif
+			transform(m, x, y, z, w, output);
+		}
+	}
+
+	Matrix4d::Matrix4d(const Matrix4& other)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			raw[i] = other.raw[i];
+		}
+	}
+
+	Matrix4 Matrix4d::ToMatrix4() const
+	{
+		Matrix4 result;
+		for (int i = 0; i < 16; i++)
+		{
+			result.raw[i] = static_cast<float>(raw[i]);
+		}
+		return result;
+	}
+
+	Matrix4d Matrix4d::FromTRS(const Vector3d& translation, const Quaterniond& rotation, const Vector3d& scale)
+	{
+		// Dividing by the squared norm gives the rotation of the normalized quaternion without a square root
+		const double norm = rotation.DotProduct(rotation);
+		const double factor = norm > 0.0 ? 2.0 / norm : 0.0;
+
+		const double factorX = factor * rotation.X;
+		const double factorY = factor * rotation.Y;
+		const double factorZ = factor * rotation.Z;
+
+		const double xx = factorX * rotation.X;
+		const double yy = factorY * rotation.Y;
+		const double zz = factorZ * rotation.Z;
+		const double xy = factorX * rotation.Y;
+		const double xz = factorX * rotation.Z;
+		const double xw = factorX * rotation.W;
+		const double yz = factorY * rotation.Z;
+		const double yw = factorY * rotation.W;
+		const double zw = factorZ * rotation.W;
+
+		Matrix4d result;
+
+		result.raw[0] = (1.0 - yy - zz) * scale.x;
+		result.raw[1] = (xy + zw) * scale.x;
+		result.raw[2] = (xz - yw) * scale.x;
+
+		result.raw[4] = (xy - zw) * scale.y;
+		result.raw[5] = (1.0 - xx - zz) * scale.y;
+		result.raw[6] = (yz + xw) * scale.y;
+
+		result.raw[8] = (xz + yw) * scale.z;
+		result.raw[9] = (yz - xw) * scale.z;
+		result.raw[10] = (1.0 - xx - yy) * scale.z;
+
+		result.raw[12] = translation.x;
+		result.raw[13] = translation.y;
+		result.raw[14] = translation.z;
+		result.raw[15] = 1.0;
+
+		return result;
+	}
+
+	Matrix4d Matrix4d::operator*(const Matrix4d& other) const
+	{
+		Matrix4d result;
+		Multiply(raw, other.raw, result.raw);
+		return result;
+	}
+
+	Matrix4d& Matrix4d::operator*=(const Matrix4d& other)
+	{
+		Multiply(raw, other.raw, raw);
+		return *this;
+	}
+
+	Vector4d Matrix4d::operator*(const Vector4d& other) const
+	{
+		Vector4d result;
+		Transform(raw, other.x, other.y, other.z, other.w, &result.x);
+		return result;
+	}
+
+	Vector3d Matrix4d::TransformPoint(const Vector3d& point) const
+	{
+		double result[4];
+		Transform(raw, point.x, point.y, point.z, 1.0, result);
+		return Vector3d(result[0], result[1], result[2]);
+	}
+
+	Vector3d Matrix4d::TransformDirection(const Vector3d& direction) const
+	{
+		double result[4];
+		Transform(raw, direction.x, direction.y, direction.z, 0.0, result);
+		return Vector3d(result[0], result[1], result[2]);
+	}
+
+	Matrix4d Matrix4d::GetInverseAffine() const
+	{
+		Matrix4d inverse;
+
+		// Element (r, c) of the column-major 3x3 part
+		const auto m = [this](const int r, const int c) { return raw[c * 4 + r]; };
+
+		// Cofactors of the first row, the first column of the inverse once divided, the determinant reuses them
+		const double cofactor00 = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+		const double cofactor10 = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+		const double cofactor20 = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+
+		const double determinant = m(0, 0) * cofactor00 + m(0, 1) * cofactor10 + m(0, 2) * cofactor20;
+		if (determinant == 0.0) return inverse;
+
+		const double inverseDeterminant = 1.0 / determinant;
+
+		inverse.raw[0] = cofactor00 * inverseDeterminant;
+		inverse.raw[1] = cofactor10 * inverseDeterminant;
+		inverse.raw[2] = cofactor20 * inverseDeterminant;
+
+		inverse.raw[4] = (m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2)) * inverseDeterminant;
+		inverse.raw[5] = (m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0)) * inverseDeterminant;
+		inverse.raw[6] = (m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1)) * inverseDeterminant;
+
+		inverse.raw[8] = (m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1)) * inverseDeterminant;
+		inverse.raw[9] = (m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2)) * inverseDeterminant;
+		inverse.raw[10] = (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * inverseDeterminant;
+
+		// The inverse translation brings the translation back to the origin
+		const Vector3d translation = inverse.TransformDirection(GetTranslation());
+		inverse.raw[12] = -translation.x;
+		inverse.raw[13] = -translation.y;
+		inverse.raw[14] = -translation.z;
+		inverse.raw[15] = 1.0;
+
+		return inverse;
+	}
+
+	void RebaseToFloat(const Matrix4d* matrices, const Vector3d& origin, Matrix4* output, const size_t count)
+	{
+#if LIBMATH_SSE
+		if (SIMD::HasAVX2())
+		{
+			Parallel::For(count, PARALLEL_REBASE_COUNT, [matrices, &origin, output](const size_t begin, const size_t end)
+			{
+				RebaseAVX2(matrices, origin, output, begin, end);
+			});
+			return;
+		}
+#endif
+		Parallel::For(count, PARALLEL_REBASE_COUNT, [matrices, &origin, output](const size_t begin, const size_t end)
+		{
+			RebaseScalar(matrices, origin, output, begin, end);
+		});
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Quaternion/QuaternionD.h"
+#include "Vector/VectorD.h"
+
+namespace LibMath
+{
+	struct Matrix4;
+
+	/**
+	 * @brief Matrix4 with double precision components, stored column-major like Matrix4: raw[c * 4 + r].
+	 * Meant for the world transformations of large scenes, rendering converts them to Matrix4 relative to
+	 * the camera with RebaseToFloat(). Products and transforms use AVX2 and FMA when the CPU has them.
+	 */
+	struct Matrix4d
+	{
+		constexpr Matrix4d() = default;
+		constexpr Matrix4d(const double diagonalValue) :
+			raw{ diagonalValue, 0.0, 0.0, 0.0,
+				0.0, diagonalValue, 0.0, 0.0,
+				0.0, 0.0, diagonalValue, 0.0,
+				0.0, 0.0, 0.0, diagonalValue } {}
+
+		/*
+		 * @brief widen a Matrix4, exactly
+		 */
+		explicit Matrix4d(const Matrix4& other);
+
+		/*
+		 * @brief round this matrix to a Matrix4, use RebaseToFloat() for matrices far from the world origin
+		 * @return a matrix4
+		 */
+		[[nodiscard]] Matrix4 ToMatrix4() const;
+
+		static constexpr Matrix4d Identity() { return Matrix4d(1.0); }
+
+		/*
+		 * @brief Create a translation matrix
+		 * @param translation
+		 * @return a matrix4d
+		 */
+		static constexpr Matrix4d Translation(const Vector3d& translation)
+		{
+			Matrix4d result(1.0);
+			result.raw[12] = translation.x;
+			result.raw[13] = translation.y;
+			result.raw[14] = translation.z;
+			return result;
+		}
+
+		/*
+		 * @brief Create Translation * Rotation * Scaling, same as Matrix4::FromTRS()
+		 * @param translation, rotation (not necessarily normalized), scale
+		 * @return a matrix4d
+		 */
+		static Matrix4d FromTRS(const Vector3d& translation, const Quaterniond& rotation, const Vector3d& scale);
+
+		constexpr bool operator==(const Matrix4d& other) const
+		{
+			for (int i = 0; i < 16; i++)
+				if (raw[i] != other.raw[i])
+					return false;
+
+			return true;
+		}
+		constexpr bool operator!=(const Matrix4d& other) const { return !(*this == other); }
+
+		Matrix4d operator*(const Matrix4d& other) const;
+		Matrix4d& operator*=(const Matrix4d& other);
+
+		Vector4d operator*(const Vector4d& other) const;
+
+		/*
+		 * @brief transform a point, w being 1, without perspective divide
+		 */
+		[[nodiscard]] Vector3d TransformPoint(const Vector3d& point) const;
+
+		/*
+		 * @brief transform a direction, w being 0: the translation is ignored
+		 */
+		[[nodiscard]] Vector3d TransformDirection(const Vector3d& direction) const;
+
+		[[nodiscard]] constexpr Vector3d GetTranslation() const { return Vector3d(raw[12], raw[13], raw[14]); }
+
+		/*
+		 * @brief called with an affine matrix, whose last row is (0, 0, 0, 1)
+		 * @return the inverse matrix, zero if the matrix is singular
+		 */
+		[[nodiscard]] Matrix4d GetInverseAffine() const;
+
+		constexpr double const* Data() const { return raw; }
+
+		double raw[16]{};
+	};
+
+	static_assert(sizeof(Matrix4d) == 16 * sizeof(double), "Matrix4d must stay tightly packed to be converted in batches");
+
+	/**
+	 * @brief Convert matrices to float relative to an origin, output[i] = Translation(-origin) * matrices[i] rounded once.
+	 * The translation is subtracted in double before rounding, so objects close to the origin keep their full float
+	 * precision whatever their distance to the world origin. Uses AVX2 when the CPU has it and processes large arrays
+	 * in parallel. The camera matrices must be rebased on the same origin, the view matrix keeping only its rotation.
+	 *
+	 * @param matrices Array of world matrices
+	 * @param origin New origin, usually the camera position
+	 * @param output Array receiving the relative matrices
+	 * @param count Number of matrices in both arrays
+	 */
+	void RebaseToFloat(const Matrix4d* matrices, const Vector3d& origin, Matrix4* output, size_t count);
+}
@@ -0,0 +1,947 @@
+#include "MatrixBatch.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "Core/BitMask.h"
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+#include "Matrix/Affine3.h"
+#include "Matrix/Matrix4.h"
+#include "Matrix/MatrixKernels.h"
+#include "Quaternion/Quaternion.h"
+#include "Vector/TVector2.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector3SoA.h"
+#include "Vector/Vector4.h"
+
+namespace LibMath::MatrixBatch
+{
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Batched kernels expect tightly packed Vector3");
+	static_assert(sizeof(Vector4) == 4 * sizeof(float), "Batched kernels expect tightly packed Vector4");
+	static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Batched kernels expect tightly packed Quaternion");
+	static_assert(sizeof(TVector2<float>) == 2 * sizeof(float), "Batched kernels expect tightly packed TVector2<float>");
+
+	namespace
+	{
+		/**
+		 * @brief Vectors transformed by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_TRANSFORM_COUNT = 1 << 15;
+
+		/**
+		 * @brief Matrices inverted by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_INVERSE_COUNT = 1 << 12;
+
+		/**
+		 * @brief Matrices decomposed by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_DECOMPOSE_COUNT = 1 << 12;
+
+		/**
+		 * @brief Transformations composed by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_COMPOSE_COUNT = 1 << 13;
+
+		/**
+		 * @brief Matrices multiplied by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_MULTIPLY_COUNT = 1 << 13;
+
+		/**
+		 * @brief Mask words, 32 points each, projected by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_PROJECT_WORD_COUNT = 1 << 9;
+
+		/**
+		 * @brief How many elements ahead the products prefetch their operands.
+		 */
+		constexpr size_t PREFETCH_DISTANCE = 8;
+
+		enum class Mode
+		{
+			POINT,
+			PROJECTED_POINT,
+			DIRECTION,
+		};
+
+		/**
+		 * @brief Transform of one vector, summed in the same order as Matrix4 * Vector4.
+		 */
+		template <Mode TransformMode>
+		void TransformScalar(const float* m, const float x, const float y, const float z, float& outX, float& outY, float& outZ)
+		{
+			float resultX = m[0] * x + m[4] * y + m[8] * z;
+			float resultY = m[1] * x + m[5] * y + m[9] * z;
+			float resultZ = m[2] * x + m[6] * y + m[10] * z;
+
+			if constexpr (TransformMode != Mode::DIRECTION)
+			{
+				resultX += m[12];
+				resultY += m[13];
+				resultZ += m[14];
+			}
+
+			if constexpr (TransformMode == Mode::PROJECTED_POINT)
+			{
+				const float w = m[3] * x + m[7] * y + m[11] * z + m[15];
+				resultX /= w;
+				resultY /= w;
+				resultZ /= w;
+			}
+
+			outX = resultX;
+			outY = resultY;
+			outZ = resultZ;
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Matrix coefficients broadcast once per range.
+		 */
+		struct BroadcastMatrix
+		{
+			__m128 m[16];
+
+			explicit BroadcastMatrix(const float* matrix)
+			{
+				for (int i = 0; i < 16; i++)
+				{
+					m[i] = _mm_set1_ps(matrix[i]);
+				}
+			}
+
+			template <Mode TransformMode>
+			void Transform(__m128& x, __m128& y, __m128& z) const
+			{
+				__m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[4], y)), _mm_mul_ps(m[8], z));
+				__m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[1], x), _mm_mul_ps(m[5], y)), _mm_mul_ps(m[9], z));
+				__m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[2], x), _mm_mul_ps(m[6], y)), _mm_mul_ps(m[10], z));
+
+				if constexpr (TransformMode != Mode::DIRECTION)
+				{
+					resultX = _mm_add_ps(resultX, m[12]);
+					resultY = _mm_add_ps(resultY, m[13]);
+					resultZ = _mm_add_ps(resultZ, m[14]);
+				}
+
+				if constexpr (TransformMode == Mode::PROJECTED_POINT)
+				{
+					const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[3], x), _mm_mul_ps(m[7], y)), _mm_mul_ps(m[11], z)), m[15]);
+					resultX = _mm_div_ps(resultX, w);
+					resultY = _mm_div_ps(resultY, w);
+					resultZ = _mm_div_ps(resultZ, w);
+				}
+
+				x = resultX;
+				y = resultY;
+				z = resultZ;
+			}
+		};
+#endif
+
+		template <Mode TransformMode>
+		void TransformRange(const float* m, const Vector3* input, Vector3* output, size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			const BroadcastMatrix matrix(m);
+			for (; begin + 4 <= end; begin += 4)
+			{
+				__m128 x, y, z;
+				SIMD::LoadVector3x4(&input[begin].x, x, y, z);
+				matrix.Transform<TransformMode>(x, y, z);
+				SIMD::StoreVector3x4(&output[begin].x, x, y, z);
+			}
+#endif
+			for (; begin < end; begin++)
+			{
+				TransformScalar<TransformMode>(m, input[begin].x, input[begin].y, input[begin].z, output[begin].x, output[begin].y, output[begin].z);
+			}
+		}
+
+		template <Mode TransformMode>
+		void TransformRange(const float* m, const float* const (&input)[3], float* const (&output)[3], size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			const BroadcastMatrix matrix(m);
+			for (; begin + 4 <= end; begin += 4)
+			{
+				__m128 x = _mm_loadu_ps(input[0] + begin);
+				__m128 y = _mm_loadu_ps(input[1] + begin);
+				__m128 z = _mm_loadu_ps(input[2] + begin);
+				matrix.Transform<TransformMode>(x, y, z);
+				_mm_storeu_ps(output[0] + begin, x);
+				_mm_storeu_ps(output[1] + begin, y);
+				_mm_storeu_ps(output[2] + begin, z);
+			}
+#endif
+			for (; begin < end; begin++)
+			{
+				TransformScalar<TransformMode>(m, input[0][begin], input[1][begin], input[2][begin], output[0][begin], output[1][begin], output[2][begin]);
+			}
+		}
+
+		template <Mode TransformMode>
+		void Transform(const Matrix4& matrix, const Vector3* input, Vector3* output, const size_t count)
+		{
+			const float* m = matrix.raw;
+			Parallel::For(count, PARALLEL_TRANSFORM_COUNT, [m, input, output](const size_t begin, const size_t end)
+			{
+				TransformRange<TransformMode>(m, input, output, begin, end);
+			});
+		}
+
+		template <Mode TransformMode>
+		void Transform(const Matrix4& matrix, const Vector3SoA& input, Vector3SoA& output)
+		{
+			if (&output != &input)
+			{
+				output.Resize(input.Size());
+			}
+
+			const float* m = matrix.raw;
+			const float* const source[3] = { input.X(), input.Y(), input.Z() };
+			float* const target[3] = { output.X(), output.Y(), output.Z() };
+			Parallel::For(input.Size(), PARALLEL_TRANSFORM_COUNT, [m, &source, &target](const size_t begin, const size_t end)
+			{
+				TransformRange<TransformMode>(m, source, target, begin, end);
+			});
+		}
+
+		/**
+		 * @brief Decompose the matrices [begin, end), four at a time with one matrix per lane.
+		 * Follows the operations of Matrix4::Decompose() lane by lane, the branches becoming selections.
+		 */
+		void DecomposeRange(const Matrix4* matrices, Vector3* outTranslations, Quaternion* outRotations, Vector3* outScales, size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			for (; begin + 4 <= end; begin += 4)
+			{
+				const Matrix4* m = matrices + begin;
+
+				// column[c][r] holds the coefficient (r, c) of the four matrices
+				__m128 column[4][4];
+				for (int c = 0; c < 4; c++)
+				{
+					column[c][0] = _mm_loadu_ps(m[0].raw + c * 4);
+					column[c][1] = _mm_loadu_ps(m[1].raw + c * 4);
+					column[c][2] = _mm_loadu_ps(m[2].raw + c * 4);
+					column[c][3] = _mm_loadu_ps(m[3].raw + c * 4);
+					_MM_TRANSPOSE4_PS(column[c][0], column[c][1], column[c][2], column[c][3]);
+				}
+
+				SIMD::StoreVector3x4(&outTranslations[begin].x, column[3][0], column[3][1], column[3][2]);
+
+				__m128 scale[3];
+				__m128 r[3][3];
+				for (int c = 0; c < 3; c++)
+				{
+					__m128 squaredLength = _mm_mul_ps(column[c][0], column[c][0]);
+					squaredLength = _mm_add_ps(squaredLength, _mm_mul_ps(column[c][1], column[c][1]));
+					squaredLength = _mm_add_ps(squaredLength, _mm_mul_ps(column[c][2], column[c][2]));
+					scale[c] = _mm_sqrt_ps(squaredLength);
+
+					const __m128 inverseScale = _mm_div_ps(one, scale[c]);
+					for (int row = 0; row < 3; row++)
+					{
+						r[row][c] = _mm_mul_ps(column[c][row], inverseScale);
+					}
+				}
+
+				const __m128 degenerate = _mm_or_ps(_mm_or_ps(_mm_cmpeq_ps(scale[0], zero), _mm_cmpeq_ps(scale[1], zero)), _mm_cmpeq_ps(scale[2], zero));
+
+				__m128 determinant = _mm_mul_ps(r[0][0], _mm_sub_ps(_mm_mul_ps(r[1][1], r[2][2]), _mm_mul_ps(r[2][1], r[1][2])));
+				determinant = _mm_add_ps(determinant, _mm_mul_ps(r[1][0], _mm_sub_ps(_mm_mul_ps(r[2][1], r[0][2]), _mm_mul_ps(r[0][1], r[2][2]))));
+				determinant = _mm_add_ps(determinant, _mm_mul_ps(r[2][0], _mm_sub_ps(_mm_mul_ps(r[0][1], r[1][2]), _mm_mul_ps(r[1][1], r[0][2]))));
+
+				// Mirrored lanes negate scale.x and the first column
+				const __m128 mirror = _mm_and_ps(_mm_cmplt_ps(determinant, zero), signMask);
+				scale[0] = _mm_xor_ps(scale[0], mirror);
+				for (int row = 0; row < 3; row++)
+				{
+					r[row][0] = _mm_xor_ps(r[row][0], mirror);
+				}
+
+				SIMD::StoreVector3x4(&outScales[begin].x, scale[0], scale[1], scale[2]);
+
+				// Case of each lane: the largest of w, x, y and z
+				const __m128 trace = _mm_add_ps(_mm_add_ps(r[0][0], r[1][1]), r[2][2]);
+				const __m128 caseW = _mm_cmpgt_ps(trace, zero);
+				const __m128 caseX = _mm_andnot_ps(caseW, _mm_and_ps(_mm_cmpge_ps(r[0][0], r[1][1]), _mm_cmpge_ps(r[0][0], r[2][2])));
+				const __m128 caseY = _mm_andnot_ps(_mm_or_ps(caseW, caseX), _mm_cmpge_ps(r[1][1], r[2][2]));
+				const __m128 caseZ = _mm_andnot_ps(_mm_or_ps(_mm_or_ps(caseW, caseX), caseY), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+				__m128 radicand = _mm_add_ps(one, _mm_xor_ps(r[0][0], _mm_and_ps(_mm_or_ps(caseY, caseZ), signMask)));
+				radicand = _mm_add_ps(radicand, _mm_xor_ps(r[1][1], _mm_and_ps(_mm_or_ps(caseX, caseZ), signMask)));
+				radicand = _mm_add_ps(radicand, _mm_xor_ps(r[2][2], _mm_and_ps(_mm_or_ps(caseX, caseY), signMask)));
+
+				const __m128 largest = _mm_mul_ps(_mm_set1_ps(.5f), _mm_sqrt_ps(radicand));
+				const __m128 factor = _mm_div_ps(_mm_set1_ps(.25f), largest);
+
+				const __m128 difference0 = _mm_sub_ps(r[2][1], r[1][2]);
+				const __m128 difference1 = _mm_sub_ps(r[0][2], r[2][0]);
+				const __m128 difference2 = _mm_sub_ps(r[1][0], r[0][1]);
+				const __m128 sum0 = _mm_add_ps(r[0][1], r[1][0]);
+				const __m128 sum1 = _mm_add_ps(r[0][2], r[2][0]);
+				const __m128 sum2 = _mm_add_ps(r[1][2], r[2][1]);
+
+				__m128 x = SIMD::Select(caseX, largest, _mm_mul_ps(SIMD::Select(caseW, difference0, SIMD::Select(caseY, sum0, sum1)), factor));
+				__m128 y = SIMD::Select(caseY, largest, _mm_mul_ps(SIMD::Select(caseW, difference1, SIMD::Select(caseX, sum0, sum2)), factor));
+				__m128 z = SIMD::Select(caseZ, largest, _mm_mul_ps(SIMD::Select(caseW, difference2, SIMD::Select(caseX, sum1, sum2)), factor));
+				__m128 w = SIMD::Select(caseW, largest, _mm_mul_ps(SIMD::Select(caseX, difference0, SIMD::Select(caseY, difference1, difference2)), factor));
+
+				x = _mm_andnot_ps(degenerate, x);
+				y = _mm_andnot_ps(degenerate, y);
+				z = _mm_andnot_ps(degenerate, z);
+				w = SIMD::Select(degenerate, one, w);
+
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+				_mm_storeu_ps(&outRotations[begin].X, x);
+				_mm_storeu_ps(&outRotations[begin + 1].X, y);
+				_mm_storeu_ps(&outRotations[begin + 2].X, z);
+				_mm_storeu_ps(&outRotations[begin + 3].X, w);
+			}
+#endif
+			for (; begin < end; begin++)
+			{
+				matrices[begin].Decompose(outTranslations[begin], outRotations[begin], outScales[begin]);
+			}
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Coefficients of four Affine3::FromTRS() results, one transformation per lane: m[row][column], column 3 being the translation.
+		 * Follows the operations of Affine3::FromTRS() lane by lane.
+		 */
+		struct ComposedTRS
+		{
+			ComposedTRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales)
+			{
+				__m128 x = _mm_loadu_ps(&rotations[0].X);
+				__m128 y = _mm_loadu_ps(&rotations[1].X);
+				__m128 z = _mm_loadu_ps(&rotations[2].X);
+				__m128 w = _mm_loadu_ps(&rotations[3].X);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+
+				__m128 norm = _mm_mul_ps(x, x);
+				norm = _mm_add_ps(norm, _mm_mul_ps(y, y));
+				norm = _mm_add_ps(norm, _mm_mul_ps(z, z));
+				norm = _mm_add_ps(norm, _mm_mul_ps(w, w));
+				const __m128 factor = _mm_and_ps(_mm_cmpgt_ps(norm, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(2.f), norm));
+
+				const __m128 factorX = _mm_mul_ps(factor, x);
+				const __m128 factorY = _mm_mul_ps(factor, y);
+				const __m128 factorZ = _mm_mul_ps(factor, z);
+
+				const __m128 xx = _mm_mul_ps(factorX, x);
+				const __m128 yy = _mm_mul_ps(factorY, y);
+				const __m128 zz = _mm_mul_ps(factorZ, z);
+				const __m128 xy = _mm_mul_ps(factorX, y);
+				const __m128 xz = _mm_mul_ps(factorX, z);
+				const __m128 xw = _mm_mul_ps(factorX, w);
+				const __m128 yz = _mm_mul_ps(factorY, z);
+				const __m128 yw = _mm_mul_ps(factorY, w);
+				const __m128 zw = _mm_mul_ps(factorZ, w);
+
+				__m128 scaleX, scaleY, scaleZ;
+				SIMD::LoadVector3x4(&scales[0].x, scaleX, scaleY, scaleZ);
+
+				const __m128 one = _mm_set1_ps(1.f);
+				m[0][0] = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), scaleX);
+				m[0][1] = _mm_mul_ps(_mm_sub_ps(xy, zw), scaleY);
+				m[0][2] = _mm_mul_ps(_mm_add_ps(xz, yw), scaleZ);
+
+				m[1][0] = _mm_mul_ps(_mm_add_ps(xy, zw), scaleX);
+				m[1][1] = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), zz), scaleY);
+				m[1][2] = _mm_mul_ps(_mm_sub_ps(yz, xw), scaleZ);
+
+				m[2][0] = _mm_mul_ps(_mm_sub_ps(xz, yw), scaleX);
+				m[2][1] = _mm_mul_ps(_mm_add_ps(yz, xw), scaleY);
+				m[2][2] = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), scaleZ);
+
+				SIMD::LoadVector3x4(&translations[0].x, m[0][3], m[1][3], m[2][3]);
+			}
+
+			void Store(Matrix4* output) const
+			{
+				const __m128 zero = _mm_setzero_ps();
+				for (int c = 0; c < 4; c++)
+				{
+					__m128 column0 = m[0][c];
+					__m128 column1 = m[1][c];
+					__m128 column2 = m[2][c];
+					__m128 column3 = c == 3 ? _mm_set1_ps(1.f) : zero;
+					_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+					_mm_storeu_ps(output[0].raw + c * 4, column0);
+					_mm_storeu_ps(output[1].raw + c * 4, column1);
+					_mm_storeu_ps(output[2].raw + c * 4, column2);
+					_mm_storeu_ps(output[3].raw + c * 4, column3);
+				}
+			}
+
+			void Store(Affine3* output) const
+			{
+				for (int r = 0; r < 3; r++)
+				{
+					__m128 row0 = m[r][0];
+					__m128 row1 = m[r][1];
+					__m128 row2 = m[r][2];
+					__m128 row3 = m[r][3];
+					_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+					_mm_storeu_ps(output[0].raw + r * 4, row0);
+					_mm_storeu_ps(output[1].raw + r * 4, row1);
+					_mm_storeu_ps(output[2].raw + r * 4, row2);
+					_mm_storeu_ps(output[3].raw + r * 4, row3);
+				}
+			}
+
+			__m128 m[3][4];
+		};
+#endif
+
+		template <class Transform>
+		void FromTRSRange(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Transform* output, size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			for (; begin + 4 <= end; begin += 4)
+			{
+				ComposedTRS(translations + begin, rotations + begin, scales + begin).Store(output + begin);
+			}
+#endif
+			for (; begin < end; begin++)
+			{
+				const Affine3 transform = Affine3::FromTRS(translations[begin], rotations[begin], scales[begin]);
+				if constexpr (std::is_same_v<Transform, Matrix4>)
+				{
+					output[begin] = transform.ToMatrix4();
+				}
+				else
+				{
+					output[begin] = transform;
+				}
+			}
+		}
+
+		/**
+		 * @brief Viewport mapping as pixel = ndc * scale + offset, y being flipped.
+		 */
+		struct ViewportMapping
+		{
+			explicit ViewportMapping(const Viewport& viewport) :
+				scaleX(viewport.width * .5f), offsetX(viewport.x + viewport.width * .5f),
+				scaleY(viewport.height * -.5f), offsetY(viewport.y + viewport.height * .5f) {}
+
+			float scaleX;
+			float offsetX;
+			float scaleY;
+			float offsetY;
+		};
+
+		/*
+		* @name Access to the points of an array of Vector3 or of the components of a Vector3SoA
+		*/
+		/*@{*/
+		Vector3 PointAt(const Vector3* points, const size_t index) { return points[index]; }
+		Vector3 PointAt(const float* const (&points)[3], const size_t index) { return Vector3(points[0][index], points[1][index], points[2][index]); }
+
+#if LIBMATH_SSE
+		void LoadPoints(const Vector3* points, const size_t index, __m128& x, __m128& y, __m128& z) { SIMD::LoadVector3x4(&points[index].x, x, y, z); }
+
+		void LoadPoints(const float* const (&points)[3], const size_t index, __m128& x, __m128& y, __m128& z)
+		{
+			x = _mm_loadu_ps(points[0] + index);
+			y = _mm_loadu_ps(points[1] + index);
+			z = _mm_loadu_ps(points[2] + index);
+		}
+#endif
+		/*@}*/
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Project four points, the rejected ones giving (0, 0).
+		 *
+		 * @return Bit i set when point i is in front of the near plane
+		 */
+		uint32_t Project(const BroadcastMatrix& matrix, const __m128 (&mapping)[4], const __m128 x, const __m128 y, const __m128 z, __m128& outX, __m128& outY)
+		{
+			const __m128* m = matrix.m;
+			const __m128 clipX = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[4], y)), _mm_mul_ps(m[8], z)), m[12]);
+			const __m128 clipY = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[1], x), _mm_mul_ps(m[5], y)), _mm_mul_ps(m[9], z)), m[13]);
+			const __m128 clipZ = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[2], x), _mm_mul_ps(m[6], y)), _mm_mul_ps(m[10], z)), m[14]);
+			const __m128 clipW = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[3], x), _mm_mul_ps(m[7], y)), _mm_mul_ps(m[11], z)), m[15]);
+
+			// In front of the near plane: -w <= z, w > 0 also excluding the points in the plane of the eye
+			const __m128 front = _mm_and_ps(_mm_cmpgt_ps(clipW, _mm_setzero_ps()), _mm_cmple_ps(_mm_sub_ps(_mm_setzero_ps(), clipW), clipZ));
+
+			// A true division, the approximate reciprocal breaking down for the tiny and denormal w of points near the eye
+			const __m128 reciprocal = _mm_div_ps(_mm_set1_ps(1.f), clipW);
+
+			outX = _mm_and_ps(front, _mm_add_ps(_mm_mul_ps(_mm_mul_ps(clipX, reciprocal), mapping[0]), mapping[1]));
+			outY = _mm_and_ps(front, _mm_add_ps(_mm_mul_ps(_mm_mul_ps(clipY, reciprocal), mapping[2]), mapping[3]));
+			return static_cast<uint32_t>(_mm_movemask_ps(front));
+		}
+
+		/**
+		 * @brief Interleave four x and four y into four TVector2<float>.
+		 */
+		void StorePixels(float* output, const __m128 x, const __m128 y)
+		{
+			_mm_storeu_ps(output, _mm_unpacklo_ps(x, y));
+			_mm_storeu_ps(output + 4, _mm_unpackhi_ps(x, y));
+		}
+#else
+		bool Project(const float* m, const ViewportMapping& mapping, const Vector3& point, TVector2<float>& output)
+		{
+			const float clipX = m[0] * point.x + m[4] * point.y + m[8] * point.z + m[12];
+			const float clipY = m[1] * point.x + m[5] * point.y + m[9] * point.z + m[13];
+			const float clipZ = m[2] * point.x + m[6] * point.y + m[10] * point.z + m[14];
+			const float clipW = m[3] * point.x + m[7] * point.y + m[11] * point.z + m[15];
+
+			if (clipW <= 0.f || clipZ < -clipW)
+			{
+				output = TVector2<float>();
+				return false;
+			}
+
+			const float reciprocal = 1.f / clipW;
+			output = TVector2<float>(clipX * reciprocal * mapping.scaleX + mapping.offsetX, clipY * reciprocal * mapping.scaleY + mapping.offsetY);
+			return true;
+		}
+#endif
+
+		/**
+		 * @brief Project the points of the mask words [wordBegin, wordEnd).
+		 * The last points of the array are padded to a full group, so every point goes through the same instructions.
+		 */
+		template <class Points>
+		void ProjectWords(const float* m, const ViewportMapping& mapping, const Points& points, TVector2<float>* output, const size_t count,
+			const size_t wordBegin, const size_t wordEnd, uint32_t* outMask)
+		{
+#if LIBMATH_SSE
+			const BroadcastMatrix matrix(m);
+			const __m128 broadcastMapping[4] = { _mm_set1_ps(mapping.scaleX), _mm_set1_ps(mapping.offsetX), _mm_set1_ps(mapping.scaleY), _mm_set1_ps(mapping.offsetY) };
+#endif
+
+			for (size_t word = wordBegin; word < wordEnd; word++)
+			{
+				const size_t begin = word * 32;
+				const size_t end = std::min(count, begin + 32);
+				uint32_t bits = 0;
+
+#if LIBMATH_SSE
+				__m128 x, y, z, pixelX, pixelY;
+				size_t i = begin;
+				for (; i + 4 <= end; i += 4)
+				{
+					LoadPoints(points, i, x, y, z);
+					bits |= Project(matrix, broadcastMapping, x, y, z, pixelX, pixelY) << (i - begin);
+					StorePixels(&output[i].x, pixelX, pixelY);
+				}
+
+				if (i < end)
+				{
+					const size_t remaining = end - i;
+					float paddedX[4] = {};
+					float paddedY[4] = {};
+					float paddedZ[4] = {};
+					for (size_t k = 0; k < remaining; k++)
+					{
+						const Vector3 point = PointAt(points, i + k);
+						paddedX[k] = point.x;
+						paddedY[k] = point.y;
+						paddedZ[k] = point.z;
+					}
+
+					const uint32_t groupBits = Project(matrix, broadcastMapping, _mm_loadu_ps(paddedX), _mm_loadu_ps(paddedY), _mm_loadu_ps(paddedZ), pixelX, pixelY);
+					bits |= (groupBits & ((1u << remaining) - 1u)) << (i - begin);
+
+					float pixels[8];
+					StorePixels(pixels, pixelX, pixelY);
+					for (size_t k = 0; k < remaining; k++)
+					{
+						output[i + k] = TVector2<float>(pixels[k * 2], pixels[k * 2 + 1]);
+					}
+				}
+#else
+				for (size_t i = begin; i < end; i++)
+				{
+					bits |= static_cast<uint32_t>(Project(m, mapping, PointAt(points, i), output[i])) << (i - begin);
+				}
+#endif
+
+				if (outMask != nullptr)
+				{
+					outMask[word] = bits;
+				}
+			}
+		}
+
+		template <class Points>
+		void ProjectBatch(const Matrix4& viewProjection, const Viewport& viewport, const Points& points, TVector2<float>* output, const size_t count, uint32_t* outMask)
+		{
+			const float* m = viewProjection.raw;
+			const ViewportMapping mapping(viewport);
+			Parallel::For(MaskWordCount(count), PARALLEL_PROJECT_WORD_COUNT, [&](const size_t wordBegin, const size_t wordEnd)
+			{
+				ProjectWords(m, mapping, points, output, count, wordBegin, wordEnd, outMask);
+			});
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Request the cache lines of an element, which straddles two lines when it is not aligned.
+		 */
+		template <class T>
+		void Prefetch(const T* element)
+		{
+			_mm_prefetch(reinterpret_cast<const char*>(element), _MM_HINT_T0);
+			_mm_prefetch(reinterpret_cast<const char*>(element + 1) - 1, _MM_HINT_T0);
+		}
+
+		/**
+		 * @brief Products of a range, the left operand being lhs[0] for every element when SharedLeft is set.
+		 */
+		template <class Left, bool SharedLeft, class T>
+		void MultiplyRangeSIMD(const T* lhs, const T* rhs, T* output, const size_t begin, const size_t end)
+		{
+			if constexpr (SharedLeft)
+			{
+				const Left left(lhs->raw);
+				for (size_t i = begin; i < end; i++)
+				{
+					if (i + PREFETCH_DISTANCE < end)
+					{
+						Prefetch(rhs + i + PREFETCH_DISTANCE);
+					}
+					left.Multiply(rhs[i].raw, output[i].raw);
+				}
+			}
+			else
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					if (i + PREFETCH_DISTANCE < end)
+					{
+						Prefetch(lhs + i + PREFETCH_DISTANCE);
+						Prefetch(rhs + i + PREFETCH_DISTANCE);
+					}
+					Left::Product(lhs[i].raw, rhs[i].raw, output[i].raw);
+				}
+			}
+		}
+
+		/**
+		 * @brief Same loops as MultiplyRangeSIMD() compiled for AVX, so the FMA kernel is inlined in them.
+		 */
+		template <bool SharedLeft>
+		LIBMATH_TARGET("avx,fma")
+		void MultiplyRangeFMA(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, const size_t begin, const size_t end)
+		{
+			if constexpr (SharedLeft)
+			{
+				const MatrixKernels::MatrixColumnsFMA left(lhs->raw);
+				for (size_t i = begin; i < end; i++)
+				{
+					if (i + PREFETCH_DISTANCE < end)
+					{
+						Prefetch(rhs + i + PREFETCH_DISTANCE);
+					}
+					left.Multiply(rhs[i].raw, output[i].raw);
+				}
+			}
+			else
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					if (i + PREFETCH_DISTANCE < end)
+					{
+						Prefetch(lhs + i + PREFETCH_DISTANCE);
+						Prefetch(rhs + i + PREFETCH_DISTANCE);
+					}
+					MatrixKernels::MatrixColumnsFMA::Product(lhs[i].raw, rhs[i].raw, output[i].raw);
+				}
+			}
+		}
+#endif
+
+		template <bool SharedLeft, class T>
+		void MultiplyRange(const T* lhs, const T* rhs, T* output, const size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			if constexpr (std::is_same_v<T, Matrix4>)
+			{
+				MultiplyRangeSIMD<MatrixKernels::MatrixColumns, SharedLeft>(lhs, rhs, output, begin, end);
+			}
+			else
+			{
+				MultiplyRangeSIMD<MatrixKernels::AffineRows, SharedLeft>(lhs, rhs, output, begin, end);
+			}
+#else
+			for (size_t i = begin; i < end; i++)
+			{
+				output[i] = (SharedLeft ? *lhs : lhs[i]) * rhs[i];
+			}
+#endif
+		}
+
+		template <bool SharedLeft, class T>
+		void Multiply(const T* lhs, const T* rhs, T* output, const size_t count)
+		{
+			// A shared left operand may be one of the outputs, which another range could overwrite before reading it
+			T sharedLeft;
+			if constexpr (SharedLeft)
+			{
+				sharedLeft = *lhs;
+				lhs = &sharedLeft;
+			}
+
+#if LIBMATH_SSE
+			if constexpr (std::is_same_v<T, Matrix4>)
+			{
+				if (SIMD::HasAVX2() && SIMD::HasFMA())
+				{
+					Parallel::For(count, PARALLEL_MULTIPLY_COUNT, [=](const size_t begin, const size_t end)
+					{
+						MultiplyRangeFMA<SharedLeft>(lhs, rhs, output, begin, end);
+					});
+					return;
+				}
+			}
+#endif
+			Parallel::For(count, PARALLEL_MULTIPLY_COUNT, [=](const size_t begin, const size_t end)
+			{
+				MultiplyRange<SharedLeft>(lhs, rhs, output, begin, end);
+			});
+		}
+	}
+
+	void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* output, const size_t count, const bool perspectiveDivide)
+	{
+		if (perspectiveDivide)
+		{
+			Transform<Mode::PROJECTED_POINT>(matrix, points, output, count);
+		}
+		else
+		{
+			Transform<Mode::POINT>(matrix, points, output, count);
+		}
+	}
+
+	void TransformPoints(const Matrix4& matrix, Vector3* points, const size_t count, const bool perspectiveDivide)
+	{
+		TransformPoints(matrix, points, points, count, perspectiveDivide);
+	}
+
+	void TransformPoints(const Matrix4& matrix, const Vector3SoA& points, Vector3SoA& output, const bool perspectiveDivide)
+	{
+		if (perspectiveDivide)
+		{
+			Transform<Mode::PROJECTED_POINT>(matrix, points, output);
+		}
+		else
+		{
+			Transform<Mode::POINT>(matrix, points, output);
+		}
+	}
+
+	void TransformPoints(const Matrix4& matrix, Vector3SoA& points, const bool perspectiveDivide)
+	{
+		TransformPoints(matrix, points, points, perspectiveDivide);
+	}
+
+	void TransformDirections(const Matrix4& matrix, const Vector3* directions, Vector3* output, const size_t count)
+	{
+		Transform<Mode::DIRECTION>(matrix, directions, output, count);
+	}
+
+	void TransformDirections(const Matrix4& matrix, Vector3* directions, const size_t count)
+	{
+		Transform<Mode::DIRECTION>(matrix, directions, directions, count);
+	}
+
+	void TransformDirections(const Matrix4& matrix, const Vector3SoA& directions, Vector3SoA& output)
+	{
+		Transform<Mode::DIRECTION>(matrix, directions, output);
+	}
+
+	void TransformDirections(const Matrix4& matrix, Vector3SoA& directions)
+	{
+		Transform<Mode::DIRECTION>(matrix, directions, directions);
+	}
+
+	void TransformPoints(const Affine3& transform, const Vector3* points, Vector3* output, const size_t count)
+	{
+		Transform<Mode::POINT>(transform.ToMatrix4(), points, output, count);
+	}
+
+	void TransformPoints(const Affine3& transform, Vector3* points, const size_t count)
+	{
+		Transform<Mode::POINT>(transform.ToMatrix4(), points, points, count);
+	}
+
+	void TransformPoints(const Affine3& transform, const Vector3SoA& points, Vector3SoA& output)
+	{
+		Transform<Mode::POINT>(transform.ToMatrix4(), points, output);
+	}
+
+	void TransformPoints(const Affine3& transform, Vector3SoA& points)
+	{
+		Transform<Mode::POINT>(transform.ToMatrix4(), points, points);
+	}
+
+	void TransformDirections(const Affine3& transform, const Vector3* directions, Vector3* output, const size_t count)
+	{
+		Transform<Mode::DIRECTION>(transform.ToMatrix4(), directions, output, count);
+	}
+
+	void TransformDirections(const Affine3& transform, Vector3* directions, const size_t count)
+	{
+		Transform<Mode::DIRECTION>(transform.ToMatrix4(), directions, directions, count);
+	}
+
+	void TransformDirections(const Affine3& transform, const Vector3SoA& directions, Vector3SoA& output)
+	{
+		Transform<Mode::DIRECTION>(transform.ToMatrix4(), directions, output);
+	}
+
+	void TransformDirections(const Affine3& transform, Vector3SoA& directions)
+	{
+		Transform<Mode::DIRECTION>(transform.ToMatrix4(), directions, directions);
+	}
+
+	void TransformVector4(const Matrix4& matrix, const Vector4* vectors, Vector4* output, const size_t count)
+	{
+		const float* m = matrix.raw;
+		Parallel::For(count, PARALLEL_TRANSFORM_COUNT, [m, vectors, output](size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			const __m128 column0 = _mm_loadu_ps(m);
+			const __m128 column1 = _mm_loadu_ps(m + 4);
+			const __m128 column2 = _mm_loadu_ps(m + 8);
+			const __m128 column3 = _mm_loadu_ps(m + 12);
+
+			for (; begin < end; begin++)
+			{
+				const __m128 vector = _mm_loadu_ps(&vectors[begin].x);
+				__m128 result = _mm_mul_ps(column0, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)));
+				result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1))));
+				result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2))));
+				result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3))));
+				_mm_storeu_ps(&output[begin].x, result);
+			}
+#else
+			for (; begin < end; begin++)
+			{
+				const Vector4 vector = vectors[begin];
+				output[begin] = Vector4(m[0] * vector.x + m[4] * vector.y + m[8] * vector.z + m[12] * vector.w,
+					m[1] * vector.x + m[5] * vector.y + m[9] * vector.z + m[13] * vector.w,
+					m[2] * vector.x + m[6] * vector.y + m[10] * vector.z + m[14] * vector.w,
+					m[3] * vector.x + m[7] * vector.y + m[11] * vector.z + m[15] * vector.w);
+			}
+#endif
+		});
+	}
+
+	void TransformVector4(const Matrix4& matrix, Vector4* vectors, const size_t count)
+	{
+		TransformVector4(matrix, vectors, vectors, count);
+	}
+
+	void Inverse(const Matrix4* matrices, Matrix4* output, const size_t count, float* outDeterminants)
+	{
+		Parallel::For(count, PARALLEL_INVERSE_COUNT, [matrices, output, outDeterminants](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				float determinant;
+				output[i] = matrices[i].GetInverse(determinant);
+				if (outDeterminants != nullptr)
+				{
+					outDeterminants[i] = determinant;
+				}
+			}
+		});
+	}
+
+	void InverseRigid(const Matrix4* matrices, Matrix4* output, const size_t count)
+	{
+		Parallel::For(count, PARALLEL_INVERSE_COUNT, [matrices, output](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				output[i] = matrices[i].GetInverseRigid();
+			}
+		});
+	}
+
+	void InverseAffine(const Matrix4* matrices, Matrix4* output, const size_t count)
+	{
+		Parallel::For(count, PARALLEL_INVERSE_COUNT, [matrices, output](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				output[i] = matrices[i].GetInverseAffine();
+			}
+		});
+	}
+
+	void Decompose(const Matrix4* matrices, Vector3* outTranslations, Quaternion* outRotations, Vector3* outScales, const size_t count)
+	{
+		Parallel::For(count, PARALLEL_DECOMPOSE_COUNT, [=](const size_t begin, const size_t end)
+		{
+			DecomposeRange(matrices, outTranslations, outRotations, outScales, begin, end);
+		});
+	}
+
+	void FromTRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* output, const size_t count)
+	{
+		Parallel::For(count, PARALLEL_COMPOSE_COUNT, [=](const size_t begin, const size_t end)
+		{
+			FromTRSRange(translations, rotations, scales, output, begin, end);
+		});
+	}
+
+	void FromTRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Affine3* output, const size_t count)
+	{
+		Parallel::For(count, PARALLEL_COMPOSE_COUNT, [=](const size_t begin, const size_t end)
+		{
+			FromTRSRange(translations, rotations, scales, output, begin, end);
+		});
+	}
+
+	void Multiply(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, const size_t count)
+	{
+		Multiply<false>(lhs, rhs, output, count);
+	}
+
+	void Multiply(const Matrix4& lhs, const Matrix4* rhs, Matrix4* output, const size_t count)
+	{
+		Multiply<true>(&lhs, rhs, output, count);
+	}
+
+	void Multiply(const Affine3* lhs, const Affine3* rhs, Affine3* output, const size_t count)
+	{
+		Multiply<false>(lhs, rhs, output, count);
+	}
+
+	void Multiply(const Affine3& lhs, const Affine3* rhs, Affine3* output, const size_t count)
+	{
+		Multiply<true>(&lhs, rhs, output, count);
+	}
+
+	void ProjectPoints(const Matrix4& viewProjection, const Viewport& viewport, const Vector3* points, TVector2<float>* output, const size_t count, uint32_t* outMask)
+	{
+		ProjectBatch(viewProjection, viewport, points, output, count, outMask);
+	}
+
+	void ProjectPoints(const Matrix4& viewProjection, const Viewport& viewport, const Vector3SoA& points, TVector2<float>* output, uint32_t* outMask)
+	{
+		const float* const components[3] = { points.X(), points.Y(), points.Z() };
+		ProjectBatch(viewProjection, viewport, components, output, points.Size(), outMask);
+	}
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LibMath
+{
+	struct Affine3;
+	struct Matrix4;
+	struct Quaternion;
+	struct Vector3;
+	struct Vector4;
+	class Vector3SoA;
+
+	template <typename T>
+	struct TVector2;
+
+	/**
+	 * @brief Kernels applying one matrix to contiguous arrays of vectors, four vectors per SSE instruction.
+	 * Large arrays are processed in parallel. Input and output arrays may be the same array but must not
+	 * partially overlap. Results match Matrix4 * Vector4 with w set to 1 for points and 0 for directions.
+	 */
+	namespace MatrixBatch
+	{
+		/**
+		 * @brief Pixel rectangle points are projected into, y growing downward from its top left corner like window coordinates.
+		 */
+		struct Viewport
+		{
+			float x = 0.f;/**< left edge in pixels*/
+			float y = 0.f;/**< top edge in pixels*/
+			float width = 0.f;/**< width in pixels*/
+			float height = 0.f;/**< height in pixels*/
+		};
+
+		/**
+		 * @brief Transform an array of points, w being 1.
+		 *
+		 * @param matrix Transformation applied
+		 * @param points Array of points
+		 * @param output Array receiving the transformed points, can be points
+		 * @param count Number of points in both arrays
+		 * @param perspectiveDivide True to divide the result by its w, for projection matrices
+		 */
+		void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* output, size_t count, bool perspectiveDivide = false);
+		void TransformPoints(const Matrix4& matrix, Vector3* points, size_t count, bool perspectiveDivide = false);
+
+		/**
+		 * @brief Transform the points of a Vector3SoA, w being 1.
+		 *
+		 * @param matrix Transformation applied
+		 * @param points Points to transform
+		 * @param output Receives the transformed points, resized to the size of points. Can be points
+		 * @param perspectiveDivide True to divide the result by its w, for projection matrices
+		 */
+		void TransformPoints(const Matrix4& matrix, const Vector3SoA& points, Vector3SoA& output, bool perspectiveDivide = false);
+		void TransformPoints(const Matrix4& matrix, Vector3SoA& points, bool perspectiveDivide = false);
+
+		/*
+		* @name Same transformations for an Affine3, which never needs a perspective divide
+		*/
+		/*@{*/
+		void TransformPoints(const Affine3& transform, const Vector3* points, Vector3* output, size_t count);
+		void TransformPoints(const Affine3& transform, Vector3* points, size_t count);
+		void TransformPoints(const Affine3& transform, const Vector3SoA& points, Vector3SoA& output);
+		void TransformPoints(const Affine3& transform, Vector3SoA& points);
+		void TransformDirections(const Affine3& transform, const Vector3* directions, Vector3* output, size_t count);
+		void TransformDirections(const Affine3& transform, Vector3* directions, size_t count);
+		void TransformDirections(const Affine3& transform, const Vector3SoA& directions, Vector3SoA& output);
+		void TransformDirections(const Affine3& transform, Vector3SoA& directions);
+		/*@}*/
+
+		/**
+		 * @brief Transform an array of directions, w being 0: the translation of the matrix is ignored.
+		 *
+		 * @param matrix Transformation applied
+		 * @param directions Array of directions
+		 * @param output Array receiving the transformed directions, can be directions
+		 * @param count Number of directions in both arrays
+		 */
+		void TransformDirections(const Matrix4& matrix, const Vector3* directions, Vector3* output, size_t count);
+		void TransformDirections(const Matrix4& matrix, Vector3* directions, size_t count);
+
+		/**
+		 * @brief Transform the directions of a Vector3SoA, w being 0: the translation of the matrix is ignored.
+		 *
+		 * @param matrix Transformation applied
+		 * @param directions Directions to transform
+		 * @param output Receives the transformed directions, resized to the size of directions. Can be directions
+		 */
+		void TransformDirections(const Matrix4& matrix, const Vector3SoA& directions, Vector3SoA& output);
+		void TransformDirections(const Matrix4& matrix, Vector3SoA& directions);
+
+		/**
+		 * @brief Transform an array of Vector4, same as matrix * vector for each of them.
+		 *
+		 * @param matrix Transformation applied
+		 * @param vectors Array of Vector4
+		 * @param output Array receiving the transformed Vector4, can be vectors
+		 * @param count Number of Vector4 in both arrays
+		 */
+		void TransformVector4(const Matrix4& matrix, const Vector4* vectors, Vector4* output, size_t count);
+		void TransformVector4(const Matrix4& matrix, Vector4* vectors, size_t count);
+
+		/**
+		 * @brief Invert an array of matrices, singular ones giving a zero matrix.
+		 *
+		 * @param matrices Array of matrices
+		 * @param output Array receiving the inverses, can be matrices
+		 * @param count Number of matrices in both arrays
+		 * @param outDeterminants Optional, array receiving the determinant of each matrix, 0 for the singular ones
+		 * @see Matrix4::GetInverse()
+		 */
+		void Inverse(const Matrix4* matrices, Matrix4* output, size_t count, float* outDeterminants = nullptr);
+
+		/**
+		 * @brief Invert an array of rotation and translation matrices.
+		 *
+		 * @param matrices Array of matrices without scale
+		 * @param output Array receiving the inverses, can be matrices
+		 * @param count Number of matrices in both arrays
+		 * @see Matrix4::GetInverseRigid()
+		 */
+		void InverseRigid(const Matrix4* matrices, Matrix4* output, size_t count);
+
+		/**
+		 * @brief Invert an array of affine matrices, singular ones giving a zero matrix.
+		 *
+		 * @param matrices Array of matrices whose last row is (0, 0, 0, 1)
+		 * @param output Array receiving the inverses, can be matrices
+		 * @param count Number of matrices in both arrays
+		 * @see Matrix4::GetInverseAffine()
+		 */
+		void InverseAffine(const Matrix4* matrices, Matrix4* output, size_t count);
+
+		/**
+		 * @brief Multiply two arrays of matrices element by element, output[i] = lhs[i] * rhs[i].
+		 * Matrices are prefetched a few elements ahead, results match Matrix4::operator*.
+		 *
+		 * @param lhs Array of left operands, the bind poses or the parent transformations
+		 * @param rhs Array of right operands
+		 * @param output Array receiving the products, can be lhs or rhs
+		 * @param count Number of matrices in every array
+		 */
+		void Multiply(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, size_t count);
+
+		/**
+		 * @brief Multiply one matrix by an array of matrices, output[i] = lhs * rhs[i], the columns of lhs staying in registers.
+		 *
+		 * @param lhs Left operand shared by every product, a view matrix for instance
+		 * @param rhs Array of right operands, model matrices for instance
+		 * @param output Array receiving the products, can be rhs. lhs can be one of its elements, it is copied first
+		 * @param count Number of matrices in both arrays
+		 */
+		void Multiply(const Matrix4& lhs, const Matrix4* rhs, Matrix4* output, size_t count);
+
+		/*
+		* @name Same products for Affine3, results matching Affine3::operator*
+		*/
+		/*@{*/
+		void Multiply(const Affine3* lhs, const Affine3* rhs, Affine3* output, size_t count);
+		void Multiply(const Affine3& lhs, const Affine3* rhs, Affine3* output, size_t count);
+		/*@}*/
+
+		/**
+		 * @brief Project points to pixels: clip-space transform, perspective divide and viewport mapping in one pass, four points per SSE instruction.
+		 * The perspective divide is a true division, accurate even for w close to 0. Points behind the near plane (OpenGL clip space, see
+		 * Matrix4::Perspective()) are rejected: their bit of outMask is cleared and their output is (0, 0). Points beside the
+		 * viewport are kept, their coordinates falling outside it.
+		 *
+		 * @param viewProjection Projection * View matrix, built with Matrix4::Perspective() and Matrix4::LookAt() for instance
+		 * @param viewport Rectangle the normalized device coordinates are mapped to
+		 * @param points Array of world positions
+		 * @param output Array receiving the pixel coordinates
+		 * @param count Number of points in both arrays
+		 * @param outMask Optional, array of MaskWordCount(count) words (Core/BitMask.h), bit (i % 32) of word (i / 32) set when point i is in front of the near plane
+		 */
+		void ProjectPoints(const Matrix4& viewProjection, const Viewport& viewport, const Vector3* points, TVector2<float>* output, size_t count, uint32_t* outMask = nullptr);
+		void ProjectPoints(const Matrix4& viewProjection, const Viewport& viewport, const Vector3SoA& points, TVector2<float>* output, uint32_t* outMask = nullptr);
+
+		/**
+		 * @brief Split an array of affine matrices in translation, rotation and scale, four matrices per SSE instruction.
+		 *
+		 * @param matrices Array of matrices
+		 * @param outTranslations Array receiving the translations
+		 * @param outRotations Array receiving the rotations, the identity for matrices with a zero scale
+		 * @param outScales Array receiving the scales
+		 * @param count Number of elements in every array
+		 * @see Matrix4::Decompose()
+		 */
+		void Decompose(const Matrix4* matrices, Vector3* outTranslations, Quaternion* outRotations, Vector3* outScales, size_t count);
+
+		/**
+		 * @brief Build an array of Translation * Rotation * Scaling matrices, four per SSE instruction.
+		 *
+		 * @param translations Array of translations
+		 * @param rotations Array of rotations, not necessarily normalized
+		 * @param scales Array of scales
+		 * @param output Array receiving the matrices
+		 * @param count Number of elements in every array
+		 * @see Matrix4::FromTRS()
+		 */
+		void FromTRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* output, size_t count);
+
+		/**
+		 * @brief Build an array of Translation * Rotation * Scaling transformations, four per SSE instruction.
+		 *
+		 * @param translations Array of translations
+		 * @param rotations Array of rotations, not necessarily normalized
+		 * @param scales Array of scales
+		 * @param output Array receiving the transformations
+		 * @param count Number of elements in every array
+		 * @see Affine3::FromTRS()
+		 */
+		void FromTRS(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Affine3* output, size_t count);
+	}
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Core/SIMD.h"
+
+namespace LibMath
+{
+	/**
+	 * @brief Product kernels shared by Matrix4, Affine3, MatrixBatch and TMatrix, so the batched products give the same
+	 * floats as the operators. Internal header, only included by the library and its header-only templates.
+	 * Every kernel reads its inputs before writing an output column or row, so output may alias lhs or rhs.
+	 */
+	namespace MatrixKernels
+	{
+#if LIBMATH_SSE
+		/**
+		 * @brief Columns of the left operand of a column-major Matrix4 product, column c of the output being
+		 * the columns weighted by column c of the right operand.
+		 */
+		struct MatrixColumns
+		{
+			explicit MatrixColumns(const float* m)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					columns[c] = _mm_loadu_ps(m + c * 4);
+				}
+			}
+
+			static void Product(const float* lhs, const float* rhs, float* output) { MatrixColumns(lhs).Multiply(rhs, output); }
+
+			void Multiply(const float* rhs, float* output) const
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					const __m128 weights = _mm_loadu_ps(rhs + c * 4);
+					__m128 result = _mm_mul_ps(columns[0], _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(0, 0, 0, 0)));
+					result = _mm_add_ps(result, _mm_mul_ps(columns[1], _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(1, 1, 1, 1))));
+					result = _mm_add_ps(result, _mm_mul_ps(columns[2], _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(2, 2, 2, 2))));
+					result = _mm_add_ps(result, _mm_mul_ps(columns[3], _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(3, 3, 3, 3))));
+					_mm_storeu_ps(output + c * 4, result);
+				}
+			}
+
+			__m128 columns[4];
+		};
+
+		/**
+		 * @brief Same product with the columns duplicated in both 128 bits lanes, two output columns per iteration.
+		 * Only usable after checking SIMD::HasAVX2() and SIMD::HasFMA().
+		 */
+		struct MatrixColumnsFMA
+		{
+			LIBMATH_TARGET("avx,fma")
+			explicit MatrixColumnsFMA(const float* m)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					columns[c] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + c * 4));
+				}
+			}
+
+			LIBMATH_TARGET("avx,fma")
+			static void Product(const float* lhs, const float* rhs, float* output) { MatrixColumnsFMA(lhs).Multiply(rhs, output); }
+
+			LIBMATH_TARGET("avx,fma")
+			void Multiply(const float* rhs, float* output) const
+			{
+				for (int c = 0; c < 4; c += 2)
+				{
+					const __m256 weights = _mm256_loadu_ps(rhs + c * 4);
+					__m256 result = _mm256_mul_ps(columns[0], _mm256_permute_ps(weights, _MM_SHUFFLE(0, 0, 0, 0)));
+					result = _mm256_fmadd_ps(columns[1], _mm256_permute_ps(weights, _MM_SHUFFLE(1, 1, 1, 1)), result);
+					result = _mm256_fmadd_ps(columns[2], _mm256_permute_ps(weights, _MM_SHUFFLE(2, 2, 2, 2)), result);
+					result = _mm256_fmadd_ps(columns[3], _mm256_permute_ps(weights, _MM_SHUFFLE(3, 3, 3, 3)), result);
+					_mm256_storeu_ps(output + c * 4, result);
+				}
+			}
+
+			__m256 columns[4];
+		};
+
+		/**
+		 * @brief Rows of the left operand of a row-major Affine3 product broadcast once, for a left operand reused
+		 * by many products. The implicit (0, 0, 0, 1) last rows add the translation of the left operand.
+		 */
+		struct AffineRows
+		{
+			explicit AffineRows(const float* m)
+			{
+				for (int r = 0; r < 3; r++)
+				{
+					const __m128 row = _mm_loadu_ps(m + r * 4);
+					weights[r][0] = _mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0));
+					weights[r][1] = _mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1));
+					weights[r][2] = _mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2));
+					translations[r] = _mm_and_ps(row, _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0)));
+				}
+			}
+
+			/**
+			 * @brief Single product broadcasting the rows of lhs on the fly, cheaper when lhs is not reused.
+			 */
+			static void Product(const float* lhs, const float* rhs, float* output)
+			{
+				const __m128 row0 = _mm_loadu_ps(rhs);
+				const __m128 row1 = _mm_loadu_ps(rhs + 4);
+				const __m128 row2 = _mm_loadu_ps(rhs + 8);
+				const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+				__m128 results[3];
+				for (int r = 0; r < 3; r++)
+				{
+					const __m128 left = _mm_loadu_ps(lhs + r * 4);
+					__m128 result = _mm_mul_ps(row0, _mm_shuffle_ps(left, left, _MM_SHUFFLE(0, 0, 0, 0)));
+					result = _mm_add_ps(result, _mm_mul_ps(row1, _mm_shuffle_ps(left, left, _MM_SHUFFLE(1, 1, 1, 1))));
+					result = _mm_add_ps(result, _mm_mul_ps(row2, _mm_shuffle_ps(left, left, _MM_SHUFFLE(2, 2, 2, 2))));
+					results[r] = _mm_add_ps(result, _mm_and_ps(left, translationMask));
+				}
+
+				for (int r = 0; r < 3; r++)
+				{
+					_mm_storeu_ps(output + r * 4, results[r]);
+				}
+			}
+
+			void Multiply(const float* rhs, float* output) const
+			{
+				const __m128 row0 = _mm_loadu_ps(rhs);
+				const __m128 row1 = _mm_loadu_ps(rhs + 4);
+				const __m128 row2 = _mm_loadu_ps(rhs + 8);
+
+				for (int r = 0; r < 3; r++)
+				{
+					__m128 result = _mm_mul_ps(row0, weights[r][0]);
+					result = _mm_add_ps(result, _mm_mul_ps(row1, weights[r][1]));
+					result = _mm_add_ps(result, _mm_mul_ps(row2, weights[r][2]));
+					_mm_storeu_ps(output + r * 4, _mm_add_ps(result, translations[r]));
+				}
+			}
+
+			__m128 weights[3][3];
+			__m128 translations[3];
+		};
+#else
+		inline void MultiplyScalar(const float* lhs, const float* rhs, float* output)
+		{
+			float left[16];
+			for (int i = 0; i < 16; i++)
+			{
+				left[i] = lhs[i];
+			}
+
+			for (int c = 0; c < 4; c++)
+			{
+				const float weights[4] = { rhs[c * 4], rhs[c * 4 + 1], rhs[c * 4 + 2], rhs[c * 4 + 3] };
+				for (int r = 0; r < 4; r++)
+				{
+					output[c * 4 + r] = left[r] * weights[0] + left[4 + r] * weights[1] + left[8 + r] * weights[2] + left[12 + r] * weights[3];
+				}
+			}
+		}
+
+		inline void ComposeScalar(const float* lhs, const float* rhs, float* output)
+		{
+			float left[12];
+			float right[12];
+			for (int i = 0; i < 12; i++)
+			{
+				left[i] = lhs[i];
+				right[i] = rhs[i];
+			}
+
+			for (int r = 0; r < 3; r++)
+			{
+				const float* weights = left + r * 4;
+				for (int c = 0; c < 4; c++)
+				{
+					output[r * 4 + c] = right[c] * weights[0] + right[4 + c] * weights[1] + right[8 + c] * weights[2];
+				}
+				output[r * 4 + 3] += weights[3];
+			}
+		}
+#endif
+
+		/**
+		 * @brief Row-major 3x4 product of two Affine3, the implicit (0, 0, 0, 1) last rows adding the translation of lhs.
+		 */
+		inline void Compose(const float* lhs, const float* rhs, float* output)
+		{
+#if LIBMATH_SSE
+			AffineRows::Product(lhs, rhs, output);
+#else
+			ComposeScalar(lhs, rhs, output);
+#endif
+		}
+	}
+}
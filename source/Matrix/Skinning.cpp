@@ -0,0 +1,339 @@
+#include "Skinning.h"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+#include "Matrix/Affine3.h"
+#include "Matrix/Matrix4.h"
+#include "Vector/Vector3SoA.h"
+
+namespace LibMath::Skinning
+{
+	namespace
+	{
+		/**
+		 * @brief Vertices skinned by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_SKIN_COUNT = 1 << 11;
+
+		float WeightValue(const float weight) { return weight; }
+		float WeightValue(const uint8_t weight) { return static_cast<float>(weight) * (1.f / 255.f); }
+
+		/**
+		 * @brief Component arrays read and written by the kernels, the normal ones being null when only positions are skinned.
+		 */
+		struct Streams
+		{
+			const float* positionX = nullptr;
+			const float* positionY = nullptr;
+			const float* positionZ = nullptr;
+			const float* normalX = nullptr;
+			const float* normalY = nullptr;
+			const float* normalZ = nullptr;
+			float* outPositionX = nullptr;
+			float* outPositionY = nullptr;
+			float* outPositionZ = nullptr;
+			float* outNormalX = nullptr;
+			float* outNormalY = nullptr;
+			float* outNormalZ = nullptr;
+		};
+
+		/**
+		 * @brief Weighted sum of the palette transformations of a vertex, in influence order like the SSE kernel.
+		 */
+		template <class TWeight>
+		void BlendScalar(const TSkinInfluences<TWeight>& influences, const Affine3* palette, const size_t vertex, float* blended)
+		{
+			const uint16_t* boneIndices = influences.boneIndices + vertex * influences.influenceCount;
+			const TWeight* weights = influences.weights + vertex * influences.influenceCount;
+
+			const float* bone = palette[boneIndices[0]].raw;
+			const float firstWeight = WeightValue(weights[0]);
+			for (int i = 0; i < 12; i++)
+			{
+				blended[i] = firstWeight * bone[i];
+			}
+
+			for (size_t influence = 1; influence < influences.influenceCount; influence++)
+			{
+				bone = palette[boneIndices[influence]].raw;
+				const float weight = WeightValue(weights[influence]);
+				for (int i = 0; i < 12; i++)
+				{
+					blended[i] += weight * bone[i];
+				}
+			}
+		}
+
+		/**
+		 * @brief Multiply a normal by the cofactor matrix of the 3x3 part of an affine transformation, row-major like Affine3.
+		 * The cofactor matrix is the inverse transpose scaled by the determinant, so normals stay perpendicular to the surface
+		 * under non-uniform scale and shear without inverting anything. The normalization removes the magnitude of the
+		 * determinant, its sign is removed here so mirroring transformations do not flip the normals.
+		 */
+		void TransformNormalScalar(const float* m, const float x, const float y, const float z, float& outX, float& outY, float& outZ)
+		{
+			const auto e = [m](const int r, const int c) { return m[r * 4 + c]; };
+
+			const float cofactor00 = e(1, 1) * e(2, 2) - e(2, 1) * e(1, 2);
+			const float cofactor10 = e(2, 1) * e(0, 2) - e(0, 1) * e(2, 2);
+			const float cofactor20 = e(0, 1) * e(1, 2) - e(1, 1) * e(0, 2);
+			const float cofactor01 = e(1, 2) * e(2, 0) - e(2, 2) * e(1, 0);
+			const float cofactor11 = e(2, 2) * e(0, 0) - e(0, 2) * e(2, 0);
+			const float cofactor21 = e(0, 2) * e(1, 0) - e(1, 2) * e(0, 0);
+			const float cofactor02 = e(1, 0) * e(2, 1) - e(2, 0) * e(1, 1);
+			const float cofactor12 = e(2, 0) * e(0, 1) - e(0, 0) * e(2, 1);
+			const float cofactor22 = e(0, 0) * e(1, 1) - e(1, 0) * e(0, 1);
+
+			const float determinant = e(0, 0) * cofactor00 + e(0, 1) * cofactor01 + e(0, 2) * cofactor02;
+			const float sign = std::signbit(determinant) ? -1.f : 1.f;
+
+			outX = (cofactor00 * x + cofactor01 * y + cofactor02 * z) * sign;
+			outY = (cofactor10 * x + cofactor11 * y + cofactor12 * z) * sign;
+			outZ = (cofactor20 * x + cofactor21 * y + cofactor22 * z) * sign;
+		}
+
+		template <class TWeight>
+		void SkinScalar(const TSkinInfluences<TWeight>& influences, const Affine3* palette, const Streams& streams, const size_t vertex)
+		{
+			float m[12];
+			BlendScalar(influences, palette, vertex, m);
+
+			const float x = streams.positionX[vertex];
+			const float y = streams.positionY[vertex];
+			const float z = streams.positionZ[vertex];
+			streams.outPositionX[vertex] = m[0] * x + m[1] * y + m[2] * z + m[3];
+			streams.outPositionY[vertex] = m[4] * x + m[5] * y + m[6] * z + m[7];
+			streams.outPositionZ[vertex] = m[8] * x + m[9] * y + m[10] * z + m[11];
+
+			if (streams.normalX != nullptr)
+			{
+				const float normalX = streams.normalX[vertex];
+				const float normalY = streams.normalY[vertex];
+				const float normalZ = streams.normalZ[vertex];
+				float skinnedX, skinnedY, skinnedZ;
+				TransformNormalScalar(m, normalX, normalY, normalZ, skinnedX, skinnedY, skinnedZ);
+
+				const float length = std::sqrt(skinnedX * skinnedX + skinnedY * skinnedY + skinnedZ * skinnedZ);
+				const float inverseLength = length > 0.f ? 1.f / length : 0.f;
+				streams.outNormalX[vertex] = skinnedX * inverseLength;
+				streams.outNormalY[vertex] = skinnedY * inverseLength;
+				streams.outNormalZ[vertex] = skinnedZ * inverseLength;
+			}
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Weighted sum of the palette transformations of a vertex, one register per row.
+		 */
+		template <class TWeight>
+		void BlendSSE(const TSkinInfluences<TWeight>& influences, const Affine3* palette, const size_t vertex, __m128& row0, __m128& row1, __m128& row2)
+		{
+			const uint16_t* boneIndices = influences.boneIndices + vertex * influences.influenceCount;
+			const TWeight* weights = influences.weights + vertex * influences.influenceCount;
+
+			const float* bone = palette[boneIndices[0]].raw;
+			__m128 weight = _mm_set1_ps(WeightValue(weights[0]));
+			row0 = _mm_mul_ps(weight, _mm_loadu_ps(bone));
+			row1 = _mm_mul_ps(weight, _mm_loadu_ps(bone + 4));
+			row2 = _mm_mul_ps(weight, _mm_loadu_ps(bone + 8));
+
+			for (size_t influence = 1; influence < influences.influenceCount; influence++)
+			{
+				bone = palette[boneIndices[influence]].raw;
+				weight = _mm_set1_ps(WeightValue(weights[influence]));
+				row0 = _mm_add_ps(row0, _mm_mul_ps(weight, _mm_loadu_ps(bone)));
+				row1 = _mm_add_ps(row1, _mm_mul_ps(weight, _mm_loadu_ps(bone + 4)));
+				row2 = _mm_add_ps(row2, _mm_mul_ps(weight, _mm_loadu_ps(bone + 8)));
+			}
+		}
+
+		/**
+		 * @brief x * m[0] + y * m[1] + z * m[2] lane by lane, each lane being a vertex.
+		 */
+		__m128 Dot3(const __m128* m, const __m128 x, const __m128 y, const __m128 z)
+		{
+			__m128 result = _mm_mul_ps(m[0], x);
+			result = _mm_add_ps(result, _mm_mul_ps(m[1], y));
+			return _mm_add_ps(result, _mm_mul_ps(m[2], z));
+		}
+
+		/**
+		 * @brief Same as TransformNormalScalar() for four vertices, m[r][c] holding the coefficient (r, c) of each of them.
+		 */
+		void TransformNormalSSE(const __m128 (&m)[3][4], const __m128 x, const __m128 y, const __m128 z, __m128& outX, __m128& outY, __m128& outZ)
+		{
+			const auto difference = [](const __m128 a, const __m128 b, const __m128 c, const __m128 d) { return _mm_sub_ps(_mm_mul_ps(a, b), _mm_mul_ps(c, d)); };
+
+			const __m128 cofactor00 = difference(m[1][1], m[2][2], m[2][1], m[1][2]);
+			const __m128 cofactor10 = difference(m[2][1], m[0][2], m[0][1], m[2][2]);
+			const __m128 cofactor20 = difference(m[0][1], m[1][2], m[1][1], m[0][2]);
+			const __m128 cofactor01 = difference(m[1][2], m[2][0], m[2][2], m[1][0]);
+			const __m128 cofactor11 = difference(m[2][2], m[0][0], m[0][2], m[2][0]);
+			const __m128 cofactor21 = difference(m[0][2], m[1][0], m[1][2], m[0][0]);
+			const __m128 cofactor02 = difference(m[1][0], m[2][1], m[2][0], m[1][1]);
+			const __m128 cofactor12 = difference(m[2][0], m[0][1], m[0][0], m[2][1]);
+			const __m128 cofactor22 = difference(m[0][0], m[1][1], m[1][0], m[0][1]);
+
+			const __m128 determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][0], cofactor00), _mm_mul_ps(m[0][1], cofactor01)), _mm_mul_ps(m[0][2], cofactor02));
+			const __m128 sign = _mm_and_ps(determinant, _mm_set1_ps(-0.f));
+
+			outX = _mm_xor_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cofactor00, x), _mm_mul_ps(cofactor01, y)), _mm_mul_ps(cofactor02, z)), sign);
+			outY = _mm_xor_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cofactor10, x), _mm_mul_ps(cofactor11, y)), _mm_mul_ps(cofactor12, z)), sign);
+			outZ = _mm_xor_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cofactor20, x), _mm_mul_ps(cofactor21, y)), _mm_mul_ps(cofactor22, z)), sign);
+		}
+#endif
+
+		template <class TWeight>
+		void SkinRange(const TSkinInfluences<TWeight>& influences, const Affine3* palette, const Streams& streams, size_t begin, const size_t end)
+		{
+#if LIBMATH_SSE
+			for (; begin + 4 <= end; begin += 4)
+			{
+				// m[r][c] holds the coefficient (r, c) of the four blended transformations once transposed
+				__m128 m[3][4];
+				BlendSSE(influences, palette, begin, m[0][0], m[1][0], m[2][0]);
+				BlendSSE(influences, palette, begin + 1, m[0][1], m[1][1], m[2][1]);
+				BlendSSE(influences, palette, begin + 2, m[0][2], m[1][2], m[2][2]);
+				BlendSSE(influences, palette, begin + 3, m[0][3], m[1][3], m[2][3]);
+				for (int r = 0; r < 3; r++)
+				{
+					_MM_TRANSPOSE4_PS(m[r][0], m[r][1], m[r][2], m[r][3]);
+				}
+
+				const __m128 x = _mm_loadu_ps(streams.positionX + begin);
+				const __m128 y = _mm_loadu_ps(streams.positionY + begin);
+				const __m128 z = _mm_loadu_ps(streams.positionZ + begin);
+				_mm_storeu_ps(streams.outPositionX + begin, _mm_add_ps(Dot3(m[0], x, y, z), m[0][3]));
+				_mm_storeu_ps(streams.outPositionY + begin, _mm_add_ps(Dot3(m[1], x, y, z), m[1][3]));
+				_mm_storeu_ps(streams.outPositionZ + begin, _mm_add_ps(Dot3(m[2], x, y, z), m[2][3]));
+
+				if (streams.normalX != nullptr)
+				{
+					const __m128 normalX = _mm_loadu_ps(streams.normalX + begin);
+					const __m128 normalY = _mm_loadu_ps(streams.normalY + begin);
+					const __m128 normalZ = _mm_loadu_ps(streams.normalZ + begin);
+					__m128 skinnedX, skinnedY, skinnedZ;
+					TransformNormalSSE(m, normalX, normalY, normalZ, skinnedX, skinnedY, skinnedZ);
+
+					__m128 squaredLength = _mm_mul_ps(skinnedX, skinnedX);
+					squaredLength = _mm_add_ps(squaredLength, _mm_mul_ps(skinnedY, skinnedY));
+					squaredLength = _mm_add_ps(squaredLength, _mm_mul_ps(skinnedZ, skinnedZ));
+					const __m128 length = _mm_sqrt_ps(squaredLength);
+					const __m128 inverseLength = _mm_and_ps(_mm_cmpgt_ps(length, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(1.f), length));
+
+					_mm_storeu_ps(streams.outNormalX + begin, _mm_mul_ps(skinnedX, inverseLength));
+					_mm_storeu_ps(streams.outNormalY + begin, _mm_mul_ps(skinnedY, inverseLength));
+					_mm_storeu_ps(streams.outNormalZ + begin, _mm_mul_ps(skinnedZ, inverseLength));
+				}
+			}
+#endif
+			for (; begin < end; begin++)
+			{
+				SkinScalar(influences, palette, streams, begin);
+			}
+		}
+
+		template <class TWeight>
+		bool Skin(const TSkinInfluences<TWeight>& influences, const Affine3* palette, const size_t paletteSize, const Vector3SoA& positions,
+			const Vector3SoA* normals, Vector3SoA& outPositions, Vector3SoA* outNormals)
+		{
+			// The kernels read the first influence of every vertex before looping over the others
+			if (influences.influenceCount == 0) return false;
+
+			const size_t count = positions.Size();
+			for (size_t i = 0; i < count * influences.influenceCount; i++)
+			{
+				assert(influences.boneIndices[i] < paletteSize && "bone index out of the palette");
+			}
+			assert((normals == nullptr || normals->Size() == count) && "one normal per position");
+
+			outPositions.Resize(count);
+			Streams streams;
+			streams.positionX = positions.X();
+			streams.positionY = positions.Y();
+			streams.positionZ = positions.Z();
+			streams.outPositionX = outPositions.X();
+			streams.outPositionY = outPositions.Y();
+			streams.outPositionZ = outPositions.Z();
+
+			if (normals != nullptr)
+			{
+				outNormals->Resize(count);
+				streams.normalX = normals->X();
+				streams.normalY = normals->Y();
+				streams.normalZ = normals->Z();
+				streams.outNormalX = outNormals->X();
+				streams.outNormalY = outNormals->Y();
+				streams.outNormalZ = outNormals->Z();
+			}
+
+			Parallel::For(count, PARALLEL_SKIN_COUNT, [&influences, palette, &streams](const size_t begin, const size_t end)
+			{
+				SkinRange(influences, palette, streams, begin, end);
+			});
+			return true;
+		}
+
+		/**
+		 * @brief Row-major copy of a Matrix4 palette, so blending a bone costs three registers instead of four.
+		 */
+		std::vector<Affine3> ToAffinePalette(const ArrayView<const Matrix4> palette)
+		{
+			std::vector<Affine3> affinePalette;
+			affinePalette.reserve(palette.Size());
+			for (const Matrix4& matrix : palette)
+			{
+				affinePalette.emplace_back(matrix);
+			}
+			return affinePalette;
+		}
+	}
+
+	bool LinearBlend(const SkinInfluences& influences, const ArrayView<const Matrix4> palette, const Vector3SoA& positions, Vector3SoA& outPositions)
+	{
+		return Skin(influences, ToAffinePalette(palette).data(), palette.Size(), positions, nullptr, outPositions, nullptr);
+	}
+
+	bool LinearBlend(const SkinInfluences& influences, const ArrayView<const Affine3> palette, const Vector3SoA& positions, Vector3SoA& outPositions)
+	{
+		return Skin(influences, palette.data, palette.Size(), positions, nullptr, outPositions, nullptr);
+	}
+
+	bool LinearBlend(const CompressedSkinInfluences& influences, const ArrayView<const Matrix4> palette, const Vector3SoA& positions, Vector3SoA& outPositions)
+	{
+		return Skin(influences, ToAffinePalette(palette).data(), palette.Size(), positions, nullptr, outPositions, nullptr);
+	}
+
+	bool LinearBlend(const CompressedSkinInfluences& influences, const ArrayView<const Affine3> palette, const Vector3SoA& positions, Vector3SoA& outPositions)
+	{
+		return Skin(influences, palette.data, palette.Size(), positions, nullptr, outPositions, nullptr);
+	}
+
+	bool LinearBlend(const SkinInfluences& influences, const ArrayView<const Matrix4> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+		Vector3SoA& outPositions, Vector3SoA& outNormals)
+	{
+		return Skin(influences, ToAffinePalette(palette).data(), palette.Size(), positions, &normals, outPositions, &outNormals);
+	}
+
+	bool LinearBlend(const SkinInfluences& influences, const ArrayView<const Affine3> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+		Vector3SoA& outPositions, Vector3SoA& outNormals)
+	{
+		return Skin(influences, palette.data, palette.Size(), positions, &normals, outPositions, &outNormals);
+	}
+
+	bool LinearBlend(const CompressedSkinInfluences& influences, const ArrayView<const Matrix4> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+		Vector3SoA& outPositions, Vector3SoA& outNormals)
+	{
+		return Skin(influences, ToAffinePalette(palette).data(), palette.Size(), positions, &normals, outPositions, &outNormals);
+	}
+
+	bool LinearBlend(const CompressedSkinInfluences& influences, const ArrayView<const Affine3> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+		Vector3SoA& outPositions, Vector3SoA& outNormals)
+	{
+		return Skin(influences, palette.data, palette.Size(), positions, &normals, outPositions, &outNormals);
+	}
+}
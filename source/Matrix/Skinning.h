@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Core/ArrayView.h"
+
+namespace LibMath
+{
+	struct Affine3;
+	struct Matrix4;
+	class Vector3SoA;
+
+	/**
+	 * Bone influences of a skinned mesh: influenceCount bone indices and as many weights per vertex,
+	 * stored vertex after vertex. The weights of a vertex are expected to sum to 1, unused influences
+	 * having a zero weight and any valid bone index. Every bone index must be lower than the palette size,
+	 * which is only checked by an assertion in debug builds.
+	 *
+	 * @tparam TWeight float, or uint8_t for weights compressed in 1/255 steps
+	 */
+	template <class TWeight>
+	struct TSkinInfluences
+	{
+		const uint16_t* boneIndices = nullptr;/**< influenceCount indices in the palette per vertex*/
+		const TWeight* weights = nullptr;/**< influenceCount weights per vertex*/
+		size_t influenceCount = 4;/**< influences per vertex, usually 4 or 8*/
+	};
+
+	using SkinInfluences = TSkinInfluences<float>;
+	using CompressedSkinInfluences = TSkinInfluences<uint8_t>;
+
+	/**
+	 * @brief Linear blend skinning: each vertex is transformed by the weighted sum of the palette matrices of its bones.
+	 * Palette matrices are expected to be affine, the last row of a Matrix4 is ignored. Blended matrices and the
+	 * transformed vertices are computed four vertices at a time with SSE, large meshes are processed in parallel.
+	 * Normals are transformed by the cofactor matrix of the blended transformation, the inverse transpose up to a scale,
+	 * so they stay perpendicular to the surface under non-uniform scale and shear. Skinned normals are normalized again,
+	 * zero normals stay zero.
+	 */
+	namespace Skinning
+	{
+		/*
+		 * @name Skin positions only
+		 *
+		 * @param influences Bone indices and weights of every vertex
+		 * @param palette Skinning matrices, usually the bone world matrix times the inverse bind pose
+		 * @param positions Positions of the mesh in bind pose
+		 * @param outPositions Receives the skinned positions, resized to positions.Size()
+		 * @return false without touching the outputs when influences.influenceCount is 0
+		 */
+		/*@{*/
+		bool LinearBlend(const SkinInfluences& influences, ArrayView<const Matrix4> palette, const Vector3SoA& positions, Vector3SoA& outPositions);
+		bool LinearBlend(const SkinInfluences& influences, ArrayView<const Affine3> palette, const Vector3SoA& positions, Vector3SoA& outPositions);
+		bool LinearBlend(const CompressedSkinInfluences& influences, ArrayView<const Matrix4> palette, const Vector3SoA& positions, Vector3SoA& outPositions);
+		bool LinearBlend(const CompressedSkinInfluences& influences, ArrayView<const Affine3> palette, const Vector3SoA& positions, Vector3SoA& outPositions);
+		/*@}*/
+
+		/*
+		 * @name Skin positions and normals with the same blended matrices
+		 *
+		 * @param influences Bone indices and weights of every vertex
+		 * @param palette Skinning matrices, usually the bone world matrix times the inverse bind pose
+		 * @param positions Positions of the mesh in bind pose
+		 * @param normals Normals of the mesh in bind pose, as many as positions, asserted in debug builds
+		 * @param outPositions Receives the skinned positions, resized to positions.Size()
+		 * @param outNormals Receives the skinned unit normals, resized to positions.Size()
+		 * @return false without touching the outputs when influences.influenceCount is 0
+		 */
+		/*@{*/
+		bool LinearBlend(const SkinInfluences& influences, ArrayView<const Matrix4> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+			Vector3SoA& outPositions, Vector3SoA& outNormals);
+		bool LinearBlend(const SkinInfluences& influences, ArrayView<const Affine3> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+			Vector3SoA& outPositions, Vector3SoA& outNormals);
+		bool LinearBlend(const CompressedSkinInfluences& influences, ArrayView<const Matrix4> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+			Vector3SoA& outPositions, Vector3SoA& outNormals);
+		bool LinearBlend(const CompressedSkinInfluences& influences, ArrayView<const Affine3> palette, const Vector3SoA& positions, const Vector3SoA& normals,
+			Vector3SoA& outPositions, Vector3SoA& outNormals);
+		/*@}*/
+	}
+}
@@ -0,0 +1,547 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "Core/SIMD.h"
+#include "Matrix/Matrix3.h"
+#include "Matrix/Matrix4.h"
+#include "Matrix/MatrixKernels.h"
+
+namespace LibMath
+{
+	/**
+	 * Fixed-size R x C matrix of float or double, stored column-major like Matrix4: raw[c * R + r].
+	 * <p>
+	 * Sizes are template parameters, so every loop has constant bounds the compiler unrolls. Float
+	 * products with a multiple of 4 rows and double products with an even number of rows use SSE,
+	 * 4x4 float products go through the Matrix4 kernel. Matrix3 and Matrix4 convert to and from the
+	 * matching TMatrix without reordering.
+	 * <p>
+	 * The solvers are meant for the small systems of estimation code, up to about 8x8: LU with partial
+	 * pivoting for square systems, Cholesky for symmetric positive definite ones and Householder QR for
+	 * the least squares solution of overdetermined ones. Like the rest of the library they report a
+	 * singular system by returning false instead of throwing. A matrix is singular when a pivot is below
+	 * epsilon * max(R, C) * max|a(i, j)|, so nearly rank deficient matrices are rejected too.
+	 *
+	 * @tparam R Number of rows
+	 * @tparam C Number of columns
+	 * @tparam T float or double
+	 */
+	template <size_t R, size_t C, typename T = float>
+	struct TMatrix
+	{
+		static_assert(std::is_floating_point_v<T>, "TMatrix expects float or double components");
+		static_assert(R > 0 && C > 0, "TMatrix needs at least one row and one column");
+
+		static constexpr size_t ROWS = R;
+		static constexpr size_t COLUMNS = C;
+
+		/**
+		 * @brief Default constructor, every value is 0
+		 */
+		constexpr TMatrix() = default;
+
+		/**
+		 * @brief Constructor setting the diagonal to diagonalValue and every other value to 0
+		 *
+		 * @param diagonalValue Value of (i, i) for every i
+		 */
+		explicit constexpr TMatrix(const T diagonalValue)
+		{
+			for (size_t i = 0; i < (R < C ? R : C); i++)
+			{
+				raw[i * R + i] = diagonalValue;
+			}
+		}
+
+		static constexpr TMatrix Identity() { return TMatrix(T(1)); }
+
+		/*
+		* @name Conversions with Matrix3 and Matrix4, same layout
+		*/
+		/*@{*/
+		template <size_t Rows = R, size_t Columns = C, typename U = T, std::enable_if_t<Rows == 3 && Columns == 3 && std::is_same_v<U, float>, int> = 0>
+		explicit constexpr TMatrix(const Matrix3& matrix)
+		{
+			for (int c = 0; c < 3; c++)
+				for (int r = 0; r < 3; r++)
+					raw[c * 3 + r] = matrix[c][r];
+		}
+
+		template <size_t Rows = R, size_t Columns = C, typename U = T, std::enable_if_t<Rows == 3 && Columns == 3 && std::is_same_v<U, float>, int> = 0>
+		[[nodiscard]] constexpr Matrix3 ToMatrix3() const
+		{
+			Matrix3 result;
+			for (int c = 0; c < 3; c++)
+				for (int r = 0; r < 3; r++)
+					result[c][r] = raw[c * 3 + r];
+			return result;
+		}
+
+		template <size_t Rows = R, size_t Columns = C, typename U = T, std::enable_if_t<Rows == 4 && Columns == 4 && std::is_same_v<U, float>, int> = 0>
+		explicit constexpr TMatrix(const Matrix4& matrix)
+		{
+			for (int i = 0; i < 16; i++)
+				raw[i] = matrix.raw[i];
+		}
+
+		template <size_t Rows = R, size_t Columns = C, typename U = T, std::enable_if_t<Rows == 4 && Columns == 4 && std::is_same_v<U, float>, int> = 0>
+		[[nodiscard]] constexpr Matrix4 ToMatrix4() const
+		{
+			Matrix4 result;
+			for (int i = 0; i < 16; i++)
+				result.raw[i] = raw[i];
+			return result;
+		}
+		/*@}*/
+
+		/*
+		* @name Element at row r and column c
+		*/
+		/*@{*/
+		constexpr T& operator()(const size_t r, const size_t c) { return raw[c * R + r]; }
+		constexpr T operator()(const size_t r, const size_t c) const { return raw[c * R + r]; }
+		/*@}*/
+
+		constexpr bool operator==(const TMatrix& other) const
+		{
+			for (size_t i = 0; i < R * C; i++)
+				if (raw[i] != other.raw[i])
+					return false;
+
+			return true;
+		}
+		constexpr bool operator!=(const TMatrix& other) const { return !(*this == other); }
+
+		/*
+		* @name Element-wise arithmetic and scaling
+		*/
+		/*@{*/
+		constexpr TMatrix& operator+=(const TMatrix& other) { for (size_t i = 0; i < R * C; i++) raw[i] += other.raw[i]; return *this; }
+		constexpr TMatrix& operator-=(const TMatrix& other) { for (size_t i = 0; i < R * C; i++) raw[i] -= other.raw[i]; return *this; }
+		constexpr TMatrix& operator*=(const T scale) { for (T& value : raw) value *= scale; return *this; }
+		[[nodiscard]] constexpr TMatrix operator+(const TMatrix& other) const { TMatrix result(*this); return result += other; }
+		[[nodiscard]] constexpr TMatrix operator-(const TMatrix& other) const { TMatrix result(*this); return result -= other; }
+		[[nodiscard]] constexpr TMatrix operator*(const T scale) const { TMatrix result(*this); return result *= scale; }
+		/*@}*/
+
+		/**
+		 * @brief Matrix product, every column of the result being the columns of this matrix weighted by a column of other.
+		 * Every path sums in the same order without fused multiply-add, so SIMD and scalar results are the same.
+		 * 4x4 float products use the SSE kernel of Matrix4, they may still differ from Matrix4::operator* in the last
+		 * bit on processors where it switches to FMA.
+		 *
+		 * @tparam K Number of columns of other
+		 * @param other C x K matrix
+		 * @return The R x K product
+		 */
+		template <size_t K>
+		[[nodiscard]] TMatrix<R, K, T> operator*(const TMatrix<C, K, T>& other) const
+		{
+			TMatrix<R, K, T> result;
+
+			if constexpr (R == 4 && C == 4 && K == 4 && std::is_same_v<T, float>)
+			{
+				// The kernel of Matrix4::operator* without FMA, reading the operands in place
+#if LIBMATH_SSE
+				MatrixKernels::MatrixColumns::Product(raw, other.raw, result.raw);
+#else
+				MatrixKernels::MultiplyScalar(raw, other.raw, result.raw);
+#endif
+			}
+#if LIBMATH_SSE
+			else if constexpr (std::is_same_v<T, float> && R % 4 == 0)
+			{
+				for (size_t k = 0; k < K; k++)
+				{
+					for (size_t r = 0; r < R; r += 4)
+					{
+						__m128 sum = _mm_mul_ps(_mm_loadu_ps(raw + r), _mm_set1_ps(other(0, k)));
+						for (size_t c = 1; c < C; c++)
+						{
+							sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(raw + c * R + r), _mm_set1_ps(other(c, k))));
+						}
+						_mm_storeu_ps(result.raw + k * R + r, sum);
+					}
+				}
+			}
+			else if constexpr (std::is_same_v<T, double> && R % 2 == 0)
+			{
+				for (size_t k = 0; k < K; k++)
+				{
+					for (size_t r = 0; r < R; r += 2)
+					{
+						__m128d sum = _mm_mul_pd(_mm_loadu_pd(raw + r), _mm_set1_pd(other(0, k)));
+						for (size_t c = 1; c < C; c++)
+						{
+							sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(raw + c * R + r), _mm_set1_pd(other(c, k))));
+						}
+						_mm_storeu_pd(result.raw + k * R + r, sum);
+					}
+				}
+			}
+#endif
+			else
+			{
+				for (size_t k = 0; k < K; k++)
+				{
+					for (size_t r = 0; r < R; r++)
+					{
+						T sum = (*this)(r, 0) * other(0, k);
+						for (size_t c = 1; c < C; c++)
+						{
+							sum += (*this)(r, c) * other(c, k);
+						}
+						result(r, k) = sum;
+					}
+				}
+			}
+
+			return result;
+		}
+
+		/*
+		 * @brief called from the matrix you want to transpose
+		 * @return the C x R transposed matrix
+		 */
+		[[nodiscard]] constexpr TMatrix<C, R, T> GetTranspose() const
+		{
+			TMatrix<C, R, T> result;
+			for (size_t c = 0; c < C; c++)
+				for (size_t r = 0; r < R; r++)
+					result(c, r) = (*this)(r, c);
+			return result;
+		}
+
+		/*
+		 * @brief transpose a square matrix in place
+		 */
+		constexpr void Transpose()
+		{
+			static_assert(R == C, "Only a square matrix can be transposed in place, use GetTranspose()");
+			*this = GetTranspose();
+		}
+
+		/*
+		 * @brief determinant of a square matrix, computed with the LU decomposition
+		 * @return the determinant, 0 if the matrix is singular
+		 */
+		[[nodiscard]] T Determinant() const
+		{
+			static_assert(R == C, "The determinant needs a square matrix");
+
+			TMatrix lu(*this);
+			size_t permutation[R];
+			T determinant;
+			if (!FactorLU(lu, permutation, determinant)) return T(0);
+
+			for (size_t i = 0; i < R; i++)
+			{
+				determinant *= lu(i, i);
+			}
+			return determinant;
+		}
+
+		/*
+		 * @brief called with the square matrix you want the inverse from
+		 * @return the inverse matrix, zero if the matrix is singular
+		 */
+		[[nodiscard]] TMatrix GetInverse() const
+		{
+			TMatrix inverse;
+			if (!SolveLU(Identity(), inverse)) return TMatrix();
+			return inverse;
+		}
+
+		/**
+		 * @brief Solve this * x = b for a square matrix, with LU decomposition and partial pivoting.
+		 *
+		 * @tparam K Number of right hand sides
+		 * @param b Right hand sides, one per column
+		 * @param outX Receives the solutions, untouched if the matrix is singular
+		 * @return false if the matrix is singular to working precision
+		 */
+		template <size_t K>
+		bool SolveLU(const TMatrix<R, K, T>& b, TMatrix<C, K, T>& outX) const
+		{
+			static_assert(R == C, "SolveLU needs a square matrix, use SolveQR() for least squares");
+
+			TMatrix lu(*this);
+			size_t permutation[R];
+			T sign;
+			if (!FactorLU(lu, permutation, sign)) return false;
+
+			TMatrix<C, K, T> x;
+			for (size_t k = 0; k < K; k++)
+			{
+				// L * y = P * b, L having a unit diagonal
+				for (size_t i = 0; i < R; i++)
+				{
+					T sum = b(permutation[i], k);
+					for (size_t j = 0; j < i; j++)
+					{
+						sum -= lu(i, j) * x(j, k);
+					}
+					x(i, k) = sum;
+				}
+
+				// U * x = y
+				for (size_t i = R; i-- > 0;)
+				{
+					T sum = x(i, k);
+					for (size_t j = i + 1; j < R; j++)
+					{
+						sum -= lu(i, j) * x(j, k);
+					}
+					x(i, k) = sum / lu(i, i);
+				}
+			}
+
+			outX = x;
+			return true;
+		}
+
+		/**
+		 * @brief Solve this * x = b for a symmetric positive definite matrix, normal equations or covariances for instance.
+		 * About twice as fast as SolveLU(), only the lower triangle of this matrix is read.
+		 *
+		 * @tparam K Number of right hand sides
+		 * @param b Right hand sides, one per column
+		 * @param outX Receives the solutions, untouched if the matrix is not positive definite
+		 * @return false if the matrix is not positive definite to working precision
+		 */
+		template <size_t K>
+		bool SolveCholesky(const TMatrix<R, K, T>& b, TMatrix<C, K, T>& outX) const
+		{
+			static_assert(R == C, "SolveCholesky needs a square matrix");
+
+			// this = L * transpose(L), L lower triangular. The diagonal left once the previous columns are removed is the pivot
+			// LU would find without pivoting, in the units of this matrix, so it is compared with the same tolerance
+			const T tolerance = SingularTolerance(*this);
+			TMatrix lower;
+			for (size_t j = 0; j < R; j++)
+			{
+				T diagonal = (*this)(j, j);
+				for (size_t k = 0; k < j; k++)
+				{
+					diagonal -= lower(j, k) * lower(j, k);
+				}
+				if (!(diagonal > tolerance)) return false;
+
+				const T root = std::sqrt(diagonal);
+				lower(j, j) = root;
+
+				const T inverseRoot = T(1) / root;
+				for (size_t i = j + 1; i < R; i++)
+				{
+					T sum = (*this)(i, j);
+					for (size_t k = 0; k < j; k++)
+					{
+						sum -= lower(i, k) * lower(j, k);
+					}
+					lower(i, j) = sum * inverseRoot;
+				}
+			}
+
+			TMatrix<C, K, T> x;
+			for (size_t k = 0; k < K; k++)
+			{
+				// L * y = b
+				for (size_t i = 0; i < R; i++)
+				{
+					T sum = b(i, k);
+					for (size_t j = 0; j < i; j++)
+					{
+						sum -= lower(i, j) * x(j, k);
+					}
+					x(i, k) = sum / lower(i, i);
+				}
+
+				// transpose(L) * x = y
+				for (size_t i = R; i-- > 0;)
+				{
+					T sum = x(i, k);
+					for (size_t j = i + 1; j < R; j++)
+					{
+						sum -= lower(j, i) * x(j, k);
+					}
+					x(i, k) = sum / lower(i, i);
+				}
+			}
+
+			outX = x;
+			return true;
+		}
+
+		/**
+		 * @brief Solve this * x = b in the least squares sense, with Householder QR decomposition. R >= C: as many or more
+		 * equations than unknowns, the solution minimizing the norm of this * x - b. Slower than SolveLU() for square systems
+		 * but better conditioned than solving the normal equations.
+		 *
+		 * @tparam K Number of right hand sides
+		 * @param b Right hand sides, one per column
+		 * @param outX Receives the solutions, untouched if the columns of this matrix are linearly dependent
+		 * @return false if the matrix does not have full column rank to working precision
+		 */
+		template <size_t K>
+		bool SolveQR(const TMatrix<R, K, T>& b, TMatrix<C, K, T>& outX) const
+		{
+			static_assert(R >= C, "SolveQR needs at least as many equations as unknowns");
+
+			TMatrix a(*this);
+			TMatrix<R, K, T> rhs(b);
+			T diagonal[C];
+			const T tolerance = SingularTolerance(*this);
+
+			for (size_t j = 0; j < C; j++)
+			{
+				T squaredNorm = T(0);
+				for (size_t i = j; i < R; i++)
+				{
+					squaredNorm += a(i, j) * a(i, j);
+				}
+				const T norm = std::sqrt(squaredNorm);
+				if (!(norm > tolerance)) return false;
+
+				// The reflection maps the column to (alpha, 0, ...), alpha having the opposite sign of a(j, j) to avoid cancellations
+				const T alpha = a(j, j) > T(0) ? -norm : norm;
+
+				// v = column - alpha * e_j stored in place, v.v = 2 * norm * (norm + |a(j, j)|)
+				a(j, j) -= alpha;
+				const T inverseHalfSquaredV = T(1) / (squaredNorm - alpha * (a(j, j) + alpha));
+
+				const auto reflect = [&a, j, inverseHalfSquaredV](auto& matrix, const size_t column)
+				{
+					T dot = T(0);
+					for (size_t i = j; i < R; i++)
+					{
+						dot += a(i, j) * matrix(i, column);
+					}
+					const T factor = dot * inverseHalfSquaredV;
+					for (size_t i = j; i < R; i++)
+					{
+						matrix(i, column) -= factor * a(i, j);
+					}
+				};
+
+				for (size_t column = j + 1; column < C; column++)
+				{
+					reflect(a, column);
+				}
+				for (size_t column = 0; column < K; column++)
+				{
+					reflect(rhs, column);
+				}
+
+				diagonal[j] = alpha;
+			}
+
+			// R * x = transpose(Q) * b, R being upper triangular with the diagonal kept aside
+			TMatrix<C, K, T> x;
+			for (size_t k = 0; k < K; k++)
+			{
+				for (size_t i = C; i-- > 0;)
+				{
+					T sum = rhs(i, k);
+					for (size_t j = i + 1; j < C; j++)
+					{
+						sum -= a(i, j) * x(j, k);
+					}
+					x(i, k) = sum / diagonal[i];
+				}
+			}
+
+			outX = x;
+			return true;
+		}
+
+		T raw[R * C]{};
+
+	private:
+		/**
+		 * @brief Pivots at or below this value are rounding noise: the columns of the matrix are dependent to working precision.
+		 *
+		 * @return epsilon * max(R, C) * max|a(i, j)|, 0 for a zero matrix
+		 */
+		static T SingularTolerance(const TMatrix& matrix)
+		{
+			T largest = T(0);
+			for (const T value : matrix.raw)
+			{
+				const T magnitude = std::abs(value);
+				if (magnitude > largest)
+				{
+					largest = magnitude;
+				}
+			}
+			return std::numeric_limits<T>::epsilon() * static_cast<T>(R > C ? R : C) * largest;
+		}
+
+		/**
+		 * @brief In place LU decomposition with partial pivoting, P * this = L * U, L having a unit diagonal.
+		 *
+		 * @param lu Matrix to decompose, receives L below the diagonal and U above and on it
+		 * @param outPermutation Receives the row of the original matrix used for each row of the decomposition
+		 * @param outSign Receives 1 or -1, the sign of the permutation
+		 * @return false if the matrix is singular
+		 */
+		static bool FactorLU(TMatrix& lu, size_t (&outPermutation)[R], T& outSign)
+		{
+			const T tolerance = SingularTolerance(lu);
+			outSign = T(1);
+			for (size_t i = 0; i < R; i++)
+			{
+				outPermutation[i] = i;
+			}
+
+			for (size_t j = 0; j < R; j++)
+			{
+				size_t pivot = j;
+				T pivotMagnitude = std::abs(lu(j, j));
+				for (size_t i = j + 1; i < R; i++)
+				{
+					const T magnitude = std::abs(lu(i, j));
+					if (magnitude > pivotMagnitude)
+					{
+						pivot = i;
+						pivotMagnitude = magnitude;
+					}
+				}
+				if (!(pivotMagnitude > tolerance)) return false;
+
+				if (pivot != j)
+				{
+					for (size_t c = 0; c < R; c++)
+					{
+						const T swapped = lu(j, c);
+						lu(j, c) = lu(pivot, c);
+						lu(pivot, c) = swapped;
+					}
+					const size_t swappedRow = outPermutation[j];
+					outPermutation[j] = outPermutation[pivot];
+					outPermutation[pivot] = swappedRow;
+					outSign = -outSign;
+				}
+
+				const T inversePivot = T(1) / lu(j, j);
+				for (size_t i = j + 1; i < R; i++)
+				{
+					const T factor = lu(i, j) * inversePivot;
+					lu(i, j) = factor;
+					for (size_t c = j + 1; c < R; c++)
+					{
+						lu(i, c) -= factor * lu(j, c);
+					}
+				}
+			}
+
+			return true;
+		}
+	};
+
+	template <size_t N, typename T = float>
+	using TColumnVector = TMatrix<N, 1, T>;
+}
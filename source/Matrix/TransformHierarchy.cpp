@@ -0,0 +1,298 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "Core/Parallel.h"
+
+namespace LibMath
+{
+	namespace
+	{
+		template <class T>
+		void Permute(std::vector<T>& values, const std::vector<uint32_t>& newSlotOf)
+		{
+			std::vector<T> permuted(values.size());
+			for (size_t slot = 0; slot < values.size(); slot++)
+			{
+				permuted[newSlotOf[slot]] = values[slot];
+			}
+			values.swap(permuted);
+		}
+
+		void Permute(Vector3SoA& values, const std::vector<uint32_t>& newSlotOf)
+		{
+			Vector3SoA permuted(values.Size());
+			for (size_t slot = 0; slot < values.Size(); slot++)
+			{
+				permuted.Set(newSlotOf[slot], values.Get(slot));
+			}
+			values = std::move(permuted);
+		}
+	}
+
+	uint32_t TransformHierarchy::AddNode(const uint32_t parent, const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+	{
+		const uint32_t handle = static_cast<uint32_t>(m_handleOf.size());
+		const uint32_t parentSlot = parent == INVALID_NODE ? INVALID_NODE : m_slotOf[parent];
+
+		m_translation.PushBack(translation);
+		m_rotationX.push_back(rotation.X);
+		m_rotationY.push_back(rotation.Y);
+		m_rotationZ.push_back(rotation.Z);
+		m_rotationW.push_back(rotation.W);
+		m_scale.PushBack(scale);
+
+		m_parentSlot.push_back(parentSlot);
+		m_depth.push_back(parentSlot == INVALID_NODE ? 0 : m_depth[parentSlot] + 1);
+		m_handleOf.push_back(handle);
+		m_dirty.push_back(1);
+		m_updated.push_back(0);
+
+		m_worldMatrices.emplace_back();
+		m_worldAffines.emplace_back();
+
+		m_slotOf.push_back(handle);
+
+		m_hasDirty = true;
+		m_structureChanged = true;
+
+		return handle;
+	}
+
+	void TransformHierarchy::Reserve(const size_t nodeCount)
+	{
+		m_translation.Reserve(nodeCount);
+		m_rotationX.reserve(nodeCount);
+		m_rotationY.reserve(nodeCount);
+		m_rotationZ.reserve(nodeCount);
+		m_rotationW.reserve(nodeCount);
+		m_scale.Reserve(nodeCount);
+
+		m_parentSlot.reserve(nodeCount);
+		m_depth.reserve(nodeCount);
+		m_handleOf.reserve(nodeCount);
+		m_dirty.reserve(nodeCount);
+		m_updated.reserve(nodeCount);
+
+		m_worldMatrices.reserve(nodeCount);
+		m_worldAffines.reserve(nodeCount);
+
+		m_slotOf.reserve(nodeCount);
+	}
+
+	void TransformHierarchy::Clear()
+	{
+		m_translation.Clear();
+		m_rotationX.clear();
+		m_rotationY.clear();
+		m_rotationZ.clear();
+		m_rotationW.clear();
+		m_scale.Clear();
+
+		m_parentSlot.clear();
+		m_depth.clear();
+		m_handleOf.clear();
+		m_dirty.clear();
+		m_updated.clear();
+
+		m_worldMatrices.clear();
+		m_worldAffines.clear();
+
+		m_slotOf.clear();
+		m_levelStart.clear();
+		m_levelDirty.clear();
+
+		m_hasDirty = false;
+		m_structureChanged = false;
+	}
+
+	void TransformHierarchy::SetLocalTranslation(const uint32_t node, const Vector3& translation)
+	{
+		const uint32_t slot = m_slotOf[node];
+		m_translation.Set(slot, translation);
+		MarkDirty(slot);
+	}
+
+	void TransformHierarchy::SetLocalRotation(const uint32_t node, const Quaternion& rotation)
+	{
+		const uint32_t slot = m_slotOf[node];
+		m_rotationX[slot] = rotation.X;
+		m_rotationY[slot] = rotation.Y;
+		m_rotationZ[slot] = rotation.Z;
+		m_rotationW[slot] = rotation.W;
+		MarkDirty(slot);
+	}
+
+	void TransformHierarchy::SetLocalScale(const uint32_t node, const Vector3& scale)
+	{
+		const uint32_t slot = m_slotOf[node];
+		m_scale.Set(slot, scale);
+		MarkDirty(slot);
+	}
+
+	void TransformHierarchy::SetLocal(const uint32_t node, const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+	{
+		const uint32_t slot = m_slotOf[node];
+		m_translation.Set(slot, translation);
+		m_rotationX[slot] = rotation.X;
+		m_rotationY[slot] = rotation.Y;
+		m_rotationZ[slot] = rotation.Z;
+		m_rotationW[slot] = rotation.W;
+		m_scale.Set(slot, scale);
+		MarkDirty(slot);
+	}
+
+	Quaternion TransformHierarchy::GetLocalRotation(const uint32_t node) const
+	{
+		const uint32_t slot = m_slotOf[node];
+		return Quaternion(m_rotationX[slot], m_rotationY[slot], m_rotationZ[slot], m_rotationW[slot]);
+	}
+
+	uint32_t TransformHierarchy::GetParent(const uint32_t node) const
+	{
+		const uint32_t parentSlot = m_parentSlot[m_slotOf[node]];
+		return parentSlot == INVALID_NODE ? INVALID_NODE : m_handleOf[parentSlot];
+	}
+
+	void TransformHierarchy::MarkDirty(const uint32_t slot)
+	{
+		m_dirty[slot] = 1;
+		m_hasDirty = true;
+
+		// The levels are rebuilt, and all of them visited, by the next Update() after a node was added
+		if (!m_structureChanged)
+		{
+			m_levelDirty[m_depth[slot]] = 1;
+		}
+	}
+
+	void TransformHierarchy::SortByDepth()
+	{
+		const size_t count = Size();
+		const uint32_t depthCount = count == 0 ? 0 : *std::max_element(m_depth.begin(), m_depth.end()) + 1;
+
+		// Counting sort of the slots by depth, stable so an already sorted hierarchy keeps its slots
+		m_levelStart.assign(depthCount + 1, 0);
+		for (const uint32_t depth : m_depth)
+		{
+			m_levelStart[depth + 1]++;
+		}
+		for (uint32_t depth = 0; depth < depthCount; depth++)
+		{
+			m_levelStart[depth + 1] += m_levelStart[depth];
+		}
+
+		m_levelDirty.assign(depthCount, 1);
+
+		if (std::is_sorted(m_depth.begin(), m_depth.end()))
+		{
+			return;
+		}
+
+		std::vector<uint32_t> newSlotOf(count);
+		std::vector<uint32_t> next(m_levelStart.begin(), m_levelStart.end() - 1);
+		for (size_t slot = 0; slot < count; slot++)
+		{
+			newSlotOf[slot] = next[m_depth[slot]]++;
+		}
+
+		for (uint32_t& parentSlot : m_parentSlot)
+		{
+			if (parentSlot != INVALID_NODE)
+			{
+				parentSlot = newSlotOf[parentSlot];
+			}
+		}
+
+		Permute(m_translation, newSlotOf);
+		Permute(m_rotationX, newSlotOf);
+		Permute(m_rotationY, newSlotOf);
+		Permute(m_rotationZ, newSlotOf);
+		Permute(m_rotationW, newSlotOf);
+		Permute(m_scale, newSlotOf);
+
+		Permute(m_parentSlot, newSlotOf);
+		Permute(m_depth, newSlotOf);
+		Permute(m_handleOf, newSlotOf);
+		Permute(m_dirty, newSlotOf);
+		Permute(m_worldMatrices, newSlotOf);
+		Permute(m_worldAffines, newSlotOf);
+
+		for (size_t slot = 0; slot < count; slot++)
+		{
+			m_slotOf[m_handleOf[slot]] = static_cast<uint32_t>(slot);
+		}
+	}
+
+	size_t TransformHierarchy::Update()
+	{
+		if (m_structureChanged)
+		{
+			SortByDepth();
+			m_structureChanged = false;
+		}
+
+		if (!m_hasDirty)
+		{
+			return 0;
+		}
+
+		size_t updatedCount = 0;
+		bool parentLevelUpdated = false;
+
+		// Parents are updated by the previous level, so the nodes of a level never depend on each other.
+		// A level without dirty node under a level left untouched is skipped without reading its flags.
+		for (size_t level = 0; level < GetDepthCount(); level++)
+		{
+			if (!m_levelDirty[level] && !parentLevelUpdated)
+			{
+				continue;
+			}
+
+			const size_t levelBegin = m_levelStart[level];
+			const size_t levelEnd = m_levelStart[level + 1];
+			std::atomic<size_t> levelUpdatedCount{ 0 };
+
+			Parallel::For(levelEnd - levelBegin, PARALLEL_UPDATE_COUNT, [this, levelBegin, parentLevelUpdated, &levelUpdatedCount](const size_t begin, const size_t end)
+			{
+				size_t rangeUpdatedCount = 0;
+
+				for (size_t slot = levelBegin + begin; slot < levelBegin + end; slot++)
+				{
+					const uint32_t parentSlot = m_parentSlot[slot];
+					const bool parentUpdated = parentLevelUpdated && parentSlot != INVALID_NODE && m_updated[parentSlot];
+
+					if (!m_dirty[slot] && !parentUpdated)
+					{
+						m_updated[slot] = 0;
+						continue;
+					}
+
+					const Quaternion rotation(m_rotationX[slot], m_rotationY[slot], m_rotationZ[slot], m_rotationW[slot]);
+					Affine3 world = Affine3::FromTRS(m_translation.Get(slot), rotation, m_scale.Get(slot));
+					if (parentSlot != INVALID_NODE)
+					{
+						world = m_worldAffines[parentSlot] * world;
+					}
+
+					m_worldAffines[slot] = world;
+					m_worldMatrices[slot] = world.ToMatrix4();
+					m_dirty[slot] = 0;
+					m_updated[slot] = 1;
+					rangeUpdatedCount++;
+				}
+
+				levelUpdatedCount += rangeUpdatedCount;
+			});
+
+			m_levelDirty[level] = 0;
+			parentLevelUpdated = levelUpdatedCount > 0;
+			updatedCount += levelUpdatedCount;
+		}
+
+		m_hasDirty = false;
+
+		return updatedCount;
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Matrix/Affine3.h"
+#include "Matrix/Matrix4.h"
+#include "Quaternion/Quaternion.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector3SoA.h"
+
+namespace LibMath
+{
+	/**
+	 * Scene graph of local transformations (translation, rotation, scale) producing the world matrix of every node.
+	 * <p>
+	 * The local transformations are stored as separate component arrays, sorted by depth: the roots first, then
+	 * their children, and so on. Every parent is therefore stored before its children and Update() walks the depth
+	 * levels in order, the nodes of a level being processed in parallel.
+	 * <p>
+	 * Changing a local transformation marks the node dirty and Update() only recomputes the world matrices of the
+	 * dirty nodes and of their descendants, the others keep the result of the previous update.
+	 * <p>
+	 * Nodes are identified by the handle AddNode() returns, which never changes. The world matrices are stored in
+	 * depth order in two contiguous arrays, Matrix4 and Affine3, GetSlot() gives the index of a node in them.
+	 * Adding a node may reorder the slots, they are stable between two AddNode() calls.
+	 */
+	class TransformHierarchy
+	{
+	public:
+		/**
+		 * @brief Parent handle of the roots.
+		 */
+		static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+		TransformHierarchy() = default;
+
+		/**
+		 * @brief Add a node, dirty until the next Update().
+		 *
+		 * @param parent Handle of the parent node, INVALID_NODE for a root
+		 * @param translation Local translation
+		 * @param rotation Local rotation
+		 * @param scale Local scale
+		 * @return Handle of the new node
+		 */
+		uint32_t AddNode(uint32_t parent, const Vector3& translation = Vector3(0.f), const Quaternion& rotation = Quaternion(), const Vector3& scale = Vector3(1.f));
+
+		/**
+		 * @brief Reserve the storage of nodeCount nodes.
+		 *
+		 * @param nodeCount Number of nodes
+		 */
+		void Reserve(size_t nodeCount);
+
+		/**
+		 * @brief Remove every node.
+		 */
+		void Clear();
+
+		[[nodiscard]] size_t Size() const { return m_handleOf.size(); }
+		[[nodiscard]] size_t GetDepthCount() const { return m_levelStart.empty() ? 0 : m_levelStart.size() - 1; }
+
+		/*
+		 * @name Local transformation of a node, the setters mark it dirty
+		 */
+		/*@{*/
+		void SetLocalTranslation(uint32_t node, const Vector3& translation);
+		void SetLocalRotation(uint32_t node, const Quaternion& rotation);
+		void SetLocalScale(uint32_t node, const Vector3& scale);
+		void SetLocal(uint32_t node, const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+
+		[[nodiscard]] Vector3 GetLocalTranslation(uint32_t node) const { return m_translation.Get(m_slotOf[node]); }
+		[[nodiscard]] Quaternion GetLocalRotation(uint32_t node) const;
+		[[nodiscard]] Vector3 GetLocalScale(uint32_t node) const { return m_scale.Get(m_slotOf[node]); }
+		/*@}*/
+
+		/**
+		 * @brief Parent of a node.
+		 *
+		 * @param node Handle of the node
+		 * @return Handle of the parent, INVALID_NODE for a root
+		 */
+		[[nodiscard]] uint32_t GetParent(uint32_t node) const;
+
+		/**
+		 * @brief Index of a node in the world matrix arrays.
+		 *
+		 * @param node Handle of the node
+		 * @return Slot of the node, valid until the next AddNode()
+		 */
+		[[nodiscard]] uint32_t GetSlot(const uint32_t node) const { return m_slotOf[node]; }
+
+		/**
+		 * @brief Recompute the world matrices of the dirty nodes and of their descendants.
+		 *
+		 * @return Number of world matrices recomputed
+		 */
+		size_t Update();
+
+		/*
+		 * @name World matrices computed by the last Update(), Size() values in slot order
+		 */
+		/*@{*/
+		[[nodiscard]] const Matrix4* GetWorldMatrices() const { return m_worldMatrices.data(); }
+		[[nodiscard]] const Affine3* GetWorldAffines() const { return m_worldAffines.data(); }
+
+		[[nodiscard]] const Matrix4& GetWorldMatrix(const uint32_t node) const { return m_worldMatrices[m_slotOf[node]]; }
+		[[nodiscard]] const Affine3& GetWorldAffine(const uint32_t node) const { return m_worldAffines[m_slotOf[node]]; }
+		/*@}*/
+
+	private:
+		/**
+		 * @brief Nodes of a depth level updated by a thread before it is worth splitting the work.
+		 */
+		static constexpr size_t PARALLEL_UPDATE_COUNT = 1 << 12;
+
+		/**
+		 * @brief Sort the slots by depth if nodes were added out of order and rebuild the level ranges.
+		 */
+		void SortByDepth();
+
+		void MarkDirty(uint32_t slot);
+
+		/*
+		 * @name Per slot arrays, sorted by depth
+		 */
+		/*@{*/
+		Vector3SoA m_translation;
+		std::vector<float> m_rotationX;
+		std::vector<float> m_rotationY;
+		std::vector<float> m_rotationZ;
+		std::vector<float> m_rotationW;
+		Vector3SoA m_scale;
+
+		std::vector<uint32_t> m_parentSlot;
+		std::vector<uint32_t> m_depth;
+		std::vector<uint32_t> m_handleOf;
+		std::vector<uint8_t> m_dirty;
+		std::vector<uint8_t> m_updated;
+
+		std::vector<Matrix4> m_worldMatrices;
+		std::vector<Affine3> m_worldAffines;
+		/*@}*/
+
+		std::vector<uint32_t> m_slotOf;
+		std::vector<uint32_t> m_levelStart;
+		std::vector<uint8_t> m_levelDirty;
+
+		bool m_hasDirty = false;
+		bool m_structureChanged = false;
+	};
+}
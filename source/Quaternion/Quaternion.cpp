@@ -4,14 +4,6 @@
 
 using namespace LibMath;
 
-Quaternion::Quaternion() : X(0.f), Y(0.f), Z(0.f), W(1.f)
-{
-}
-
-Quaternion::Quaternion(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w)
-{
-}
-
 LibMath::Quaternion::Quaternion(LibMath::Degree angle, LibMath::Vector3& axis)
 {
 	LibMath::Degree newAngle = angle;
@@ -95,83 +87,6 @@ LibMath::Quaternion::Quaternion(const LibMath::Matrix4& mat4)
 }
 
 
-bool Quaternion::operator==(const Quaternion& other) const
-{
-	if (X == other.X && Y == other.Y && Z == other.Z && W == other.W)
-	{
-		return true;
-	}
-
-	return false;
-}
-
-bool Quaternion::operator!=(const Quaternion& other) const
-{
-	if (*this == other)
-	{
-		return false;
-	}
-
-	return true;
-}
-
-Quaternion Quaternion::operator=(const Quaternion& other)
-{
-	X = other.X;
-	Y = other.Y;
-	Z = other.Z;
-	W = other.W;
-	return *this;
-}
-
-Quaternion Quaternion::operator+(const Quaternion& other) const
-{
-	return Quaternion(X + other.X, Y + other.Y, Z + other.Z, W + other.W);
-}
-
-Quaternion LibMath::Quaternion::operator-(const Quaternion& other) const
-{
-	return Quaternion(X - other.X, Y - other.Y, Z - other.Z, W - other.W);
-}
-
-Quaternion Quaternion::operator*(const Quaternion& other) const
-{
-	Quaternion tempQuaternion;
-
-	tempQuaternion.X = (Y * other.Z) - (Z * other.Y) + (W * other.X) + (other.W * X);
-	tempQuaternion.Y = (Z * other.X) - (X * other.Z) + (W * other.Y) + (other.W * Y);
-	tempQuaternion.Z = (X * other.Y) - (Y * other.X) + (W * other.Z) + (other.W * Z);
-	tempQuaternion.W = (W * other.W) - (X * other.X) - (Y * other.Y) - (Z * other.Z);
-
-	/*tempQuaternion.X = (other.W * X) + (other.X * W) + (other.Y * Z) - (other.Z * Y);
-	tempQuaternion.Y = (other.W * Y) + (other.Y * W) + (other.Z * X) - (other.X * Z);
-	tempQuaternion.Z = (other.W * Z) + (other.Z * W) + (other.X * Y) - (other.Y * X);
-	tempQuaternion.W = (other.W * W) - (other.X * X) - (other.Y * Y) - (other.Z * Z);*/
-
-    return tempQuaternion;
-}
-
-Quaternion Quaternion::operator*(float f) const
-{
-	return Quaternion(f * X, f * Y, f * Z, f * W);
-}
-
-Quaternion& LibMath::Quaternion::operator*=(float f)
-{
-	X *= f;
-	Y *= f;
-	Z *= f;
-	W *= f;
-
-	return *this;
-}
-
-Quaternion& LibMath::Quaternion::operator*=(const Quaternion& other) 
-{
-	*this = *this * other;
-	return *this;
-}
-
 Quaternion& LibMath::Quaternion::operator=(const Matrix4& mat4)
 {
 
@@ -265,11 +180,6 @@ Vector3 LibMath::Quaternion::Rotate(const Vector3& other) const
 		pMult * other.z + vMult * newQuaternion.Z + crossMult * (newQuaternion.X * other.y - newQuaternion.Y * other.x));
 }
 
-float LibMath::Quaternion::DotProduct(const Quaternion& other) const
-{
-	return (X * other.X) + (Y * other.Y) + (Z * other.Z) + (W * other.W);
-}
-
 void LibMath::Quaternion::Normalize()
 {
 	float f = Norm();
@@ -327,16 +237,6 @@ void Quaternion::Negate()
 	W = -W;
 }
 
-Quaternion LibMath::Quaternion::GetInverse() const
-{
-	Quaternion newQuaternion(*this);
-	newQuaternion.X = -newQuaternion.X;
-	newQuaternion.Y = -newQuaternion.Y;
-	newQuaternion.Z = -newQuaternion.Z;
-
-	return newQuaternion;
-}
-
 float LibMath::Quaternion::Norm()
 {
 	return sqrt(X * X + Y * Y + Z * Z + W * W);
@@ -15,7 +15,7 @@ namespace LibMath
 		/**
 		* @brief Default Quaternion constructor, set X,Y,Z,W to 0.f, 0.f, 0.f, 1.f
 		*/
-		Quaternion();
+		constexpr Quaternion() : X(0.f), Y(0.f), Z(0.f), W(1.f) {}
 		/**
 		* @brief Quaternion constructor given 4 floats x,y,z,w
 		*
@@ -24,7 +24,7 @@ namespace LibMath
 		* @param z Z Value.
 		* @param w W Value.
 		*/
-		Quaternion(float x, float y, float z, float w);
+		constexpr Quaternion(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
 
 
 		/**
@@ -65,55 +65,61 @@ namespace LibMath
 		*
 		* @param other Quaternion to compare
 		*/
-		bool operator==(const Quaternion& other) const;
+		constexpr bool operator==(const Quaternion& other) const { return X == other.X && Y == other.Y && Z == other.Z && W == other.W; }
 		/**
 		* @brief Checks if the values of two operands are equal or not, if values are not equal then condition becomes true.
 		*
 		* @param other Quaternion to compare
 		*/
-		bool operator!=(const Quaternion& other) const;
+		constexpr bool operator!=(const Quaternion& other) const { return !(*this == other); }
 		/**
 		* @brief Simple assignment operator, Assigns values from right side operands to left side operand
 		*
 		* @param other Quaternion to assign
 		*/
-		Quaternion operator=(const Quaternion& other);
+		constexpr Quaternion& operator=(const Quaternion& other) = default;
 		/**
 		* @brief Adds two operands (Quaternion + Quaternion)
 		*
 		* @param other Quaternion to add
 		*/
-		Quaternion operator+(const Quaternion& other) const;
+		constexpr Quaternion operator+(const Quaternion& other) const { return Quaternion(X + other.X, Y + other.Y, Z + other.Z, W + other.W); }
 		/**
 		* @brief Substract two operands (Quaternion - Quaternion)
 		*
 		* @param other Quaternion to substract
 		*/
-		Quaternion operator-(const Quaternion& other) const;
+		constexpr Quaternion operator-(const Quaternion& other) const { return Quaternion(X - other.X, Y - other.Y, Z - other.Z, W - other.W); }
 		/**
 		* @brief Multiplies both operands (Quaternion * Quaternion)
 		*
 		* @param other Quaternion to multiply
 		*/
-		Quaternion operator*(const Quaternion & other) const;
+		constexpr Quaternion operator*(const Quaternion& other) const
+		{
+			return Quaternion((Y * other.Z) - (Z * other.Y) + (W * other.X) + (other.W * X),
+				(Z * other.X) - (X * other.Z) + (W * other.Y) + (other.W * Y),
+				(X * other.Y) - (Y * other.X) + (W * other.Z) + (other.W * Z),
+				(W * other.W) - (X * other.X) - (Y * other.Y) - (Z * other.Z));
+		}
 		/**
 		* @brief Multiplies both operands (Quaternion * float)
 		*
 		* @param other float to multiply
 		*/
-        Quaternion operator*(float f) const;
+		constexpr Quaternion operator*(float f) const { return Quaternion(f * X, f * Y, f * Z, f * W); }
 		/**
 		* @brief Multiply AND assignment operator, It multiplies right operand with the left operand (Quaternion * float) and assign the result to left operand.
 		*
 		* @param other float to multiply
 		*/
-		Quaternion& operator*=(float f);
+		constexpr Quaternion& operator*=(float f) { X *= f; Y *= f; Z *= f; W *= f; return *this; }
 		/**
 		* @brief Multiply AND assignment operator, It multiplies right operand with the left operand (Quaternion * Quaternion) and assign the result to left operand.
 		*
 		* @param other Quaternion to multiply
 		*/
-		Quaternion& operator*=(const Quaternion& other);
+		constexpr Quaternion& operator*=(const Quaternion& other) { *this = *this * other; return *this; }
 		
 		/**
 		* @briefSimple assignment operator, Convert a matrix into a quaternion
@@ -145,7 +151,7 @@ namespace LibMath
 		* @param other Another Quaternion 
 		* @return The dot product.
 		*/
-		float DotProduct(const Quaternion& other) const;
+		constexpr float DotProduct(const Quaternion& other) const { return (X * other.X) + (Y * other.Y) + (Z * other.Z) + (W * other.W); }
 		/**
 		* @brief Normalize a quaternion
 		*/
@@ -176,7 +182,7 @@ namespace LibMath
 		*
 		* @return The inversed quaternion.
 		*/
-		Quaternion GetInverse() const;
+		constexpr Quaternion GetInverse() const { return Quaternion(-X, -Y, -Z, W); }
 		/**
 		* @brief Return Norm of quaternion
 		*
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cmath>
+
+#include "Quaternion/Quaternion.h"
+#include "Vector/VectorD.h"
+
+namespace LibMath
+{
+	/**
+	* Quaternion with double precision components, the rotation part of the
+	* double precision transformations.
+	*
+	* @see Vector3d
+	* @see Matrix4d
+	*/
+	struct Quaterniond
+	{
+		constexpr Quaterniond() = default;
+
+		/**
+		* Constructor with a specific value for each component
+		*
+		* @param x		Vectorial imaginary part X
+		* @param y		Vectorial imaginary part Y
+		* @param z		Vectorial imaginary part Z
+		* @param w		Real part
+		*/
+		constexpr Quaterniond(const double x, const double y, const double z, const double w) : X(x), Y(y), Z(z), W(w) {}
+
+		/**
+		* Constructor widening a Quaternion, exactly
+		*
+		* @param other	Quaternion to widen
+		*/
+		explicit constexpr Quaterniond(const Quaternion& other) : X(other.X), Y(other.Y), Z(other.Z), W(other.W) {}
+
+		/**
+		* Round this Quaterniond to a Quaternion
+		*
+		* @return		The nearest Quaternion
+		*/
+		[[nodiscard]] constexpr Quaternion ToQuaternion() const { return Quaternion(static_cast<float>(X), static_cast<float>(Y), static_cast<float>(Z), static_cast<float>(W)); }
+
+		[[nodiscard]] constexpr bool operator==(const Quaterniond& other) const { return X == other.X && Y == other.Y && Z == other.Z && W == other.W; }
+		[[nodiscard]] constexpr bool operator!=(const Quaterniond& other) const { return !(*this == other); }
+
+		/**
+		* Compose two rotations, same formula as Quaternion::operator*
+		*
+		* @param other	Rotation applied first
+		* @return		The combined rotation
+		*/
+		[[nodiscard]] constexpr Quaterniond operator*(const Quaterniond& other) const
+		{
+			return Quaterniond((Y * other.Z) - (Z * other.Y) + (W * other.X) + (other.W * X),
+				(Z * other.X) - (X * other.Z) + (W * other.Y) + (other.W * Y),
+				(X * other.Y) - (Y * other.X) + (W * other.Z) + (other.W * Z),
+				(W * other.W) - (X * other.X) - (Y * other.Y) - (Z * other.Z));
+		}
+
+		[[nodiscard]] constexpr double DotProduct(const Quaterniond& other) const { return X * other.X + Y * other.Y + Z * other.Z + W * other.W; }
+		[[nodiscard]] constexpr Quaterniond GetConjugate() const { return Quaterniond(-X, -Y, -Z, W); }
+
+		/**
+		* Normalize this Quaterniond, a zero quaternion becoming the identity
+		*/
+		void Normalize()
+		{
+			const double norm = std::sqrt(DotProduct(*this));
+			if (norm > 0.0)
+			{
+				const double inverseNorm = 1.0 / norm;
+				X *= inverseNorm;
+				Y *= inverseNorm;
+				Z *= inverseNorm;
+				W *= inverseNorm;
+			}
+			else
+			{
+				*this = Quaterniond();
+			}
+		}
+
+		[[nodiscard]] Quaterniond GetNormalize() const { Quaterniond result(*this); result.Normalize(); return result; }
+
+		/**
+		* Rotate a vector by this unit quaternion: v + 2w (q x v) + 2 q x (q x v)
+		*
+		* @param vector	Vector to rotate
+		* @return		The rotated vector
+		*/
+		[[nodiscard]] constexpr Vector3d Rotate(const Vector3d& vector) const
+		{
+			const Vector3d imaginary(X, Y, Z);
+			const Vector3d twiceCross = imaginary.Cross(vector) * 2.0;
+			return vector + twiceCross * W + imaginary.Cross(twiceCross);
+		}
+
+		double X = 0.0;/**< Vectorial imaginary part X*/
+		double Y = 0.0;/**< Vectorial imaginary part Y*/
+		double Z = 0.0;/**< Vectorial imaginary part Z*/
+		double W = 1.0;/**< Real Part*/
+	};
+
+	static_assert(sizeof(Quaterniond) == 4 * sizeof(double), "Quaterniond must stay tightly packed");
+}
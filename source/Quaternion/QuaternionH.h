@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Core/Half.h"
+#include "Quaternion/Quaternion.h"
+
+namespace LibMath
+{
+	/**
+	* Quaternion stored with half precision components, 8 bytes instead of 16.
+	* <p>
+	* Half precision keeps about 3 significant digits per component, the widened
+	* Quaternion should be normalized before being used as a rotation.
+	*
+	* @see Vector3H
+	*/
+	struct QuaternionH
+	{
+		QuaternionH() = default;
+
+		/**
+		* Constructor rounding a Quaternion to half precision
+		*
+		* @param other	Quaternion to store
+		*/
+		explicit QuaternionH(const Quaternion& other) : X(other.X), Y(other.Y), Z(other.Z), W(other.W) {}
+
+		/**
+		* Widen this QuaternionH to a Quaternion, exactly
+		*
+		* @return		The Quaternion stored
+		*/
+		[[nodiscard]] Quaternion ToQuaternion() const { return Quaternion(static_cast<float>(X), static_cast<float>(Y), static_cast<float>(Z), static_cast<float>(W)); }
+
+		Half X;/**< Vectorial imaginary part X*/
+		Half Y;/**< Vectorial imaginary part Y*/
+		Half Z;/**< Vectorial imaginary part Z*/
+		Half W = Half(1.f);/**< Real Part*/
+	};
+
+	static_assert(sizeof(QuaternionH) == 4 * sizeof(Half), "QuaternionH must stay tightly packed to be converted in batches");
+	static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Batched conversions expect tightly packed Quaternion");
+
+	/*
+	* @name Batched conversions between arrays of Quaternion and their half precision storage, with F16C when the CPU has it
+	*/
+	/*@{*/
+	inline void ConvertToHalf(const Quaternion* input, QuaternionH* output, const size_t count) { ConvertToHalf(&input->X, &output->X, count * 4); }
+	inline void ConvertToFloat(const QuaternionH* input, Quaternion* output, const size_t count) { ConvertToFloat(&input->X, &output->X, count * 4); }
+	/*@}*/
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <limits>
+
+#include "Vector/Vector3.h"
+
+namespace LibMath
+{
+	/**
+	* Axis aligned bounding box described by its minimum and maximum corners.
+	* <p>
+	* The default box is empty: its minimum is +infinity and its maximum -infinity,
+	* so extending it with a first point gives a box reduced to that point.
+	*/
+	struct AABB
+	{
+		/**
+		* Default constructor. Creates an empty box.
+		*/
+		constexpr AABB() = default;
+
+		/**
+		* Constructor from the two corners of the box
+		*
+		* @param minimum	Corner with the smallest coordinates
+		* @param maximum	Corner with the largest coordinates
+		*/
+		constexpr AABB(const Vector3& minimum, const Vector3& maximum) : min(minimum), max(maximum) {}
+
+		/**
+		* Check if the box contains at least one point
+		*
+		* @return		True if min is lower or equal to max on every axis
+		*/
+		[[nodiscard]] constexpr bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+		/**
+		* Grow the box to contain a point
+		*
+		* @param point	Point to include
+		*/
+		constexpr void Extend(const Vector3& point)
+		{
+			min = Vector3(point.x < min.x ? point.x : min.x, point.y < min.y ? point.y : min.y, point.z < min.z ? point.z : min.z);
+			max = Vector3(point.x > max.x ? point.x : max.x, point.y > max.y ? point.y : max.y, point.z > max.z ? point.z : max.z);
+		}
+
+		/**
+		* Grow the box to contain an other box
+		*
+		* @param other	Box to include
+		*/
+		constexpr void Merge(const AABB& other)
+		{
+			min = Vector3(other.min.x < min.x ? other.min.x : min.x, other.min.y < min.y ? other.min.y : min.y, other.min.z < min.z ? other.min.z : min.z);
+			max = Vector3(other.max.x > max.x ? other.max.x : max.x, other.max.y > max.y ? other.max.y : max.y, other.max.z > max.z ? other.max.z : max.z);
+		}
+
+		/**
+		* Check if a point is inside the box, borders included
+		*
+		* @param point	Point to test
+		* @return		True if the point is inside the box
+		*/
+		[[nodiscard]] constexpr bool Contains(const Vector3& point) const
+		{
+			return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y && point.z >= min.z && point.z <= max.z;
+		}
+
+		[[nodiscard]] constexpr Vector3 GetCenter() const { return (min + max) * .5f; }
+		[[nodiscard]] constexpr Vector3 GetSize() const { return max - min; }
+		[[nodiscard]] constexpr Vector3 GetExtents() const { return (max - min) * .5f; }
+
+		/*
+		* @name Corners
+		*/
+		/*@{*/
+		Vector3 min = Vector3(std::numeric_limits<float>::infinity());/**< corner with the smallest coordinates*/
+		Vector3 max = Vector3(-std::numeric_limits<float>::infinity());/**< corner with the largest coordinates*/
+		/*@}*/
+	};
+}
@@ -0,0 +1,390 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+#include "Spatial/Frustum.h"
+#include "Vector/Vector3SoA.h"
+
+namespace LibMath::Culling
+{
+	namespace
+	{
+		/**
+		 * @brief Mask words filled by a thread before it is worth splitting the work, 16k objects.
+		 */
+		constexpr size_t PARALLEL_CULL_WORD_COUNT = 1 << 9;
+
+		uint32_t CountTrailingZeros(const uint32_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return index;
+#else
+			return static_cast<uint32_t>(__builtin_ctz(value));
+#endif
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Planes of a frustum, each component broadcast to every lane.
+		 */
+		struct BroadcastFrustum
+		{
+			explicit BroadcastFrustum(const Frustum& frustum)
+			{
+				const __m128 absoluteMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+				for (size_t plane = 0; plane < Frustum::PLANE_COUNT; plane++)
+				{
+					x[plane] = _mm_set1_ps(frustum.planes[plane].x);
+					y[plane] = _mm_set1_ps(frustum.planes[plane].y);
+					z[plane] = _mm_set1_ps(frustum.planes[plane].z);
+					w[plane] = _mm_set1_ps(frustum.planes[plane].w);
+					absoluteX[plane] = _mm_and_ps(x[plane], absoluteMask);
+					absoluteY[plane] = _mm_and_ps(y[plane], absoluteMask);
+					absoluteZ[plane] = _mm_and_ps(z[plane], absoluteMask);
+				}
+			}
+
+			__m128 x[Frustum::PLANE_COUNT];
+			__m128 y[Frustum::PLANE_COUNT];
+			__m128 z[Frustum::PLANE_COUNT];
+			__m128 w[Frustum::PLANE_COUNT];
+			__m128 absoluteX[Frustum::PLANE_COUNT];
+			__m128 absoluteY[Frustum::PLANE_COUNT];
+			__m128 absoluteZ[Frustum::PLANE_COUNT];
+		};
+
+		/**
+		 * @brief Signed distances of four points to a plane, summed in the same order as Frustum::Distance().
+		 */
+		__m128 Distance(const BroadcastFrustum& frustum, const size_t plane, const __m128 x, const __m128 y, const __m128 z)
+		{
+			__m128 distance = _mm_mul_ps(frustum.x[plane], x);
+			distance = _mm_add_ps(distance, _mm_mul_ps(frustum.y[plane], y));
+			distance = _mm_add_ps(distance, _mm_mul_ps(frustum.z[plane], z));
+			return _mm_add_ps(distance, frustum.w[plane]);
+		}
+#endif
+
+		/**
+		 * @brief Spheres read by the culling loop.
+		 */
+		struct Spheres
+		{
+			const float* x;
+			const float* y;
+			const float* z;
+			const float* radii;
+
+			[[nodiscard]] bool Test(const Frustum& frustum, const size_t index) const
+			{
+				return frustum.IntersectsSphere(Vector3(x[index], y[index], z[index]), radii[index]);
+			}
+
+#if LIBMATH_SSE
+			/**
+			 * @return One bit per sphere of [index, index + 4), set when the sphere may be visible
+			 */
+			[[nodiscard]] uint32_t Test(const BroadcastFrustum& frustum, const size_t index) const
+			{
+				const __m128 centerX = _mm_loadu_ps(x + index);
+				const __m128 centerY = _mm_loadu_ps(y + index);
+				const __m128 centerZ = _mm_loadu_ps(z + index);
+				const __m128 negativeRadius = _mm_xor_ps(_mm_loadu_ps(radii + index), _mm_set1_ps(-0.f));
+
+				__m128 culled = _mm_setzero_ps();
+				for (size_t plane = 0; plane < Frustum::PLANE_COUNT; plane++)
+				{
+					culled = _mm_or_ps(culled, _mm_cmplt_ps(Distance(frustum, plane, centerX, centerY, centerZ), negativeRadius));
+				}
+				return static_cast<uint32_t>(~_mm_movemask_ps(culled) & 0xF);
+			}
+
+			/**
+			 * @return One bit per sphere of [index, index + 8), set when the sphere may be visible
+			 */
+			LIBMATH_TARGET("avx")
+			[[nodiscard]] uint32_t TestWide(const Frustum& frustum, const size_t index) const
+			{
+				const __m256 centerX = _mm256_loadu_ps(x + index);
+				const __m256 centerY = _mm256_loadu_ps(y + index);
+				const __m256 centerZ = _mm256_loadu_ps(z + index);
+				const __m256 negativeRadius = _mm256_xor_ps(_mm256_loadu_ps(radii + index), _mm256_set1_ps(-0.f));
+
+				__m256 culled = _mm256_setzero_ps();
+				for (const Vector4& plane : frustum.planes)
+				{
+					__m256 distance = _mm256_mul_ps(_mm256_broadcast_ss(&plane.x), centerX);
+					distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_broadcast_ss(&plane.y), centerY));
+					distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_broadcast_ss(&plane.z), centerZ));
+					distance = _mm256_add_ps(distance, _mm256_broadcast_ss(&plane.w));
+					culled = _mm256_or_ps(culled, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+				}
+				return static_cast<uint32_t>(~_mm256_movemask_ps(culled) & 0xFF);
+			}
+#endif
+		};
+
+		/**
+		 * @brief Boxes read by the culling loop, tested as a center and half extents.
+		 */
+		struct Boxes
+		{
+			const float* minimumX;
+			const float* minimumY;
+			const float* minimumZ;
+			const float* maximumX;
+			const float* maximumY;
+			const float* maximumZ;
+
+			[[nodiscard]] bool Test(const Frustum& frustum, const size_t index) const
+			{
+				return frustum.IntersectsAABB(AABB(Vector3(minimumX[index], minimumY[index], minimumZ[index]), Vector3(maximumX[index], maximumY[index], maximumZ[index])));
+			}
+
+#if LIBMATH_SSE
+			/**
+			 * @return One bit per box of [index, index + 4), set when the box may be visible
+			 */
+			[[nodiscard]] uint32_t Test(const BroadcastFrustum& frustum, const size_t index) const
+			{
+				const __m128 half = _mm_set1_ps(.5f);
+				const __m128 signMask = _mm_set1_ps(-0.f);
+				const __m128 minX = _mm_loadu_ps(minimumX + index);
+				const __m128 minY = _mm_loadu_ps(minimumY + index);
+				const __m128 minZ = _mm_loadu_ps(minimumZ + index);
+				const __m128 maxX = _mm_loadu_ps(maximumX + index);
+				const __m128 maxY = _mm_loadu_ps(maximumY + index);
+				const __m128 maxZ = _mm_loadu_ps(maximumZ + index);
+
+				const __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+				const __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+				const __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+				const __m128 extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+				const __m128 extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+				const __m128 extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+				__m128 culled = _mm_setzero_ps();
+				for (size_t plane = 0; plane < Frustum::PLANE_COUNT; plane++)
+				{
+					__m128 radius = _mm_mul_ps(frustum.absoluteX[plane], extentX);
+					radius = _mm_add_ps(radius, _mm_mul_ps(frustum.absoluteY[plane], extentY));
+					radius = _mm_add_ps(radius, _mm_mul_ps(frustum.absoluteZ[plane], extentZ));
+
+					const __m128 distance = Distance(frustum, plane, centerX, centerY, centerZ);
+					culled = _mm_or_ps(culled, _mm_cmplt_ps(distance, _mm_xor_ps(radius, signMask)));
+				}
+				return static_cast<uint32_t>(~_mm_movemask_ps(culled) & 0xF);
+			}
+
+			/**
+			 * @return One bit per box of [index, index + 8), set when the box may be visible
+			 */
+			LIBMATH_TARGET("avx")
+			[[nodiscard]] uint32_t TestWide(const Frustum& frustum, const size_t index) const
+			{
+				const __m256 half = _mm256_set1_ps(.5f);
+				const __m256 signMask = _mm256_set1_ps(-0.f);
+				const __m256 minX = _mm256_loadu_ps(minimumX + index);
+				const __m256 minY = _mm256_loadu_ps(minimumY + index);
+				const __m256 minZ = _mm256_loadu_ps(minimumZ + index);
+				const __m256 maxX = _mm256_loadu_ps(maximumX + index);
+				const __m256 maxY = _mm256_loadu_ps(maximumY + index);
+				const __m256 maxZ = _mm256_loadu_ps(maximumZ + index);
+
+				const __m256 centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+				const __m256 centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+				const __m256 centerZ = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+				const __m256 extentX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+				const __m256 extentY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+				const __m256 extentZ = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+				__m256 culled = _mm256_setzero_ps();
+				for (const Vector4& plane : frustum.planes)
+				{
+					const __m256 planeX = _mm256_broadcast_ss(&plane.x);
+					const __m256 planeY = _mm256_broadcast_ss(&plane.y);
+					const __m256 planeZ = _mm256_broadcast_ss(&plane.z);
+
+					__m256 radius = _mm256_mul_ps(_mm256_andnot_ps(signMask, planeX), extentX);
+					radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_andnot_ps(signMask, planeY), extentY));
+					radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_andnot_ps(signMask, planeZ), extentZ));
+
+					__m256 distance = _mm256_mul_ps(planeX, centerX);
+					distance = _mm256_add_ps(distance, _mm256_mul_ps(planeY, centerY));
+					distance = _mm256_add_ps(distance, _mm256_mul_ps(planeZ, centerZ));
+					distance = _mm256_add_ps(distance, _mm256_broadcast_ss(&plane.w));
+					culled = _mm256_or_ps(culled, _mm256_cmp_ps(distance, _mm256_xor_ps(radius, signMask), _CMP_LT_OQ));
+				}
+				return static_cast<uint32_t>(~_mm256_movemask_ps(culled) & 0xFF);
+			}
+#endif
+		};
+
+		/**
+		 * @brief Visibility of the volumes [index, end) of a word, tested one by one.
+		 */
+		template <class Volumes>
+		uint32_t CullScalar(const Frustum& frustum, const Volumes& volumes, const size_t begin, size_t index, const size_t end)
+		{
+			uint32_t bits = 0;
+			for (; index < end; index++)
+			{
+				bits |= static_cast<uint32_t>(volumes.Test(frustum, index)) << (index - begin);
+			}
+			return bits;
+		}
+
+		/*
+		 * @name Fill the mask words [wordBegin, wordEnd) of every frustum, the volumes of a word staying in cache for all the frustums
+		 */
+		/*@{*/
+#if LIBMATH_SSE
+		template <class Volumes>
+		void CullWordsSSE(const Frustum* frustums, const BroadcastFrustum* broadcastFrustums, const size_t frustumCount, const Volumes& volumes, const size_t count,
+			const size_t wordBegin, const size_t wordEnd, uint32_t* outMasks)
+		{
+			const size_t wordCount = MaskWordCount(count);
+
+			for (size_t word = wordBegin; word < wordEnd; word++)
+			{
+				const size_t begin = word * 32;
+				const size_t end = std::min(count, begin + 32);
+
+				for (size_t frustum = 0; frustum < frustumCount; frustum++)
+				{
+					uint32_t bits = 0;
+					size_t i = begin;
+					for (; i + 4 <= end; i += 4)
+					{
+						bits |= volumes.Test(broadcastFrustums[frustum], i) << (i - begin);
+					}
+					outMasks[frustum * wordCount + word] = bits | CullScalar(frustums[frustum], volumes, begin, i, end);
+				}
+			}
+		}
+
+		template <class Volumes>
+		LIBMATH_TARGET("avx")
+		void CullWordsAVX(const Frustum* frustums, const size_t frustumCount, const Volumes& volumes, const size_t count,
+			const size_t wordBegin, const size_t wordEnd, uint32_t* outMasks)
+		{
+			const size_t wordCount = MaskWordCount(count);
+
+			for (size_t word = wordBegin; word < wordEnd; word++)
+			{
+				const size_t begin = word * 32;
+				const size_t end = std::min(count, begin + 32);
+
+				for (size_t frustum = 0; frustum < frustumCount; frustum++)
+				{
+					uint32_t bits = 0;
+					size_t i = begin;
+					for (; i + 8 <= end; i += 8)
+					{
+						bits |= volumes.TestWide(frustums[frustum], i) << (i - begin);
+					}
+					outMasks[frustum * wordCount + word] = bits | CullScalar(frustums[frustum], volumes, begin, i, end);
+				}
+			}
+		}
+#else
+		template <class Volumes>
+		void CullWordsScalar(const Frustum* frustums, const size_t frustumCount, const Volumes& volumes, const size_t count,
+			const size_t wordBegin, const size_t wordEnd, uint32_t* outMasks)
+		{
+			const size_t wordCount = MaskWordCount(count);
+
+			for (size_t word = wordBegin; word < wordEnd; word++)
+			{
+				const size_t begin = word * 32;
+				const size_t end = std::min(count, begin + 32);
+
+				for (size_t frustum = 0; frustum < frustumCount; frustum++)
+				{
+					outMasks[frustum * wordCount + word] = CullScalar(frustums[frustum], volumes, begin, begin, end);
+				}
+			}
+		}
+#endif
+		/*@}*/
+
+		template <class Volumes>
+		void Cull(const Frustum* frustums, const size_t frustumCount, const Volumes& volumes, const size_t count, uint32_t* outMasks)
+		{
+#if LIBMATH_SSE
+			if (SIMD::HasAVX2())
+			{
+				Parallel::For(MaskWordCount(count), PARALLEL_CULL_WORD_COUNT, [&](const size_t wordBegin, const size_t wordEnd)
+				{
+					CullWordsAVX(frustums, frustumCount, volumes, count, wordBegin, wordEnd, outMasks);
+				});
+				return;
+			}
+
+			std::vector<BroadcastFrustum> broadcastFrustums;
+			broadcastFrustums.reserve(frustumCount);
+			for (size_t frustum = 0; frustum < frustumCount; frustum++)
+			{
+				broadcastFrustums.emplace_back(frustums[frustum]);
+			}
+
+			Parallel::For(MaskWordCount(count), PARALLEL_CULL_WORD_COUNT, [&](const size_t wordBegin, const size_t wordEnd)
+			{
+				CullWordsSSE(frustums, broadcastFrustums.data(), frustumCount, volumes, count, wordBegin, wordEnd, outMasks);
+			});
+#else
+			Parallel::For(MaskWordCount(count), PARALLEL_CULL_WORD_COUNT, [&](const size_t wordBegin, const size_t wordEnd)
+			{
+				CullWordsScalar(frustums, frustumCount, volumes, count, wordBegin, wordEnd, outMasks);
+			});
+#endif
+		}
+	}
+
+	void CullSpheres(const Frustum& frustum, const Vector3SoA& centers, const float* radii, uint32_t* outMask)
+	{
+		CullSpheres(&frustum, 1, centers, radii, outMask);
+	}
+
+	void CullSpheres(const Frustum* frustums, const size_t frustumCount, const Vector3SoA& centers, const float* radii, uint32_t* outMasks)
+	{
+		Cull(frustums, frustumCount, Spheres{ centers.X(), centers.Y(), centers.Z(), radii }, centers.Size(), outMasks);
+	}
+
+	void CullAABBs(const Frustum& frustum, const Vector3SoA& minimums, const Vector3SoA& maximums, uint32_t* outMask)
+	{
+		CullAABBs(&frustum, 1, minimums, maximums, outMask);
+	}
+
+	void CullAABBs(const Frustum* frustums, const size_t frustumCount, const Vector3SoA& minimums, const Vector3SoA& maximums, uint32_t* outMasks)
+	{
+		Cull(frustums, frustumCount, Boxes{ minimums.X(), minimums.Y(), minimums.Z(), maximums.X(), maximums.Y(), maximums.Z() }, minimums.Size(), outMasks);
+	}
+
+	size_t CompactMask(const uint32_t* mask, const size_t count, uint32_t* outIndices)
+	{
+		size_t written = 0;
+
+		for (size_t word = 0; word < MaskWordCount(count); word++)
+		{
+			uint32_t bits = mask[word];
+			while (bits != 0)
+			{
+				outIndices[written++] = static_cast<uint32_t>(word * 32 + CountTrailingZeros(bits));
+				bits &= bits - 1;
+			}
+		}
+
+		return written;
+	}
+}
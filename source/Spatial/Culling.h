@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Core/BitMask.h"
+
+namespace LibMath
+{
+	struct Frustum;
+	class Vector3SoA;
+
+	/**
+	 * @brief Kernels testing arrays of bounding volumes against frustums.
+	 * The results are visibility bitmasks: bit (i % 32) of word (i / 32) is set when object i may be visible,
+	 * the unused bits of the last word are cleared, MaskWordCount() (Core/BitMask.h) gives the words per mask. CompactMask() turns a mask into a list of indices.
+	 * The tests are conservative, see Frustum::IntersectsSphere().
+	 */
+	namespace Culling
+	{
+		/**
+		 * @brief Test bounding spheres against a frustum.
+		 *
+		 * @param frustum Frustum to test against
+		 * @param centers Centers of the spheres
+		 * @param radii Array of centers.Size() radii
+		 * @param outMask Array of MaskWordCount(centers.Size()) words receiving the visibility of each sphere
+		 */
+		void CullSpheres(const Frustum& frustum, const Vector3SoA& centers, const float* radii, uint32_t* outMask);
+
+		/**
+		 * @brief Test bounding spheres against several frustums, every sphere being loaded once for all the frustums.
+		 *
+		 * @param frustums Array of frustums, the views of a frame or the cascades of a shadow map
+		 * @param frustumCount Number of frustums
+		 * @param centers Centers of the spheres
+		 * @param radii Array of centers.Size() radii
+		 * @param outMasks Array of frustumCount * MaskWordCount(centers.Size()) words, the mask of frustum f starting at word f * MaskWordCount(centers.Size())
+		 */
+		void CullSpheres(const Frustum* frustums, size_t frustumCount, const Vector3SoA& centers, const float* radii, uint32_t* outMasks);
+
+		/**
+		 * @brief Test axis aligned bounding boxes against a frustum.
+		 *
+		 * @param frustum Frustum to test against
+		 * @param minimums Corners with the smallest coordinates
+		 * @param maximums Corners with the largest coordinates, as many as minimums
+		 * @param outMask Array of MaskWordCount(minimums.Size()) words receiving the visibility of each box
+		 */
+		void CullAABBs(const Frustum& frustum, const Vector3SoA& minimums, const Vector3SoA& maximums, uint32_t* outMask);
+
+		/**
+		 * @brief Test axis aligned bounding boxes against several frustums, every box being loaded once for all the frustums.
+		 *
+		 * @param frustums Array of frustums
+		 * @param frustumCount Number of frustums
+		 * @param minimums Corners with the smallest coordinates
+		 * @param maximums Corners with the largest coordinates, as many as minimums
+		 * @param outMasks Array of frustumCount * MaskWordCount(minimums.Size()) words, the mask of frustum f starting at word f * MaskWordCount(minimums.Size())
+		 */
+		void CullAABBs(const Frustum* frustums, size_t frustumCount, const Vector3SoA& minimums, const Vector3SoA& maximums, uint32_t* outMasks);
+
+		/**
+		 * @brief Write the indices of the set bits of a mask, in increasing order.
+		 *
+		 * @param mask Array of MaskWordCount(count) words
+		 * @param count Number of objects covered by the mask
+		 * @param outIndices Array receiving the indices, large enough for count indices
+		 * @return Number of indices written
+		 */
+		size_t CompactMask(const uint32_t* mask, size_t count, uint32_t* outIndices);
+	}
+}
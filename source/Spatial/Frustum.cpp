@@ -0,0 +1,36 @@
+#include "Frustum.h"
+
+namespace LibMath
+{
+	Frustum::Frustum(const Matrix4& viewProjection)
+	{
+		// Row r of the column-major matrix, clip = row * position
+		const auto row = [&viewProjection](const int r)
+		{
+			return Vector4(viewProjection.raw[r], viewProjection.raw[4 + r], viewProjection.raw[8 + r], viewProjection.raw[12 + r]);
+		};
+
+		const Vector4 x = row(0);
+		const Vector4 y = row(1);
+		const Vector4 z = row(2);
+		const Vector4 w = row(3);
+
+		// -w <= x <= w and so on, each inequality giving w + x >= 0 or w - x >= 0
+		planes[PLANE_LEFT] = Vector4(w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w);
+		planes[PLANE_RIGHT] = Vector4(w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w);
+		planes[PLANE_BOTTOM] = Vector4(w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w);
+		planes[PLANE_TOP] = Vector4(w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w);
+		planes[PLANE_NEAR] = Vector4(w.x + z.x, w.y + z.y, w.z + z.z, w.w + z.w);
+		planes[PLANE_FAR] = Vector4(w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w);
+
+		for (Vector4& plane : planes)
+		{
+			const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (length > 0.f)
+			{
+				const float inverseLength = 1.f / length;
+				plane = Vector4(plane.x * inverseLength, plane.y * inverseLength, plane.z * inverseLength, plane.w * inverseLength);
+			}
+		}
+	}
+}
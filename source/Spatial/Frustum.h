@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "Matrix/Matrix4.h"
+#include "Spatial/AABB.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector4.h"
+
+namespace LibMath
+{
+	/**
+	* View volume described by six planes whose normals point inside.
+	* <p>
+	* Each plane is stored as a Vector4 (normal x, normal y, normal z, distance) with a unit normal, so
+	* normal.Dot(point) + distance is the signed distance of the point to the plane: positive inside.
+	* The planes are extracted from a view-projection matrix following the clip space of
+	* Matrix4::Perspective() and Matrix4::Orthographic(): -w <= x, y, z <= w.
+	*/
+	struct Frustum
+	{
+		enum PlaneIndex : size_t
+		{
+			PLANE_LEFT,
+			PLANE_RIGHT,
+			PLANE_BOTTOM,
+			PLANE_TOP,
+			PLANE_NEAR,
+			PLANE_FAR,
+			PLANE_COUNT
+		};
+
+		/**
+		* Default constructor. Every plane is zero, so every test succeeds.
+		*/
+		constexpr Frustum() = default;
+
+		/**
+		* Constructor extracting the planes of a projection or view-projection matrix
+		*
+		* @param viewProjection	Matrix transforming world positions to clip space
+		*/
+		explicit Frustum(const Matrix4& viewProjection);
+
+		/**
+		* Signed distance of a point to one of the planes
+		*
+		* @param plane	Index of the plane
+		* @param point	Point to measure
+		* @return		Distance to the plane, positive on the inner side
+		*/
+		[[nodiscard]] constexpr float Distance(const size_t plane, const Vector3& point) const
+		{
+			return planes[plane].x * point.x + planes[plane].y * point.y + planes[plane].z * point.z + planes[plane].w;
+		}
+
+		/**
+		* Check if a point is inside the frustum, borders included
+		*
+		* @param point	Point to test
+		* @return		True if the point is on the inner side of every plane
+		*/
+		[[nodiscard]] constexpr bool Contains(const Vector3& point) const
+		{
+			for (size_t plane = 0; plane < PLANE_COUNT; plane++)
+				if (Distance(plane, point) < 0.f)
+					return false;
+
+			return true;
+		}
+
+		/**
+		* Check if a sphere may be visible. Spheres close to a corner outside of the frustum
+		* can be reported visible, spheres reported outside are never visible.
+		*
+		* @param center	Center of the sphere
+		* @param radius	Radius of the sphere
+		* @return		False if the sphere is entirely behind one of the planes
+		*/
+		[[nodiscard]] constexpr bool IntersectsSphere(const Vector3& center, const float radius) const
+		{
+			for (size_t plane = 0; plane < PLANE_COUNT; plane++)
+				if (Distance(plane, center) < -radius)
+					return false;
+
+			return true;
+		}
+
+		/**
+		* Check if a box may be visible, with the same conservative behavior as IntersectsSphere()
+		*
+		* @param box	Box to test
+		* @return		False if the box is entirely behind one of the planes
+		*/
+		[[nodiscard]] bool IntersectsAABB(const AABB& box) const
+		{
+			const Vector3 center = (box.min + box.max) * .5f;
+			const Vector3 extents = (box.max - box.min) * .5f;
+
+			for (size_t plane = 0; plane < PLANE_COUNT; plane++)
+			{
+				const float radius = std::fabs(planes[plane].x) * extents.x + std::fabs(planes[plane].y) * extents.y + std::fabs(planes[plane].z) * extents.z;
+				if (Distance(plane, center) < -radius)
+					return false;
+			}
+
+			return true;
+		}
+
+		Vector4 planes[PLANE_COUNT];/**< normal (x, y, z) pointing inside and distance (w) of each plane*/
+	};
+}
@@ -0,0 +1,560 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Core/Parallel.h"
+#include "Spatial/PointTraits.h"
+
+namespace LibMath
+{
+	/**
+	 * KD-tree answering nearest neighbour, k-nearest and radius queries over a fixed set of points.
+	 * <p>
+	 * The tree is laid out implicitly: points are reordered so the node covering a range
+	 * [begin, end) is the median element of that range and its children are the two halves
+	 * around it. No child pointers are stored, queries walk one contiguous array and ranges of
+	 * LEAF_SIZE points or less are scanned linearly. Every distance test works on square
+	 * distances, no sqrt is ever computed.
+	 * <p>
+	 * Indices returned by the queries are the positions of the points in the array given to Build().
+	 *
+	 * @tparam TPoint Vector3 or TVector2
+	 */
+	template <class TPoint>
+	class TKDTree
+	{
+	public:
+		using Traits = PointTraits<TPoint>;
+
+		/**
+		 * @brief Index returned when a query found no point.
+		 */
+		static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+		/**
+		 * @brief Default constructor, create an empty tree.
+		 */
+		TKDTree() = default;
+
+		/**
+		 * @brief Constructor building the tree over the given points.
+		 *
+		 * @param points Array of points, copied by the tree
+		 * @param count Number of points
+		 */
+		TKDTree(const TPoint* points, const size_t count) { Build(points, count); }
+
+		/**
+		 * @brief Replace the content of the tree by the given points. Large inputs are built in parallel.
+		 *
+		 * @param points Array of points, copied by the tree
+		 * @param count Number of points
+		 */
+		void Build(const TPoint* points, size_t count);
+
+		/**
+		 * @brief Remove every point from the tree.
+		 */
+		void Clear() { m_points.clear(); m_indices.clear(); m_axes.clear(); }
+
+		/**
+		 * @brief Number of points in the tree.
+		 */
+		[[nodiscard]] size_t Size() const { return m_points.size(); }
+
+		/**
+		 * @brief Whether or not the tree contains any point.
+		 */
+		[[nodiscard]] bool Empty() const { return m_points.empty(); }
+
+		/**
+		 * @brief Find the closest point from query.
+		 *
+		 * @param query Point to search around
+		 * @param outSquareDistance Receives the square distance to the closest point if not null
+		 * @return Index of the closest point or INVALID_INDEX if the tree is empty
+		 */
+		[[nodiscard]] uint32_t Nearest(const TPoint& query, float* outSquareDistance = nullptr) const;
+
+		/**
+		 * @brief Find the k closest points from query, sorted from the closest to the farthest.
+		 *
+		 * @param query Point to search around
+		 * @param k Number of points requested
+		 * @param outIndices Array of at least k elements receiving the indices
+		 * @param outSquareDistances Array of at least k elements receiving the square distances, can be null
+		 * @return Number of points found, min(k, Size())
+		 */
+		size_t KNearest(const TPoint& query, size_t k, uint32_t* outIndices, float* outSquareDistances = nullptr) const;
+
+		/**
+		 * @brief Call function(index, squareDistance) for every point within radius of query, in no particular order.
+		 *
+		 * @tparam Function Callable as void(uint32_t index, float squareDistance)
+		 * @param query Point to search around
+		 * @param radius Search radius, points exactly at radius are included
+		 * @param function Function called for each point found
+		 */
+		template <class Function>
+		void ForEachInRadius(const TPoint& query, const float radius, Function&& function) const
+		{
+			if (!m_points.empty())
+			{
+				RadiusRange(0, m_points.size(), query, radius * radius, function);
+			}
+		}
+
+		/**
+		 * @brief Append the index of every point within radius of query to outIndices.
+		 *
+		 * @param query Point to search around
+		 * @param radius Search radius, points exactly at radius are included
+		 * @param outIndices Vector receiving the indices
+		 * @return Number of indices appended
+		 */
+		size_t RadiusSearch(const TPoint& query, float radius, std::vector<uint32_t>& outIndices) const;
+
+		/**
+		 * @brief Nearest() for an array of queries, processed in parallel.
+		 *
+		 * @param queries Array of points to search around
+		 * @param count Number of queries
+		 * @param outIndices Array of count elements receiving the closest point indices
+		 * @param outSquareDistances Array of count elements receiving the square distances, can be null
+		 */
+		void NearestBatch(const TPoint* queries, size_t count, uint32_t* outIndices, float* outSquareDistances = nullptr) const;
+
+		/**
+		 * @brief KNearest() for an array of queries, processed in parallel. Results of query i are stored at
+		 * [i * k, (i + 1) * k), slots left empty when the tree holds less than k points are set to
+		 * INVALID_INDEX and infinity.
+		 *
+		 * @param queries Array of points to search around
+		 * @param count Number of queries
+		 * @param k Number of points requested per query
+		 * @param outIndices Array of count * k elements receiving the indices
+		 * @param outSquareDistances Array of count * k elements receiving the square distances, can be null
+		 */
+		void KNearestBatch(const TPoint* queries, size_t count, size_t k, uint32_t* outIndices, float* outSquareDistances = nullptr) const;
+
+		/**
+		 * @brief RadiusSearch() for an array of queries, processed in parallel. The results of query i are
+		 * outIndices[outOffsets[i]] to outIndices[outOffsets[i + 1]] (excluded).
+		 *
+		 * @param queries Array of points to search around
+		 * @param count Number of queries
+		 * @param radius Search radius, points exactly at radius are included
+		 * @param outOffsets Replaced by the count + 1 offsets of each query results
+		 * @param outIndices Replaced by the indices found for all queries
+		 */
+		void RadiusSearchBatch(const TPoint* queries, size_t count, float radius, std::vector<uint32_t>& outOffsets, std::vector<uint32_t>& outIndices) const;
+
+	private:
+		/**
+		 * @brief Ranges with this many points or less are not split and are scanned linearly.
+		 */
+		static constexpr size_t LEAF_SIZE = 8;
+
+		/**
+		 * @brief Ranges with this many points or more build their two halves in parallel.
+		 */
+		static constexpr size_t PARALLEL_BUILD_SIZE = 1 << 15;
+
+		/**
+		 * @brief Minimum number of queries worth sending to an other thread.
+		 */
+		static constexpr size_t PARALLEL_QUERY_SIZE = 256;
+
+		struct Entry
+		{
+			TPoint point;
+			uint32_t index;
+		};
+
+		/**
+		 * @brief Bounded max-heap keeping the k closest points found so far.
+		 */
+		struct KNearestHeap
+		{
+			std::vector<std::pair<float, uint32_t>> items;
+			size_t capacity = 0;
+
+			[[nodiscard]] float WorstSquareDistance() const { return items.size() < capacity ? std::numeric_limits<float>::infinity() : items.front().first; }
+
+			void Push(const float squareDistance, const uint32_t slot)
+			{
+				if (items.size() < capacity)
+				{
+					items.emplace_back(squareDistance, slot);
+					std::push_heap(items.begin(), items.end());
+				}
+				else if (squareDistance < items.front().first)
+				{
+					std::pop_heap(items.begin(), items.end());
+					items.back() = { squareDistance, slot };
+					std::push_heap(items.begin(), items.end());
+				}
+			}
+		};
+
+		static float SquareDistance(const TPoint& first, const TPoint& second) { return static_cast<float>((first - second).SquareMagnitude()); }
+
+		void BuildRange(Entry* entries, size_t begin, size_t end);
+		void NearestRange(size_t begin, size_t end, const TPoint& query, size_t& bestSlot, float& bestSquareDistance) const;
+		void KNearestRange(size_t begin, size_t end, const TPoint& query, KNearestHeap& heap) const;
+		size_t KNearestFromHeap(const TPoint& query, size_t k, KNearestHeap& heap, uint32_t* outIndices, float* outSquareDistances) const;
+
+		template <class Function>
+		void RadiusRange(const size_t begin, const size_t end, const TPoint& query, const float squareRadius, Function& function) const
+		{
+			if (end - begin <= LEAF_SIZE)
+			{
+				for (size_t slot = begin; slot < end; slot++)
+				{
+					const float squareDistance = SquareDistance(m_points[slot], query);
+					if (squareDistance <= squareRadius)
+					{
+						function(m_indices[slot], squareDistance);
+					}
+				}
+				return;
+			}
+
+			const size_t mid = begin + (end - begin) / 2;
+			const float squareDistance = SquareDistance(m_points[mid], query);
+			if (squareDistance <= squareRadius)
+			{
+				function(m_indices[mid], squareDistance);
+			}
+
+			const float planeDistance = Traits::Get(query, m_axes[mid]) - Traits::Get(m_points[mid], m_axes[mid]);
+			if (planeDistance <= 0.f || planeDistance * planeDistance <= squareRadius)
+			{
+				RadiusRange(begin, mid, query, squareRadius, function);
+			}
+			if (planeDistance >= 0.f || planeDistance * planeDistance <= squareRadius)
+			{
+				RadiusRange(mid + 1, end, query, squareRadius, function);
+			}
+		}
+
+		/*
+		* @name Tree storage, all indexed by tree slot
+		*/
+		/*@{*/
+		std::vector<TPoint> m_points;/**< points in tree order*/
+		std::vector<uint32_t> m_indices;/**< original index of each point*/
+		std::vector<uint8_t> m_axes;/**< split axis of the node stored at each slot*/
+		/*@}*/
+	};
+
+	template <class TPoint>
+	void TKDTree<TPoint>::Build(const TPoint* points, const size_t count)
+	{
+		std::vector<Entry> entries(count);
+		Parallel::For(count, PARALLEL_BUILD_SIZE, [&](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				entries[i] = { points[i], static_cast<uint32_t>(i) };
+			}
+		});
+
+		m_axes.assign(count, 0);
+		if (count > 0)
+		{
+			BuildRange(entries.data(), 0, count);
+		}
+
+		m_points.resize(count);
+		m_indices.resize(count);
+		Parallel::For(count, PARALLEL_BUILD_SIZE, [&](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				m_points[i] = entries[i].point;
+				m_indices[i] = entries[i].index;
+			}
+		});
+	}
+
+	template <class TPoint>
+	void TKDTree<TPoint>::BuildRange(Entry* entries, const size_t begin, const size_t end)
+	{
+		if (end - begin <= LEAF_SIZE)
+		{
+			return;
+		}
+
+		// Split along the axis with the widest spread
+		float minimum[Traits::Dimension];
+		float maximum[Traits::Dimension];
+		for (int axis = 0; axis < Traits::Dimension; axis++)
+		{
+			minimum[axis] = maximum[axis] = Traits::Get(entries[begin].point, axis);
+		}
+		for (size_t i = begin + 1; i < end; i++)
+		{
+			for (int axis = 0; axis < Traits::Dimension; axis++)
+			{
+				const float value = Traits::Get(entries[i].point, axis);
+				minimum[axis] = std::min(minimum[axis], value);
+				maximum[axis] = std::max(maximum[axis], value);
+			}
+		}
+
+		int splitAxis = 0;
+		for (int axis = 1; axis < Traits::Dimension; axis++)
+		{
+			if (maximum[axis] - minimum[axis] > maximum[splitAxis] - minimum[splitAxis])
+			{
+				splitAxis = axis;
+			}
+		}
+
+		const size_t mid = begin + (end - begin) / 2;
+		std::nth_element(entries + begin, entries + mid, entries + end, [splitAxis](const Entry& lhs, const Entry& rhs)
+		{
+			return Traits::Get(lhs.point, splitAxis) < Traits::Get(rhs.point, splitAxis);
+		});
+		m_axes[mid] = static_cast<uint8_t>(splitAxis);
+
+		if (end - begin >= PARALLEL_BUILD_SIZE)
+		{
+			Parallel::Invoke([=] { BuildRange(entries, begin, mid); }, [=] { BuildRange(entries, mid + 1, end); });
+		}
+		else
+		{
+			BuildRange(entries, begin, mid);
+			BuildRange(entries, mid + 1, end);
+		}
+	}
+
+	template <class TPoint>
+	uint32_t TKDTree<TPoint>::Nearest(const TPoint& query, float* outSquareDistance) const
+	{
+		size_t bestSlot = m_points.size();
+		float bestSquareDistance = std::numeric_limits<float>::infinity();
+
+		if (!m_points.empty())
+		{
+			NearestRange(0, m_points.size(), query, bestSlot, bestSquareDistance);
+		}
+
+		if (outSquareDistance)
+		{
+			*outSquareDistance = bestSquareDistance;
+		}
+
+		return bestSlot < m_points.size() ? m_indices[bestSlot] : INVALID_INDEX;
+	}
+
+	template <class TPoint>
+	void TKDTree<TPoint>::NearestRange(const size_t begin, const size_t end, const TPoint& query, size_t& bestSlot, float& bestSquareDistance) const
+	{
+		if (end - begin <= LEAF_SIZE)
+		{
+			for (size_t slot = begin; slot < end; slot++)
+			{
+				const float squareDistance = SquareDistance(m_points[slot], query);
+				if (squareDistance < bestSquareDistance)
+				{
+					bestSquareDistance = squareDistance;
+					bestSlot = slot;
+				}
+			}
+			return;
+		}
+
+		const size_t mid = begin + (end - begin) / 2;
+		const float squareDistance = SquareDistance(m_points[mid], query);
+		if (squareDistance < bestSquareDistance)
+		{
+			bestSquareDistance = squareDistance;
+			bestSlot = mid;
+		}
+
+		// Visit the side containing the query first, the other one only if the split plane is closer than the best match
+		const float planeDistance = Traits::Get(query, m_axes[mid]) - Traits::Get(m_points[mid], m_axes[mid]);
+		const bool queryOnLeft = planeDistance < 0.f;
+
+		if (queryOnLeft)
+		{
+			NearestRange(begin, mid, query, bestSlot, bestSquareDistance);
+		}
+		else
+		{
+			NearestRange(mid + 1, end, query, bestSlot, bestSquareDistance);
+		}
+
+		if (planeDistance * planeDistance < bestSquareDistance)
+		{
+			if (queryOnLeft)
+			{
+				NearestRange(mid + 1, end, query, bestSlot, bestSquareDistance);
+			}
+			else
+			{
+				NearestRange(begin, mid, query, bestSlot, bestSquareDistance);
+			}
+		}
+	}
+
+	template <class TPoint>
+	size_t TKDTree<TPoint>::KNearest(const TPoint& query, const size_t k, uint32_t* outIndices, float* outSquareDistances) const
+	{
+		KNearestHeap heap;
+		return KNearestFromHeap(query, k, heap, outIndices, outSquareDistances);
+	}
+
+	template <class TPoint>
+	size_t TKDTree<TPoint>::KNearestFromHeap(const TPoint& query, const size_t k, KNearestHeap& heap, uint32_t* outIndices, float* outSquareDistances) const
+	{
+		heap.items.clear();
+		heap.capacity = k;
+
+		if (k > 0 && !m_points.empty())
+		{
+			KNearestRange(0, m_points.size(), query, heap);
+		}
+
+		std::sort_heap(heap.items.begin(), heap.items.end());
+
+		const size_t found = heap.items.size();
+		for (size_t i = 0; i < found; i++)
+		{
+			outIndices[i] = m_indices[heap.items[i].second];
+			if (outSquareDistances)
+			{
+				outSquareDistances[i] = heap.items[i].first;
+			}
+		}
+
+		return found;
+	}
+
+	template <class TPoint>
+	void TKDTree<TPoint>::KNearestRange(const size_t begin, const size_t end, const TPoint& query, KNearestHeap& heap) const
+	{
+		if (end - begin <= LEAF_SIZE)
+		{
+			for (size_t slot = begin; slot < end; slot++)
+			{
+				heap.Push(SquareDistance(m_points[slot], query), static_cast<uint32_t>(slot));
+			}
+			return;
+		}
+
+		const size_t mid = begin + (end - begin) / 2;
+		heap.Push(SquareDistance(m_points[mid], query), static_cast<uint32_t>(mid));
+
+		const float planeDistance = Traits::Get(query, m_axes[mid]) - Traits::Get(m_points[mid], m_axes[mid]);
+		const bool queryOnLeft = planeDistance < 0.f;
+
+		if (queryOnLeft)
+		{
+			KNearestRange(begin, mid, query, heap);
+		}
+		else
+		{
+			KNearestRange(mid + 1, end, query, heap);
+		}
+
+		if (planeDistance * planeDistance < heap.WorstSquareDistance())
+		{
+			if (queryOnLeft)
+			{
+				KNearestRange(mid + 1, end, query, heap);
+			}
+			else
+			{
+				KNearestRange(begin, mid, query, heap);
+			}
+		}
+	}
+
+	template <class TPoint>
+	size_t TKDTree<TPoint>::RadiusSearch(const TPoint& query, const float radius, std::vector<uint32_t>& outIndices) const
+	{
+		const size_t previousSize = outIndices.size();
+		ForEachInRadius(query, radius, [&outIndices](const uint32_t index, float) { outIndices.push_back(index); });
+		return outIndices.size() - previousSize;
+	}
+
+	template <class TPoint>
+	void TKDTree<TPoint>::NearestBatch(const TPoint* queries, const size_t count, uint32_t* outIndices, float* outSquareDistances) const
+	{
+		Parallel::For(count, PARALLEL_QUERY_SIZE, [&](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				outIndices[i] = Nearest(queries[i], outSquareDistances ? outSquareDistances + i : nullptr);
+			}
+		});
+	}
+
+	template <class TPoint>
+	void TKDTree<TPoint>::KNearestBatch(const TPoint* queries, const size_t count, const size_t k, uint32_t* outIndices, float* outSquareDistances) const
+	{
+		Parallel::For(count, PARALLEL_QUERY_SIZE, [&](const size_t begin, const size_t end)
+		{
+			// One heap per range so the queries do not allocate
+			KNearestHeap heap;
+			heap.items.reserve(k);
+
+			for (size_t i = begin; i < end; i++)
+			{
+				uint32_t* indices = outIndices + i * k;
+				float* squareDistances = outSquareDistances ? outSquareDistances + i * k : nullptr;
+
+				for (size_t found = KNearestFromHeap(queries[i], k, heap, indices, squareDistances); found < k; found++)
+				{
+					indices[found] = INVALID_INDEX;
+					if (squareDistances)
+					{
+						squareDistances[found] = std::numeric_limits<float>::infinity();
+					}
+				}
+			}
+		});
+	}
+
+	template <class TPoint>
+	void TKDTree<TPoint>::RadiusSearchBatch(const TPoint* queries, const size_t count, const float radius, std::vector<uint32_t>& outOffsets, std::vector<uint32_t>& outIndices) const
+	{
+		// Fixed size chunks gather their results locally, they are then concatenated in query order
+		const size_t chunkCount = (count + PARALLEL_QUERY_SIZE - 1) / PARALLEL_QUERY_SIZE;
+		std::vector<std::vector<uint32_t>> chunkIndices(chunkCount);
+
+		outOffsets.assign(count + 1, 0);
+
+		Parallel::ForEachChunk(chunkCount, [&](const size_t chunk)
+		{
+			const size_t end = std::min(count, (chunk + 1) * PARALLEL_QUERY_SIZE);
+			for (size_t i = chunk * PARALLEL_QUERY_SIZE; i < end; i++)
+			{
+				outOffsets[i + 1] = static_cast<uint32_t>(RadiusSearch(queries[i], radius, chunkIndices[chunk]));
+			}
+		});
+
+		for (size_t i = 0; i < count; i++)
+		{
+			outOffsets[i + 1] += outOffsets[i];
+		}
+
+		outIndices.clear();
+		outIndices.reserve(outOffsets[count]);
+		for (const std::vector<uint32_t>& indices : chunkIndices)
+		{
+			outIndices.insert(outIndices.end(), indices.begin(), indices.end());
+		}
+	}
+
+	typedef TKDTree<Vector3> KDTree3;
+	typedef TKDTree<TVector2<float>> KDTree2;
+}
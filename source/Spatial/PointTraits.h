@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Vector/TVector2.h"
+#include "Vector/Vector3.h"
+
+namespace LibMath
+{
+	/**
+	 * @brief Uniform access to the coordinates of the point types the spatial structures accept.
+	 *
+	 * @tparam TPoint Vector3 or TVector2
+	 */
+	template <class TPoint>
+	struct PointTraits;
+
+	template <>
+	struct PointTraits<Vector3>
+	{
+		static constexpr int Dimension = 3;
+
+		/**
+		 * @brief Coordinate of a point on the given axis
+		 *
+		 * @param point Point to read
+		 * @param axis 0 for x, 1 for y, 2 for z
+		 * @return The coordinate
+		 */
+		static constexpr float Get(const Vector3& point, const int axis) { return axis == 0 ? point.x : axis == 1 ? point.y : point.z; }
+	};
+
+	template <class T>
+	struct PointTraits<TVector2<T>>
+	{
+		static constexpr int Dimension = 2;
+
+		/**
+		 * @brief Coordinate of a point on the given axis
+		 *
+		 * @param point Point to read
+		 * @param axis 0 for x, 1 for y
+		 * @return The coordinate
+		 */
+		static constexpr float Get(const TVector2<T>& point, const int axis) { return static_cast<float>(axis == 0 ? point.x : point.y); }
+	};
+}
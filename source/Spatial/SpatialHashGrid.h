@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Core/Parallel.h"
+#include "Spatial/PointTraits.h"
+
+namespace LibMath
+{
+	/**
+	 * Uniform grid hashed into a fixed number of buckets, suited to neighbour queries over
+	 * points of roughly uniform density (particles, crowds).
+	 * <p>
+	 * Build() assigns every point to the bucket of its cell and groups them with a counting
+	 * sort: the indices and positions of each bucket end up contiguous and bucket b spans
+	 * [BucketStart(b), BucketStart(b + 1)). Rebuilding reuses the storage of the previous
+	 * build, there is no allocation per cell and no allocation at all once the grid reached
+	 * its working size.
+	 * <p>
+	 * Different cells can share a bucket, queries filter the candidates by distance so the
+	 * results are exact. Large inputs are hashed and scattered in parallel, the order of the
+	 * points inside a bucket is then not deterministic.
+	 *
+	 * @tparam TPoint Vector3 or TVector2
+	 */
+	template <class TPoint>
+	class TSpatialHashGrid
+	{
+	public:
+		using Traits = PointTraits<TPoint>;
+
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param cellSize Edge length of a cell, usually the most common query radius
+		 * @param bucketCount Number of buckets, rounded up to a power of two. 0 picks one bucket per point at each Build()
+		 */
+		explicit TSpatialHashGrid(float cellSize, size_t bucketCount = 0);
+
+		/**
+		 * @brief Hash all the given points in the grid, replacing the previous content.
+		 *
+		 * @param points Array of points, copied by the grid
+		 * @param count Number of points
+		 */
+		void Build(const TPoint* points, size_t count);
+
+		/**
+		 * @brief Change the cell size. Only affects the next Build().
+		 *
+		 * @param cellSize Edge length of a cell
+		 */
+		void SetCellSize(const float cellSize) { m_cellSize = cellSize; m_inverseCellSize = 1.f / cellSize; }
+
+		[[nodiscard]] float GetCellSize() const { return m_cellSize; }
+		[[nodiscard]] size_t Size() const { return m_sortedIndices.size(); }
+		[[nodiscard]] size_t GetBucketCount() const { return m_bucketStart.empty() ? 0 : m_bucketStart.size() - 1; }
+
+		/**
+		 * @brief Bucket holding the cell containing a position.
+		 *
+		 * @param position Any position
+		 * @return Index of the bucket
+		 */
+		[[nodiscard]] uint32_t BucketOf(const TPoint& position) const { return Hash(CellOf(position)); }
+
+		/**
+		 * @brief First slot of a bucket, bucket b spans [BucketStart(b), BucketStart(b + 1)).
+		 *
+		 * @param bucket Index of the bucket, GetBucketCount() gives the end of the last bucket
+		 * @return Slot of the first point of the bucket
+		 */
+		[[nodiscard]] uint32_t BucketStart(const size_t bucket) const { return m_bucketStart[bucket]; }
+
+		/**
+		 * @brief Original index of the point stored at a slot.
+		 */
+		[[nodiscard]] uint32_t IndexAt(const size_t slot) const { return m_sortedIndices[slot]; }
+
+		/**
+		 * @brief Position of the point stored at a slot.
+		 */
+		[[nodiscard]] const TPoint& PointAt(const size_t slot) const { return m_sortedPoints[slot]; }
+
+		/**
+		 * @brief Call function(indices, count) for every non empty bucket, indices being the original indices of its points.
+		 * A bucket is not a cell: it holds the points of every cell hashed to it, use ForEachInCell() to visit one cell.
+		 *
+		 * @tparam Function Callable as void(const uint32_t* indices, size_t count)
+		 * @param function Function called for each bucket
+		 */
+		template <class Function>
+		void ForEachBucket(Function&& function) const
+		{
+			for (size_t bucket = 0; bucket + 1 < m_bucketStart.size(); bucket++)
+			{
+				const uint32_t begin = m_bucketStart[bucket];
+				const uint32_t end = m_bucketStart[bucket + 1];
+				if (begin != end)
+				{
+					function(m_sortedIndices.data() + begin, static_cast<size_t>(end - begin));
+				}
+			}
+		}
+
+		/**
+		 * @brief Call function(index) for every point in the cell containing position.
+		 *
+		 * @tparam Function Callable as void(uint32_t index)
+		 * @param position Any position inside the cell
+		 * @param function Function called for each point of the cell
+		 */
+		template <class Function>
+		void ForEachInCell(const TPoint& position, Function&& function) const
+		{
+			if (m_sortedIndices.empty())
+			{
+				return;
+			}
+
+			const Cell cell = CellOf(position);
+			const uint32_t bucket = Hash(cell);
+			for (uint32_t slot = m_bucketStart[bucket]; slot < m_bucketStart[bucket + 1]; slot++)
+			{
+				// Skip the points of other cells sharing this bucket
+				if (CellOf(m_sortedPoints[slot]) == cell)
+				{
+					function(m_sortedIndices[slot]);
+				}
+			}
+		}
+
+		/**
+		 * @brief Call function(index, squareDistance) for every point within radius of query, in no particular order.
+		 *
+		 * @tparam Function Callable as void(uint32_t index, float squareDistance)
+		 * @param query Point to search around
+		 * @param radius Search radius, points exactly at radius are included
+		 * @param function Function called for each point found
+		 */
+		template <class Function>
+		void ForEachInRadius(const TPoint& query, float radius, Function&& function) const;
+
+		/**
+		 * @brief Append the index of every point within radius of query to outIndices.
+		 *
+		 * @param query Point to search around
+		 * @param radius Search radius, points exactly at radius are included
+		 * @param outIndices Vector receiving the indices
+		 * @return Number of indices appended
+		 */
+		size_t RadiusSearch(const TPoint& query, const float radius, std::vector<uint32_t>& outIndices) const
+		{
+			const size_t previousSize = outIndices.size();
+			ForEachInRadius(query, radius, [&outIndices](const uint32_t index, float) { outIndices.push_back(index); });
+			return outIndices.size() - previousSize;
+		}
+
+	private:
+		/**
+		 * @brief Inputs with this many points or more are hashed and scattered in parallel.
+		 */
+		static constexpr size_t PARALLEL_BUILD_SIZE = 1 << 15;
+
+		/**
+		 * @brief Queries covering more cells than this stop tracking visited buckets and filter each point by cell instead.
+		 */
+		static constexpr size_t MAX_TRACKED_BUCKETS = 64;
+
+		/**
+		 * @brief Cell coordinates are clamped to [-MAX_CELL_COORDINATE, MAX_CELL_COORDINATE], far positions sharing the border
+		 * cells, so converting a position is always defined and walking a query box never overflows.
+		 */
+		static constexpr int32_t MAX_CELL_COORDINATE = 1 << 30;
+
+		struct Cell
+		{
+			int32_t coordinates[3] = { 0, 0, 0 };
+
+			bool operator==(const Cell& other) const { return coordinates[0] == other.coordinates[0] && coordinates[1] == other.coordinates[1] && coordinates[2] == other.coordinates[2]; }
+		};
+
+		/**
+		 * @brief Cell coordinate of a position divided by the cell size, NaN giving the lowest cell.
+		 */
+		[[nodiscard]] static int32_t CellCoordinate(const float scaledPosition)
+		{
+			const float coordinate = std::floor(scaledPosition);
+			if (!(coordinate > static_cast<float>(-MAX_CELL_COORDINATE))) return -MAX_CELL_COORDINATE;
+			if (coordinate > static_cast<float>(MAX_CELL_COORDINATE)) return MAX_CELL_COORDINATE;
+			return static_cast<int32_t>(coordinate);
+		}
+
+		[[nodiscard]] Cell CellOf(const TPoint& position) const
+		{
+			Cell cell;
+			for (int axis = 0; axis < Traits::Dimension; axis++)
+			{
+				cell.coordinates[axis] = CellCoordinate(Traits::Get(position, axis) * m_inverseCellSize);
+			}
+			return cell;
+		}
+
+		[[nodiscard]] uint32_t Hash(const Cell& cell) const
+		{
+			const uint32_t hash = static_cast<uint32_t>(cell.coordinates[0]) * 73856093u ^ static_cast<uint32_t>(cell.coordinates[1]) * 19349663u ^ static_cast<uint32_t>(cell.coordinates[2]) * 83492791u;
+			return hash & m_bucketMask;
+		}
+
+		void Resize(size_t pointCount);
+
+		float m_cellSize = 1.f;
+		float m_inverseCellSize = 1.f;
+		size_t m_requestedBucketCount = 0;
+		uint32_t m_bucketMask = 0;
+
+		/*
+		* @name Counting sort storage, kept between builds
+		*/
+		/*@{*/
+		std::vector<uint32_t> m_bucketStart;/**< first slot of each bucket, plus the total at the end*/
+		std::vector<uint32_t> m_sortedIndices;/**< original index of the point at each slot*/
+		std::vector<TPoint> m_sortedPoints;/**< position of the point at each slot*/
+		std::vector<uint32_t> m_pointBuckets;/**< bucket of each input point*/
+		std::unique_ptr<std::atomic<uint32_t>[]> m_counters;/**< per bucket counters of the parallel build*/
+		size_t m_counterCount = 0;
+		/*@}*/
+	};
+
+	template <class TPoint>
+	TSpatialHashGrid<TPoint>::TSpatialHashGrid(const float cellSize, const size_t bucketCount) :
+		m_requestedBucketCount(bucketCount)
+	{
+		SetCellSize(cellSize);
+	}
+
+	template <class TPoint>
+	void TSpatialHashGrid<TPoint>::Resize(const size_t pointCount)
+	{
+		size_t bucketCount = 1;
+		const size_t wanted = m_requestedBucketCount > 0 ? m_requestedBucketCount : pointCount;
+		while (bucketCount < wanted)
+		{
+			bucketCount <<= 1;
+		}
+
+		m_bucketMask = static_cast<uint32_t>(bucketCount - 1);
+		m_bucketStart.assign(bucketCount + 1, 0);
+		m_sortedIndices.resize(pointCount);
+		m_sortedPoints.resize(pointCount);
+		m_pointBuckets.resize(pointCount);
+	}
+
+	template <class TPoint>
+	void TSpatialHashGrid<TPoint>::Build(const TPoint* points, const size_t count)
+	{
+		Resize(count);
+		const size_t bucketCount = m_bucketStart.size() - 1;
+
+		if (count < PARALLEL_BUILD_SIZE || Parallel::ThreadCount() == 1)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				m_pointBuckets[i] = Hash(CellOf(points[i]));
+				m_bucketStart[m_pointBuckets[i] + 1]++;
+			}
+
+			for (size_t bucket = 0; bucket < bucketCount; bucket++)
+			{
+				m_bucketStart[bucket + 1] += m_bucketStart[bucket];
+			}
+
+			// Fill the buckets backward so the final starts are left in m_bucketStart
+			for (size_t i = count; i-- > 0;)
+			{
+				const uint32_t slot = --m_bucketStart[m_pointBuckets[i] + 1];
+				m_sortedIndices[slot] = static_cast<uint32_t>(i);
+				m_sortedPoints[slot] = points[i];
+			}
+
+			std::rotate(m_bucketStart.begin(), m_bucketStart.begin() + 1, m_bucketStart.end());
+			m_bucketStart[0] = 0;
+			m_bucketStart[bucketCount] = static_cast<uint32_t>(count);
+			return;
+		}
+
+		if (m_counterCount < bucketCount)
+		{
+			m_counters.reset(new std::atomic<uint32_t>[bucketCount]);
+			m_counterCount = bucketCount;
+		}
+
+		Parallel::For(bucketCount, PARALLEL_BUILD_SIZE, [this](const size_t begin, const size_t end)
+		{
+			for (size_t bucket = begin; bucket < end; bucket++)
+			{
+				m_counters[bucket].store(0, std::memory_order_relaxed);
+			}
+		});
+
+		Parallel::For(count, PARALLEL_BUILD_SIZE, [this, points](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				m_pointBuckets[i] = Hash(CellOf(points[i]));
+				m_counters[m_pointBuckets[i]].fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+
+		uint32_t total = 0;
+		for (size_t bucket = 0; bucket < bucketCount; bucket++)
+		{
+			m_bucketStart[bucket] = total;
+			total += m_counters[bucket].load(std::memory_order_relaxed);
+			m_counters[bucket].store(m_bucketStart[bucket], std::memory_order_relaxed);
+		}
+		m_bucketStart[bucketCount] = total;
+
+		Parallel::For(count, PARALLEL_BUILD_SIZE, [this, points](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const uint32_t slot = m_counters[m_pointBuckets[i]].fetch_add(1, std::memory_order_relaxed);
+				m_sortedIndices[slot] = static_cast<uint32_t>(i);
+				m_sortedPoints[slot] = points[i];
+			}
+		});
+	}
+
+	template <class TPoint>
+	template <class Function>
+	void TSpatialHashGrid<TPoint>::ForEachInRadius(const TPoint& query, const float radius, Function&& function) const
+	{
+		if (m_sortedIndices.empty() || !(radius >= 0.f))
+		{
+			return;
+		}
+
+		const float squareRadius = radius * radius;
+		const size_t bucketCount = m_bucketStart.size() - 1;
+
+		Cell minimum;
+		Cell maximum;
+		uint64_t cellCount = 1;
+		for (int axis = 0; axis < Traits::Dimension; axis++)
+		{
+			const float value = Traits::Get(query, axis);
+			minimum.coordinates[axis] = CellCoordinate((value - radius) * m_inverseCellSize);
+			maximum.coordinates[axis] = CellCoordinate((value + radius) * m_inverseCellSize);
+
+			// Stops growing once above the bucket count, so the product cannot overflow
+			if (cellCount <= bucketCount)
+			{
+				cellCount *= static_cast<uint64_t>(static_cast<int64_t>(maximum.coordinates[axis]) - minimum.coordinates[axis] + 1);
+			}
+		}
+
+		// A box covering more cells than there are buckets visits every bucket anyway, scanning the points once is cheaper
+		if (cellCount > bucketCount)
+		{
+			for (size_t slot = 0; slot < m_sortedPoints.size(); slot++)
+			{
+				const float squareDistance = static_cast<float>((m_sortedPoints[slot] - query).SquareMagnitude());
+				if (squareDistance <= squareRadius)
+				{
+					function(m_sortedIndices[slot], squareDistance);
+				}
+			}
+			return;
+		}
+
+		// Two cells of the query box can share a bucket: small boxes remember the visited buckets,
+		// large ones check that each candidate really belongs to the cell being visited
+		const bool trackBuckets = cellCount <= MAX_TRACKED_BUCKETS;
+		uint32_t visitedBuckets[MAX_TRACKED_BUCKETS];
+		size_t visitedCount = 0;
+
+		Cell cell;
+		for (cell.coordinates[2] = minimum.coordinates[2]; cell.coordinates[2] <= maximum.coordinates[2]; cell.coordinates[2]++)
+		{
+			for (cell.coordinates[1] = minimum.coordinates[1]; cell.coordinates[1] <= maximum.coordinates[1]; cell.coordinates[1]++)
+			{
+				for (cell.coordinates[0] = minimum.coordinates[0]; cell.coordinates[0] <= maximum.coordinates[0]; cell.coordinates[0]++)
+				{
+					const uint32_t bucket = Hash(cell);
+
+					if (trackBuckets)
+					{
+						if (std::find(visitedBuckets, visitedBuckets + visitedCount, bucket) != visitedBuckets + visitedCount)
+						{
+							continue;
+						}
+						visitedBuckets[visitedCount++] = bucket;
+					}
+
+					for (uint32_t slot = m_bucketStart[bucket]; slot < m_bucketStart[bucket + 1]; slot++)
+					{
+						const TPoint& point = m_sortedPoints[slot];
+						const float squareDistance = static_cast<float>((point - query).SquareMagnitude());
+						if (squareDistance <= squareRadius && (trackBuckets || CellOf(point) == cell))
+						{
+							function(m_sortedIndices[slot], squareDistance);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	typedef TSpatialHashGrid<Vector3> SpatialHashGrid3;
+	typedef TSpatialHashGrid<TVector2<float>> SpatialHashGrid2;
+}
@@ -0,0 +1,342 @@
+#include "SpatialSort.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Core/SIMD.h"
+#include "Vector/VectorReduction.h"
+
+#if LIBMATH_SSE && (defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64))
+#define LIBMATH_PDEP 1
+#else
+#define LIBMATH_PDEP 0
+#endif
+
+namespace LibMath::SpatialSort
+{
+	namespace
+	{
+		/**
+		 * @brief Elements processed by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_SORT_SIZE = 1 << 15;
+
+		constexpr size_t RADIX_BITS = 8;
+		constexpr size_t RADIX_SIZE = 1 << RADIX_BITS;
+
+		/**
+		 * @brief Turn coordinates into the transposed Hilbert index (Skilling, "Programming the Hilbert curve").
+		 * Interleaving the transposed coordinates, axes[0] taking the highest bit of each group, gives the index.
+		 */
+		template <int Dimension>
+		void AxesToTranspose(uint32_t (&axes)[Dimension], const uint32_t bits)
+		{
+			const uint32_t highest = 1u << (bits - 1);
+
+			// Inverse undo
+			for (uint32_t q = highest; q > 1; q >>= 1)
+			{
+				const uint32_t p = q - 1;
+				for (int i = 0; i < Dimension; i++)
+				{
+					if (axes[i] & q)
+					{
+						axes[0] ^= p;
+					}
+					else
+					{
+						const uint32_t t = (axes[0] ^ axes[i]) & p;
+						axes[0] ^= t;
+						axes[i] ^= t;
+					}
+				}
+			}
+
+			// Gray encode
+			for (int i = 1; i < Dimension; i++)
+			{
+				axes[i] ^= axes[i - 1];
+			}
+
+			uint32_t t = 0;
+			for (uint32_t q = highest; q > 1; q >>= 1)
+			{
+				if (axes[Dimension - 1] & q)
+				{
+					t ^= q - 1;
+				}
+			}
+
+			for (int i = 0; i < Dimension; i++)
+			{
+				axes[i] ^= t;
+			}
+		}
+
+		/**
+		 * @brief Maps one coordinate from [min, max] to [0, 2^bits - 1].
+		 */
+		struct AxisQuantizer
+		{
+			float min = 0.f;
+			float scale = 0.f;
+			float maxCell = 0.f;
+
+			AxisQuantizer(const float minimum, const float maximum, const uint32_t bits) :
+				min(minimum), maxCell(static_cast<float>((1u << bits) - 1))
+			{
+				const float extent = maximum - minimum;
+				scale = extent > 0.f ? maxCell / extent : 0.f;
+			}
+
+			[[nodiscard]] uint32_t operator()(const float value) const
+			{
+				float cell = (value - min) * scale;
+				cell = cell > 0.f ? cell : 0.f;	// also catches NaN
+				cell = cell < maxCell ? cell : maxCell;
+				return static_cast<uint32_t>(cell);
+			}
+		};
+
+#if LIBMATH_PDEP
+		constexpr uint64_t MORTON3_X_MASK = 0x1249249249249249ull;
+
+		LIBMATH_TARGET("bmi2")
+		void MortonKeys3BMI2(const Vector3* points, const size_t begin, const size_t end, const AxisQuantizer (&quantizers)[3], uint64_t* outKeys)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				outKeys[i] = _pdep_u64(quantizers[0](points[i].x), MORTON3_X_MASK)
+					| _pdep_u64(quantizers[1](points[i].y), MORTON3_X_MASK << 1)
+					| _pdep_u64(quantizers[2](points[i].z), MORTON3_X_MASK << 2);
+			}
+		}
+
+		LIBMATH_TARGET("bmi2")
+		void MortonKeys2BMI2(const TVector2<float>* points, const size_t begin, const size_t end, const AxisQuantizer (&quantizers)[2], uint32_t* outKeys)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				outKeys[i] = _pdep_u32(quantizers[0](points[i].x), 0x55555555u) | _pdep_u32(quantizers[1](points[i].y), 0xAAAAAAAAu);
+			}
+		}
+#endif
+
+		template <class Key>
+		void RadixSort(Key* keys, uint32_t* permutation, const size_t count)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			std::vector<Key> keyBuffer(count);
+			std::vector<uint32_t> indexBuffer(count);
+
+			Key* sourceKeys = keys;
+			Key* targetKeys = keyBuffer.data();
+			uint32_t* sourceIndices = permutation;
+			uint32_t* targetIndices = indexBuffer.data();
+
+			Parallel::For(count, PARALLEL_SORT_SIZE, [permutation](const size_t begin, const size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					permutation[i] = static_cast<uint32_t>(i);
+				}
+			});
+
+			const size_t blockCount = std::max<size_t>(1, std::min<size_t>(count / PARALLEL_SORT_SIZE, Parallel::ThreadCount()));
+			std::vector<size_t> histograms(blockCount * RADIX_SIZE);
+
+			for (size_t shift = 0; shift < sizeof(Key) * 8; shift += RADIX_BITS)
+			{
+				std::fill(histograms.begin(), histograms.end(), size_t(0));
+
+				Parallel::ForEachChunk(blockCount, [&histograms, sourceKeys, count, blockCount, shift](const size_t block)
+				{
+					size_t* histogram = histograms.data() + block * RADIX_SIZE;
+					const size_t end = count * (block + 1) / blockCount;
+					for (size_t i = count * block / blockCount; i < end; i++)
+					{
+						histogram[(sourceKeys[i] >> shift) & (RADIX_SIZE - 1)]++;
+					}
+				});
+
+				// Every block writes its elements of a digit after the ones of the previous blocks, keeping the sort stable
+				bool sharedDigit = false;
+				size_t offset = 0;
+				for (size_t digit = 0; digit < RADIX_SIZE; digit++)
+				{
+					const size_t digitStart = offset;
+					for (size_t block = 0; block < blockCount; block++)
+					{
+						const size_t digitCount = histograms[block * RADIX_SIZE + digit];
+						histograms[block * RADIX_SIZE + digit] = offset;
+						offset += digitCount;
+					}
+					sharedDigit |= offset - digitStart == count;
+				}
+
+				if (sharedDigit)
+				{
+					continue;
+				}
+
+				Parallel::ForEachChunk(blockCount, [&histograms, sourceKeys, targetKeys, sourceIndices, targetIndices, count, blockCount, shift](const size_t block)
+				{
+					size_t* cursors = histograms.data() + block * RADIX_SIZE;
+					const size_t end = count * (block + 1) / blockCount;
+					for (size_t i = count * block / blockCount; i < end; i++)
+					{
+						const size_t position = cursors[(sourceKeys[i] >> shift) & (RADIX_SIZE - 1)]++;
+						targetKeys[position] = sourceKeys[i];
+						targetIndices[position] = sourceIndices[i];
+					}
+				});
+
+				std::swap(sourceKeys, targetKeys);
+				std::swap(sourceIndices, targetIndices);
+			}
+
+			if (sourceKeys != keys)
+			{
+				Parallel::For(count, PARALLEL_SORT_SIZE, [&](const size_t begin, const size_t end)
+				{
+					std::copy(sourceKeys + begin, sourceKeys + end, keys + begin);
+					std::copy(sourceIndices + begin, sourceIndices + end, permutation + begin);
+				});
+			}
+		}
+
+		template <class TPoint, class Key>
+		void SortPoints(TPoint* points, const size_t count, uint32_t* outPermutation, std::vector<Key>& keys)
+		{
+			std::vector<uint32_t> localPermutation;
+			uint32_t* permutation = outPermutation;
+			if (permutation == nullptr)
+			{
+				localPermutation.resize(count);
+				permutation = localPermutation.data();
+			}
+
+			SortByKey(keys.data(), permutation, count);
+
+			const std::vector<TPoint> unsorted(points, points + count);
+			ApplyPermutation(permutation, unsorted.data(), points, count);
+		}
+	}
+
+	uint64_t EncodeHilbert3(const uint32_t x, const uint32_t y, const uint32_t z)
+	{
+		uint32_t axes[3] = { x, y, z };
+		AxesToTranspose(axes, BITS_PER_AXIS_3D);
+		return EncodeMorton3(axes[2], axes[1], axes[0]);
+	}
+
+	uint32_t EncodeHilbert2(const uint32_t x, const uint32_t y)
+	{
+		uint32_t axes[2] = { x, y };
+		AxesToTranspose(axes, BITS_PER_AXIS_2D);
+		return EncodeMorton2(axes[1], axes[0]);
+	}
+
+	void ComputeKeys(const Vector3* points, const size_t count, const AABB& bounds, uint64_t* outKeys, const Curve curve)
+	{
+		const AxisQuantizer quantizers[3] = {
+			AxisQuantizer(bounds.min.x, bounds.max.x, BITS_PER_AXIS_3D),
+			AxisQuantizer(bounds.min.y, bounds.max.y, BITS_PER_AXIS_3D),
+			AxisQuantizer(bounds.min.z, bounds.max.z, BITS_PER_AXIS_3D)
+		};
+
+		Parallel::For(count, PARALLEL_SORT_SIZE, [&](const size_t begin, const size_t end)
+		{
+			if (curve == Curve::HILBERT)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					outKeys[i] = EncodeHilbert3(quantizers[0](points[i].x), quantizers[1](points[i].y), quantizers[2](points[i].z));
+				}
+				return;
+			}
+
+#if LIBMATH_PDEP
+			if (SIMD::HasBMI2())
+			{
+				MortonKeys3BMI2(points, begin, end, quantizers, outKeys);
+				return;
+			}
+#endif
+			for (size_t i = begin; i < end; i++)
+			{
+				outKeys[i] = EncodeMorton3(quantizers[0](points[i].x), quantizers[1](points[i].y), quantizers[2](points[i].z));
+			}
+		});
+	}
+
+	void ComputeKeys(const TVector2<float>* points, const size_t count, const TVector2<float>& min, const TVector2<float>& max, uint32_t* outKeys, const Curve curve)
+	{
+		const AxisQuantizer quantizers[2] = {
+			AxisQuantizer(min.x, max.x, BITS_PER_AXIS_2D),
+			AxisQuantizer(min.y, max.y, BITS_PER_AXIS_2D)
+		};
+
+		Parallel::For(count, PARALLEL_SORT_SIZE, [&](const size_t begin, const size_t end)
+		{
+			if (curve == Curve::HILBERT)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					outKeys[i] = EncodeHilbert2(quantizers[0](points[i].x), quantizers[1](points[i].y));
+				}
+				return;
+			}
+
+#if LIBMATH_PDEP
+			if (SIMD::HasBMI2())
+			{
+				MortonKeys2BMI2(points, begin, end, quantizers, outKeys);
+				return;
+			}
+#endif
+			for (size_t i = begin; i < end; i++)
+			{
+				outKeys[i] = EncodeMorton2(quantizers[0](points[i].x), quantizers[1](points[i].y));
+			}
+		});
+	}
+
+	void SortByKey(uint64_t* keys, uint32_t* outPermutation, const size_t count)
+	{
+		RadixSort(keys, outPermutation, count);
+	}
+
+	void SortByKey(uint32_t* keys, uint32_t* outPermutation, const size_t count)
+	{
+		RadixSort(keys, outPermutation, count);
+	}
+
+	void Sort(Vector3* points, const size_t count, uint32_t* outPermutation, const Curve curve)
+	{
+		std::vector<uint64_t> keys(count);
+		ComputeKeys(points, count, VectorBatch::ComputeBounds(points, count), keys.data(), curve);
+		SortPoints(points, count, outPermutation, keys);
+	}
+
+	void Sort(TVector2<float>* points, const size_t count, uint32_t* outPermutation, const Curve curve)
+	{
+		TVector2<float> min(std::numeric_limits<float>::infinity());
+		TVector2<float> max(-std::numeric_limits<float>::infinity());
+		for (size_t i = 0; i < count; i++)
+		{
+			min = TVector2<float>(std::min(min.x, points[i].x), std::min(min.y, points[i].y));
+			max = TVector2<float>(std::max(max.x, points[i].x), std::max(max.y, points[i].y));
+		}
+
+		std::vector<uint32_t> keys(count);
+		ComputeKeys(points, count, min, max, keys.data(), curve);
+		SortPoints(points, count, outPermutation, keys);
+	}
+}
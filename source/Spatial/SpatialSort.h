@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Core/Parallel.h"
+#include "Spatial/AABB.h"
+#include "Vector/TVector2.h"
+#include "Vector/Vector3.h"
+
+namespace LibMath
+{
+	/**
+	 * @brief Space filling curve keys and sorting of point arrays along them.
+	 * Points close in space get close keys, so sorting an array by key makes every later
+	 * pass over it cache friendly and is the first step of linear BVH builds.
+	 */
+	namespace SpatialSort
+	{
+		/**
+		 * @brief Curve used to order the points.
+		 */
+		enum class Curve
+		{
+			MORTON,		/**< Z-order, cheapest to compute*/
+			HILBERT,	/**< Hilbert curve, no long jumps between consecutive cells*/
+		};
+
+		constexpr uint32_t BITS_PER_AXIS_3D = 21;/**< quantization of each axis for 3D keys*/
+		constexpr uint32_t BITS_PER_AXIS_2D = 16;/**< quantization of each axis for 2D keys*/
+
+		/*
+		* @name Bit spreading helpers, bit i of the value moves to bit 3i (resp. 2i)
+		*/
+		/*@{*/
+		constexpr uint64_t SpreadBits3(uint64_t value)
+		{
+			value &= 0x1FFFFF;
+			value = (value | value << 32) & 0x1F00000000FFFFull;
+			value = (value | value << 16) & 0x1F0000FF0000FFull;
+			value = (value | value << 8) & 0x100F00F00F00F00Full;
+			value = (value | value << 4) & 0x10C30C30C30C30C3ull;
+			value = (value | value << 2) & 0x1249249249249249ull;
+			return value;
+		}
+
+		constexpr uint32_t CompactBits3(uint64_t value)
+		{
+			value &= 0x1249249249249249ull;
+			value = (value ^ (value >> 2)) & 0x10C30C30C30C30C3ull;
+			value = (value ^ (value >> 4)) & 0x100F00F00F00F00Full;
+			value = (value ^ (value >> 8)) & 0x1F0000FF0000FFull;
+			value = (value ^ (value >> 16)) & 0x1F00000000FFFFull;
+			value = (value ^ (value >> 32)) & 0x1FFFFF;
+			return static_cast<uint32_t>(value);
+		}
+
+		constexpr uint32_t SpreadBits2(uint32_t value)
+		{
+			value &= 0xFFFF;
+			value = (value | value << 8) & 0x00FF00FF;
+			value = (value | value << 4) & 0x0F0F0F0F;
+			value = (value | value << 2) & 0x33333333;
+			value = (value | value << 1) & 0x55555555;
+			return value;
+		}
+
+		constexpr uint32_t CompactBits2(uint32_t value)
+		{
+			value &= 0x55555555;
+			value = (value ^ (value >> 1)) & 0x33333333;
+			value = (value ^ (value >> 2)) & 0x0F0F0F0F;
+			value = (value ^ (value >> 4)) & 0x00FF00FF;
+			value = (value ^ (value >> 8)) & 0x0000FFFF;
+			return value;
+		}
+		/*@}*/
+
+		/**
+		 * @brief Interleave three 21 bits coordinates, x taking the lowest bit of each triplet.
+		 */
+		constexpr uint64_t EncodeMorton3(const uint32_t x, const uint32_t y, const uint32_t z) { return SpreadBits3(x) | SpreadBits3(y) << 1 | SpreadBits3(z) << 2; }
+
+		/**
+		 * @brief Interleave two 16 bits coordinates, x taking the lowest bit of each pair.
+		 */
+		constexpr uint32_t EncodeMorton2(const uint32_t x, const uint32_t y) { return SpreadBits2(x) | SpreadBits2(y) << 1; }
+
+		constexpr void DecodeMorton3(const uint64_t key, uint32_t& x, uint32_t& y, uint32_t& z) { x = CompactBits3(key); y = CompactBits3(key >> 1); z = CompactBits3(key >> 2); }
+		constexpr void DecodeMorton2(const uint32_t key, uint32_t& x, uint32_t& y) { x = CompactBits2(key); y = CompactBits2(key >> 1); }
+
+		/**
+		 * @brief Position of a cell of a 2^21 grid along the 3D Hilbert curve.
+		 */
+		uint64_t EncodeHilbert3(uint32_t x, uint32_t y, uint32_t z);
+
+		/**
+		 * @brief Position of a cell of a 2^16 grid along the 2D Hilbert curve.
+		 */
+		uint32_t EncodeHilbert2(uint32_t x, uint32_t y);
+
+		/**
+		 * @brief Compute the curve key of every point, quantized over bounds. Points outside bounds are clamped.
+		 * The Morton keys use BMI2 when the CPU has it.
+		 *
+		 * @param points Array of points
+		 * @param count Number of points and keys
+		 * @param bounds Box covering the points, usually VectorBatch::ComputeBounds()
+		 * @param outKeys Array receiving the keys
+		 * @param curve Curve to follow
+		 */
+		void ComputeKeys(const Vector3* points, size_t count, const AABB& bounds, uint64_t* outKeys, Curve curve = Curve::MORTON);
+
+		/**
+		 * @brief Compute the curve key of every 2D point, quantized over [min, max]. Points outside are clamped.
+		 *
+		 * @param points Array of points
+		 * @param count Number of points and keys
+		 * @param min Corner of the covered area with the smallest coordinates
+		 * @param max Corner of the covered area with the largest coordinates
+		 * @param outKeys Array receiving the keys
+		 * @param curve Curve to follow
+		 */
+		void ComputeKeys(const TVector2<float>* points, size_t count, const TVector2<float>& min, const TVector2<float>& max, uint32_t* outKeys, Curve curve = Curve::MORTON);
+
+		/**
+		 * @brief Stable parallel LSD radix sort of keys, 8 bits per pass. Passes where every key has the
+		 * same digit are skipped, so small keys only pay for their significant bytes.
+		 *
+		 * @param keys Array of keys, sorted in place
+		 * @param outPermutation Array receiving, for each sorted position, the original index of its key
+		 * @param count Number of keys
+		 */
+		void SortByKey(uint64_t* keys, uint32_t* outPermutation, size_t count);
+		void SortByKey(uint32_t* keys, uint32_t* outPermutation, size_t count);
+
+		/**
+		 * @brief Gather output[i] = input[permutation[i]] in parallel, to reorder any payload attached to sorted points.
+		 *
+		 * @param permutation Permutation returned by SortByKey() or Sort()
+		 * @param input Array to reorder
+		 * @param output Array receiving the reordered elements, must not overlap input
+		 * @param count Number of elements
+		 */
+		template <class T>
+		void ApplyPermutation(const uint32_t* permutation, const T* input, T* output, const size_t count)
+		{
+			Parallel::For(count, 1 << 15, [permutation, input, output](const size_t begin, const size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					output[i] = input[permutation[i]];
+				}
+			});
+		}
+
+		/**
+		 * @brief Reorder points in place along a curve covering their bounds.
+		 *
+		 * @param points Array of points to sort
+		 * @param count Number of points
+		 * @param outPermutation Optional array of count indices receiving the original index of each sorted point,
+		 *                       to reorder attached payloads with ApplyPermutation()
+		 * @param curve Curve to follow
+		 */
+		void Sort(Vector3* points, size_t count, uint32_t* outPermutation = nullptr, Curve curve = Curve::MORTON);
+		void Sort(TVector2<float>* points, size_t count, uint32_t* outPermutation = nullptr, Curve curve = Curve::MORTON);
+	}
+}
@@ -0,0 +1,487 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+
+namespace LibMath::Compression
+{
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Batched kernels expect tightly packed Vector3");
+	static_assert(sizeof(UNorm16x3) == 3 * sizeof(uint16_t), "Batched kernels expect tightly packed UNorm16x3");
+	static_assert(sizeof(SNorm16x3) == 3 * sizeof(int16_t), "Batched kernels expect tightly packed SNorm16x3");
+
+	namespace
+	{
+		/**
+		 * @brief Vectors processed by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_COMPRESSION_SIZE = 1 << 14;
+
+		/**
+		 * @brief Vectors decoded at once on the stack to measure the error.
+		 */
+		constexpr size_t ERROR_TILE_SIZE = 256;
+
+		float ClampUnit(const float value)
+		{
+			return std::min(std::max(value, -1.f), 1.f);
+		}
+
+		/**
+		 * @brief Clamp that also sends NaN to minimum, like _mm_max_ps.
+		 */
+		float ClampCode(float value, const float minimum, const float maximum)
+		{
+			value = value > minimum ? value : minimum;
+			return value < maximum ? value : maximum;
+		}
+
+		/*
+		* @name Octahedral codes, ComponentBits bits per coordinate
+		*/
+		/*@{*/
+		template <int ComponentBits>
+		constexpr float OCTAHEDRAL_SCALE = static_cast<float>((1 << (ComponentBits - 1)) - 1);
+
+		template <int ComponentBits>
+		constexpr uint32_t OCTAHEDRAL_MASK = (1u << ComponentBits) - 1;
+
+		template <int ComponentBits>
+		uint32_t EncodeOctahedral(const Vector3& unit)
+		{
+			const float inverseL1 = 1.f / (std::abs(unit.x) + std::abs(unit.y) + std::abs(unit.z));
+			float u = unit.x * inverseL1;
+			float v = unit.y * inverseL1;
+
+			// Fold the lower hemisphere over the diagonals of the square
+			if (unit.z < 0.f)
+			{
+				const float foldedU = (1.f - std::abs(v)) * std::copysign(1.f, u);
+				v = (1.f - std::abs(u)) * std::copysign(1.f, v);
+				u = foldedU;
+			}
+
+			const int32_t codeU = static_cast<int32_t>(std::lrint(ClampUnit(u) * OCTAHEDRAL_SCALE<ComponentBits>));
+			const int32_t codeV = static_cast<int32_t>(std::lrint(ClampUnit(v) * OCTAHEDRAL_SCALE<ComponentBits>));
+			return (static_cast<uint32_t>(codeU) & OCTAHEDRAL_MASK<ComponentBits>) | (static_cast<uint32_t>(codeV) & OCTAHEDRAL_MASK<ComponentBits>) << ComponentBits;
+		}
+
+		template <int ComponentBits>
+		Vector3 DecodeOctahedral(const uint32_t code)
+		{
+			constexpr int shift = 32 - ComponentBits;
+			constexpr float inverseScale = 1.f / OCTAHEDRAL_SCALE<ComponentBits>;
+
+			const int32_t codeU = static_cast<int32_t>(code << shift) >> shift;
+			const int32_t codeV = static_cast<int32_t>((code >> ComponentBits) << shift) >> shift;
+
+			float u = std::max(static_cast<float>(codeU) * inverseScale, -1.f);
+			float v = std::max(static_cast<float>(codeV) * inverseScale, -1.f);
+			const float z = 1.f - std::abs(u) - std::abs(v);
+
+			// Unfold the lower hemisphere
+			const float fold = std::max(-z, 0.f);
+			u -= std::copysign(fold, u);
+			v -= std::copysign(fold, v);
+
+			return Vector3(u, v, z).GetFastNormalize();
+		}
+
+		template <int ComponentBits, class TCode>
+		void EncodeOctahedralRange(const Vector3* input, const size_t count, TCode* output)
+		{
+			size_t i = 0;
+#if LIBMATH_SSE
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minusOne = _mm_set1_ps(-1.f);
+			const __m128 scale = _mm_set1_ps(OCTAHEDRAL_SCALE<ComponentBits>);
+			const __m128i mask = _mm_set1_epi32(static_cast<int>(OCTAHEDRAL_MASK<ComponentBits>));
+			const float* data = reinterpret_cast<const float*>(input);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 x, y, z;
+				SIMD::LoadVector3x4(data + i * 3, x, y, z);
+
+				const __m128 inverseL1 = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z)));
+				__m128 u = _mm_mul_ps(x, inverseL1);
+				__m128 v = _mm_mul_ps(y, inverseL1);
+
+				const __m128 foldedU = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, v)), _mm_or_ps(_mm_and_ps(u, signMask), one));
+				const __m128 foldedV = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), _mm_or_ps(_mm_and_ps(v, signMask), one));
+				const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+				u = SIMD::Select(lower, foldedU, u);
+				v = SIMD::Select(lower, foldedV, v);
+
+				const __m128i codeU = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(u, minusOne), one), scale));
+				const __m128i codeV = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, minusOne), one), scale));
+				const __m128i codes = _mm_or_si128(_mm_and_si128(codeU, mask), _mm_slli_epi32(_mm_and_si128(codeV, mask), ComponentBits));
+
+				if constexpr (sizeof(TCode) == 4)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), codes);
+				}
+				else
+				{
+					// Bias to the signed range so the saturating pack keeps the 16 bits codes intact
+					const __m128i biased = _mm_sub_epi32(codes, _mm_set1_epi32(0x8000));
+					const __m128i packed = _mm_xor_si128(_mm_packs_epi32(biased, biased), _mm_set1_epi16(static_cast<short>(0x8000)));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), packed);
+				}
+			}
+#endif
+			for (; i < count; i++)
+			{
+				output[i] = static_cast<TCode>(EncodeOctahedral<ComponentBits>(input[i]));
+			}
+		}
+
+		template <int ComponentBits, class TCode>
+		void DecodeOctahedralRange(const TCode* input, const size_t count, Vector3* output)
+		{
+			size_t i = 0;
+#if LIBMATH_SSE
+			constexpr int shift = 32 - ComponentBits;
+			const __m128 signMask = _mm_set1_ps(-0.f);
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minusOne = _mm_set1_ps(-1.f);
+			const __m128 inverseScale = _mm_set1_ps(1.f / OCTAHEDRAL_SCALE<ComponentBits>);
+			float* data = reinterpret_cast<float*>(output);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i codes;
+				if constexpr (sizeof(TCode) == 4)
+				{
+					codes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+				}
+				else
+				{
+					codes = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)), _mm_setzero_si128());
+				}
+
+				const __m128i codeU = _mm_srai_epi32(_mm_slli_epi32(codes, shift), shift);
+				const __m128i codeV = _mm_srai_epi32(_mm_slli_epi32(codes, shift - ComponentBits), shift);
+
+				__m128 u = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(codeU), inverseScale), minusOne);
+				__m128 v = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(codeV), inverseScale), minusOne);
+				const __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), _mm_andnot_ps(signMask, v));
+
+				const __m128 fold = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+				u = _mm_sub_ps(u, _mm_or_ps(fold, _mm_and_ps(u, signMask)));
+				v = _mm_sub_ps(v, _mm_or_ps(fold, _mm_and_ps(v, signMask)));
+
+				// Same refined estimate as InverseSqrt(NEWTON_RAPHSON)
+				const __m128 squareMagnitude = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(z, z));
+				const __m128 estimate = _mm_rsqrt_ps(squareMagnitude);
+				const __m128 factor = _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(squareMagnitude, _mm_set1_ps(.5f)), _mm_mul_ps(estimate, estimate))));
+
+				SIMD::StoreVector3x4(data + i * 3, _mm_mul_ps(u, factor), _mm_mul_ps(v, factor), _mm_mul_ps(z, factor));
+			}
+#endif
+			for (; i < count; i++)
+			{
+				output[i] = DecodeOctahedral<ComponentBits>(input[i]);
+			}
+		}
+		/*@}*/
+
+		/*
+		* @name Position quantization, code = (position - offset) * scale clamped to [minCode, maxCode]
+		*/
+		/*@{*/
+		struct PositionMapping
+		{
+			Vector3 offset;/**< position of code 0*/
+			Vector3 scale;/**< codes per unit*/
+			Vector3 step;/**< units per code*/
+			float minCode = 0.f;
+			float maxCode = 0.f;
+		};
+
+		template <class TQuantized>
+		PositionMapping GetMapping(const AABB& bounds)
+		{
+			constexpr bool isSigned = std::is_same_v<TQuantized, SNorm16x3>;
+			const float codeRange = isSigned ? 32767.f : 65535.f;
+			const Vector3 range = isSigned ? bounds.GetExtents() : bounds.GetSize();
+
+			PositionMapping mapping;
+			mapping.offset = isSigned ? bounds.GetCenter() : bounds.min;
+			mapping.scale = Vector3(range.x > 0.f ? codeRange / range.x : 0.f, range.y > 0.f ? codeRange / range.y : 0.f, range.z > 0.f ? codeRange / range.z : 0.f);
+			mapping.step = range * (1.f / codeRange);
+			mapping.minCode = isSigned ? -codeRange : 0.f;
+			mapping.maxCode = codeRange;
+			return mapping;
+		}
+
+		template <class TQuantized>
+		TQuantized Quantize(const Vector3& position, const PositionMapping& mapping)
+		{
+			using Component = decltype(TQuantized::x);
+
+			const Vector3 scaled = (position - mapping.offset) * mapping.scale;
+			TQuantized quantized;
+			quantized.x = static_cast<Component>(std::lrint(ClampCode(scaled.x, mapping.minCode, mapping.maxCode)));
+			quantized.y = static_cast<Component>(std::lrint(ClampCode(scaled.y, mapping.minCode, mapping.maxCode)));
+			quantized.z = static_cast<Component>(std::lrint(ClampCode(scaled.z, mapping.minCode, mapping.maxCode)));
+			return quantized;
+		}
+
+		template <class TQuantized>
+		Vector3 Dequantize(const TQuantized& quantized, const PositionMapping& mapping)
+		{
+			return mapping.offset + Vector3(static_cast<float>(quantized.x), static_cast<float>(quantized.y), static_cast<float>(quantized.z)) * mapping.step;
+		}
+
+		template <class TQuantized>
+		void QuantizeRange(const Vector3* input, const size_t count, const PositionMapping& mapping, TQuantized* output)
+		{
+			size_t i = 0;
+#if LIBMATH_SSE
+			// Four Vector3 fill three registers, the per axis constants are rotated to match: (x y z x) (y z x y) (z x y z)
+			const Vector3& o = mapping.offset;
+			const Vector3& s = mapping.scale;
+			const __m128 offsets[3] = { _mm_setr_ps(o.x, o.y, o.z, o.x), _mm_setr_ps(o.y, o.z, o.x, o.y), _mm_setr_ps(o.z, o.x, o.y, o.z) };
+			const __m128 scales[3] = { _mm_setr_ps(s.x, s.y, s.z, s.x), _mm_setr_ps(s.y, s.z, s.x, s.y), _mm_setr_ps(s.z, s.x, s.y, s.z) };
+			const __m128 minCode = _mm_set1_ps(mapping.minCode);
+			const __m128 maxCode = _mm_set1_ps(mapping.maxCode);
+			const float* data = reinterpret_cast<const float*>(input);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i codes[3];
+				for (int part = 0; part < 3; part++)
+				{
+					const __m128 scaled = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(data + i * 3 + part * 4), offsets[part]), scales[part]);
+					codes[part] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scaled, minCode), maxCode));
+				}
+
+				__m128i first;
+				__m128i second;
+				if constexpr (std::is_same_v<TQuantized, SNorm16x3>)
+				{
+					first = _mm_packs_epi32(codes[0], codes[1]);
+					second = _mm_packs_epi32(codes[2], codes[2]);
+				}
+				else
+				{
+					// Bias to the signed range so the saturating pack keeps the unsigned codes intact
+					const __m128i bias = _mm_set1_epi32(0x8000);
+					const __m128i unbias = _mm_set1_epi16(static_cast<short>(0x8000));
+					first = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(codes[0], bias), _mm_sub_epi32(codes[1], bias)), unbias);
+					second = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(codes[2], bias), _mm_sub_epi32(codes[2], bias)), unbias);
+				}
+
+				char* destination = reinterpret_cast<char*>(output + i);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), first);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + 16), second);
+			}
+#endif
+			for (; i < count; i++)
+			{
+				output[i] = Quantize<TQuantized>(input[i], mapping);
+			}
+		}
+
+		template <class TQuantized>
+		void DequantizeRange(const TQuantized* input, const size_t count, const PositionMapping& mapping, Vector3* output)
+		{
+			size_t i = 0;
+#if LIBMATH_SSE
+			const Vector3& o = mapping.offset;
+			const Vector3& s = mapping.step;
+			const __m128 offsets[3] = { _mm_setr_ps(o.x, o.y, o.z, o.x), _mm_setr_ps(o.y, o.z, o.x, o.y), _mm_setr_ps(o.z, o.x, o.y, o.z) };
+			const __m128 steps[3] = { _mm_setr_ps(s.x, s.y, s.z, s.x), _mm_setr_ps(s.y, s.z, s.x, s.y), _mm_setr_ps(s.z, s.x, s.y, s.z) };
+			float* data = reinterpret_cast<float*>(output);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const char* source = reinterpret_cast<const char*>(input + i);
+				const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+				const __m128i second = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + 16));
+
+				__m128i codes[3];
+				if constexpr (std::is_same_v<TQuantized, SNorm16x3>)
+				{
+					codes[0] = _mm_srai_epi32(_mm_unpacklo_epi16(first, first), 16);
+					codes[1] = _mm_srai_epi32(_mm_unpackhi_epi16(first, first), 16);
+					codes[2] = _mm_srai_epi32(_mm_unpacklo_epi16(second, second), 16);
+				}
+				else
+				{
+					codes[0] = _mm_unpacklo_epi16(first, _mm_setzero_si128());
+					codes[1] = _mm_unpackhi_epi16(first, _mm_setzero_si128());
+					codes[2] = _mm_unpacklo_epi16(second, _mm_setzero_si128());
+				}
+
+				for (int part = 0; part < 3; part++)
+				{
+					_mm_storeu_ps(data + i * 3 + part * 4, _mm_add_ps(offsets[part], _mm_mul_ps(_mm_cvtepi32_ps(codes[part]), steps[part])));
+				}
+			}
+#endif
+			for (; i < count; i++)
+			{
+				output[i] = Dequantize(input[i], mapping);
+			}
+		}
+		/*@}*/
+
+		struct ErrorSums
+		{
+			float maxSquareError = 0.f;
+			double sumSquareError = 0.0;
+		};
+
+		/**
+		 * @brief Decode every code with decodeRange(codes, count, output) and compare the result to the original values.
+		 */
+		template <class TCode, class DecodeRange>
+		QuantizationError MeasureError(const Vector3* original, const TCode* codes, const size_t count, DecodeRange&& decodeRange)
+		{
+			const ErrorSums sums = Parallel::Reduce(count, PARALLEL_COMPRESSION_SIZE, ErrorSums(),
+				[&](const size_t begin, const size_t end)
+				{
+					ErrorSums rangeSums;
+					Vector3 decoded[ERROR_TILE_SIZE];
+					for (size_t tileBegin = begin; tileBegin < end; tileBegin += ERROR_TILE_SIZE)
+					{
+						const size_t tileSize = std::min(ERROR_TILE_SIZE, end - tileBegin);
+						decodeRange(codes + tileBegin, tileSize, decoded);
+						for (size_t i = 0; i < tileSize; i++)
+						{
+							const float squareError = (decoded[i] - original[tileBegin + i]).SquareMagnitude();
+							rangeSums.maxSquareError = std::max(rangeSums.maxSquareError, squareError);
+							rangeSums.sumSquareError += squareError;
+						}
+					}
+					return rangeSums;
+				},
+				[](const ErrorSums& first, const ErrorSums& second)
+				{
+					return ErrorSums{ std::max(first.maxSquareError, second.maxSquareError), first.sumSquareError + second.sumSquareError };
+				});
+
+			QuantizationError error;
+			error.maxError = std::sqrt(sums.maxSquareError);
+			error.rmsError = count > 0 ? static_cast<float>(std::sqrt(sums.sumSquareError / static_cast<double>(count))) : 0.f;
+			return error;
+		}
+
+		template <class TCode, class EncodeRange, class DecodeRange>
+		void EncodeBatch(const Vector3* input, const size_t count, TCode* output, QuantizationError* outError, EncodeRange&& encodeRange, DecodeRange&& decodeRange)
+		{
+			Parallel::For(count, PARALLEL_COMPRESSION_SIZE, [&](const size_t begin, const size_t end)
+			{
+				encodeRange(input + begin, end - begin, output + begin);
+			});
+
+			if (outError != nullptr)
+			{
+				*outError = MeasureError(input, output, count, decodeRange);
+			}
+		}
+
+		template <class TCode, class DecodeRange>
+		void DecodeBatch(const TCode* input, const size_t count, Vector3* output, DecodeRange&& decodeRange)
+		{
+			Parallel::For(count, PARALLEL_COMPRESSION_SIZE, [&](const size_t begin, const size_t end)
+			{
+				decodeRange(input + begin, end - begin, output + begin);
+			});
+		}
+	}
+
+	uint32_t EncodeOctahedral32(const Vector3& unit)
+	{
+		return EncodeOctahedral<16>(unit);
+	}
+
+	Vector3 DecodeOctahedral32(const uint32_t code)
+	{
+		return DecodeOctahedral<16>(code);
+	}
+
+	uint16_t EncodeOctahedral16(const Vector3& unit)
+	{
+		return static_cast<uint16_t>(EncodeOctahedral<8>(unit));
+	}
+
+	Vector3 DecodeOctahedral16(const uint16_t code)
+	{
+		return DecodeOctahedral<8>(code);
+	}
+
+	UNorm16x3 QuantizeUNorm16(const Vector3& position, const AABB& bounds)
+	{
+		return Quantize<UNorm16x3>(position, GetMapping<UNorm16x3>(bounds));
+	}
+
+	Vector3 DequantizeUNorm16(const UNorm16x3& quantized, const AABB& bounds)
+	{
+		return Dequantize(quantized, GetMapping<UNorm16x3>(bounds));
+	}
+
+	SNorm16x3 QuantizeSNorm16(const Vector3& position, const AABB& bounds)
+	{
+		return Quantize<SNorm16x3>(position, GetMapping<SNorm16x3>(bounds));
+	}
+
+	Vector3 DequantizeSNorm16(const SNorm16x3& quantized, const AABB& bounds)
+	{
+		return Dequantize(quantized, GetMapping<SNorm16x3>(bounds));
+	}
+
+	void EncodeOctahedral32(const Vector3* normals, const size_t count, uint32_t* output, QuantizationError* outError)
+	{
+		EncodeBatch(normals, count, output, outError, EncodeOctahedralRange<16, uint32_t>, DecodeOctahedralRange<16, uint32_t>);
+	}
+
+	void EncodeOctahedral16(const Vector3* normals, const size_t count, uint16_t* output, QuantizationError* outError)
+	{
+		EncodeBatch(normals, count, output, outError, EncodeOctahedralRange<8, uint16_t>, DecodeOctahedralRange<8, uint16_t>);
+	}
+
+	void DecodeOctahedral32(const uint32_t* codes, const size_t count, Vector3* output)
+	{
+		DecodeBatch(codes, count, output, DecodeOctahedralRange<16, uint32_t>);
+	}
+
+	void DecodeOctahedral16(const uint16_t* codes, const size_t count, Vector3* output)
+	{
+		DecodeBatch(codes, count, output, DecodeOctahedralRange<8, uint16_t>);
+	}
+
+	void QuantizeUNorm16(const Vector3* positions, const size_t count, const AABB& bounds, UNorm16x3* output, QuantizationError* outError)
+	{
+		const PositionMapping mapping = GetMapping<UNorm16x3>(bounds);
+		EncodeBatch(positions, count, output, outError,
+			[&mapping](const Vector3* input, const size_t rangeCount, UNorm16x3* rangeOutput) { QuantizeRange(input, rangeCount, mapping, rangeOutput); },
+			[&mapping](const UNorm16x3* input, const size_t rangeCount, Vector3* rangeOutput) { DequantizeRange(input, rangeCount, mapping, rangeOutput); });
+	}
+
+	void QuantizeSNorm16(const Vector3* positions, const size_t count, const AABB& bounds, SNorm16x3* output, QuantizationError* outError)
+	{
+		const PositionMapping mapping = GetMapping<SNorm16x3>(bounds);
+		EncodeBatch(positions, count, output, outError,
+			[&mapping](const Vector3* input, const size_t rangeCount, SNorm16x3* rangeOutput) { QuantizeRange(input, rangeCount, mapping, rangeOutput); },
+			[&mapping](const SNorm16x3* input, const size_t rangeCount, Vector3* rangeOutput) { DequantizeRange(input, rangeCount, mapping, rangeOutput); });
+	}
+
+	void DequantizeUNorm16(const UNorm16x3* quantized, const size_t count, const AABB& bounds, Vector3* output)
+	{
+		const PositionMapping mapping = GetMapping<UNorm16x3>(bounds);
+		DecodeBatch(quantized, count, output, [&mapping](const UNorm16x3* input, const size_t rangeCount, Vector3* rangeOutput) { DequantizeRange(input, rangeCount, mapping, rangeOutput); });
+	}
+
+	void DequantizeSNorm16(const SNorm16x3* quantized, const size_t count, const AABB& bounds, Vector3* output)
+	{
+		const PositionMapping mapping = GetMapping<SNorm16x3>(bounds);
+		DecodeBatch(quantized, count, output, [&mapping](const SNorm16x3* input, const size_t rangeCount, Vector3* rangeOutput) { DequantizeRange(input, rangeCount, mapping, rangeOutput); });
+	}
+}
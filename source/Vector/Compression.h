@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Spatial/AABB.h"
+#include "Vector/Vector3.h"
+
+namespace LibMath
+{
+	/**
+	 * @brief Compact encodings of unit vectors and positions, for vertex streams and network snapshots.
+	 * The batched versions process four Vector3 per SSE instruction, large arrays are spread over the threads.
+	 */
+	namespace Compression
+	{
+		/**
+		 * @brief Position quantized on 16 bits per axis, 0 to 65535 over the bounds.
+		 */
+		struct UNorm16x3
+		{
+			uint16_t x = 0;
+			uint16_t y = 0;
+			uint16_t z = 0;
+		};
+
+		/**
+		 * @brief Position quantized on 16 bits per axis, -32767 to 32767 around the center of the bounds.
+		 */
+		struct SNorm16x3
+		{
+			int16_t x = 0;
+			int16_t y = 0;
+			int16_t z = 0;
+		};
+
+		/**
+		 * @brief Distance between the original values and their decoded version.
+		 */
+		struct QuantizationError
+		{
+			float maxError = 0.f;/**< largest distance*/
+			float rmsError = 0.f;/**< root mean square of the distances*/
+		};
+
+		/*
+		* @name Octahedral encoding of unit vectors: the unit sphere is folded on an octahedron, then unfolded on a square
+		* whose two coordinates are stored as snorm. 32 bits codes keep 16 bits per coordinate (error below 0.0001 rad),
+		* 16 bits codes keep 8 bits (error below 0.02 rad). The vector to encode must not be zero.
+		*/
+		/*@{*/
+		[[nodiscard]] uint32_t EncodeOctahedral32(const Vector3& unit);
+		[[nodiscard]] Vector3 DecodeOctahedral32(uint32_t code);
+		[[nodiscard]] uint16_t EncodeOctahedral16(const Vector3& unit);
+		[[nodiscard]] Vector3 DecodeOctahedral16(uint16_t code);
+		/*@}*/
+
+		/*
+		* @name Quantization of positions relative to bounds. Positions outside the bounds are clamped.
+		* A flat axis of the bounds decodes to its single coordinate.
+		*/
+		/*@{*/
+		[[nodiscard]] UNorm16x3 QuantizeUNorm16(const Vector3& position, const AABB& bounds);
+		[[nodiscard]] Vector3 DequantizeUNorm16(const UNorm16x3& quantized, const AABB& bounds);
+		[[nodiscard]] SNorm16x3 QuantizeSNorm16(const Vector3& position, const AABB& bounds);
+		[[nodiscard]] Vector3 DequantizeSNorm16(const SNorm16x3& quantized, const AABB& bounds);
+		/*@}*/
+
+		/**
+		 * @brief Encode an array of unit vectors.
+		 *
+		 * @param normals Array of unit vectors
+		 * @param count Number of vectors and codes
+		 * @param output Array receiving the codes
+		 * @param outError Optional, receives the distance between each vector and its decoded code. Measuring it decodes every code again
+		 */
+		void EncodeOctahedral32(const Vector3* normals, size_t count, uint32_t* output, QuantizationError* outError = nullptr);
+		void EncodeOctahedral16(const Vector3* normals, size_t count, uint16_t* output, QuantizationError* outError = nullptr);
+
+		/**
+		 * @brief Decode an array of octahedral codes to unit vectors.
+		 *
+		 * @param codes Array of codes
+		 * @param count Number of codes and vectors
+		 * @param output Array receiving the unit vectors
+		 */
+		void DecodeOctahedral32(const uint32_t* codes, size_t count, Vector3* output);
+		void DecodeOctahedral16(const uint16_t* codes, size_t count, Vector3* output);
+
+		/**
+		 * @brief Quantize an array of positions relative to bounds.
+		 *
+		 * @param positions Array of positions
+		 * @param count Number of positions
+		 * @param bounds Box covering the positions, usually VectorBatch::ComputeBounds()
+		 * @param output Array receiving the quantized positions
+		 * @param outError Optional, receives the distance between each position and its dequantized version
+		 */
+		void QuantizeUNorm16(const Vector3* positions, size_t count, const AABB& bounds, UNorm16x3* output, QuantizationError* outError = nullptr);
+		void QuantizeSNorm16(const Vector3* positions, size_t count, const AABB& bounds, SNorm16x3* output, QuantizationError* outError = nullptr);
+
+		/**
+		 * @brief Dequantize an array of positions, bounds must be the ones used to quantize them.
+		 *
+		 * @param quantized Array of quantized positions
+		 * @param count Number of positions
+		 * @param bounds Box used to quantize the positions
+		 * @param output Array receiving the positions
+		 */
+		void DequantizeUNorm16(const UNorm16x3* quantized, size_t count, const AABB& bounds, Vector3* output);
+		void DequantizeSNorm16(const SNorm16x3* quantized, size_t count, const AABB& bounds, Vector3* output);
+	}
+}
@@ -26,7 +26,7 @@ namespace LibMath
 		/**
 		* @brief Default constructor generate a vector (0,0)
 		*/
-		TVector2() = default;
+		constexpr TVector2() = default;
 
 		/**
 		* @brief Default destructor
@@ -38,13 +38,13 @@ namespace LibMath
 		*
 		* @param other 2D Vector to copy from.
 		*/
-		TVector2(const TVector2& other) = default;
+		constexpr TVector2(const TVector2& other) = default;
 
 		/**
 		 * @brief Default assignment operator
 		 * @param other Vector to copy
 		 */
-		TVector2& operator=(const TVector2& other) = default;
+		constexpr TVector2& operator=(const TVector2& other) = default;
 
 		/**
 		* @brief Constructor initializing all components to a single float value.
@@ -52,7 +52,7 @@ namespace LibMath
 		* @param value Value to set all components to.
 		*/
 
-		explicit TVector2(const T value) : x(value), y(value) {}
+		explicit constexpr TVector2(const T value) : x(value), y(value) {}
 
 		/**
 		* @brief Constructor using initial values for each component.
@@ -60,7 +60,7 @@ namespace LibMath
 		* @param px X Coordinate.
 		* @param py Y Coordinate.
 		*/
-		explicit TVector2(const T px, const T py) : x(px), y(py) {}
+		explicit constexpr TVector2(const T px, const T py) : x(px), y(py) {}
 
 		/**
 		* @brief Check against another vector for equality.
@@ -68,7 +68,7 @@ namespace LibMath
 		* @param other The vector to check against.
 		* @return true if the vectors are equal, false otherwise.
 		*/
-		[[nodiscard]] bool operator==(const TVector2<T>& other) const { return x == other.x && y == other.y; }
+		[[nodiscard]] constexpr bool operator==(const TVector2<T>& other) const { return x == other.x && y == other.y; }
 
 		/**
 		* @brief Check against another vector for inequality.
@@ -76,7 +76,7 @@ namespace LibMath
 		* @param other The vector to check against.
 		* @return true if the vectors are not equal, false otherwise.
 		*/
-		[[nodiscard]] bool operator!=(const TVector2<T>& other) const { return !(*this == other); }
+		[[nodiscard]] constexpr bool operator!=(const TVector2<T>& other) const { return !(*this == other); }
 
 		/**
 		 * @brief Compare both vector with a tolerance (default tolerance is 1.192092896e-07F)
@@ -102,35 +102,35 @@ namespace LibMath
 		*
 		* @return Square Magnitude.
 		*/
-		[[nodiscard]] T SquareMagnitude() const { return x * x + y * y; }
+		[[nodiscard]] constexpr T SquareMagnitude() const { return x * x + y * y; }
 
 		/**
 		 * @brief Compare two vector length
 		 * @param other Second vector to compare
 		 * @return True if the first vector is longer, false if not
 		 */
-		[[nodiscard]] bool IsLonger(const TVector2<T>& other) const { return SquareMagnitude() > other.SquareMagnitude(); }
+		[[nodiscard]] constexpr bool IsLonger(const TVector2<T>& other) const { return SquareMagnitude() > other.SquareMagnitude(); }
 
 		/**
 		 * @brief Compare two vector length
 		 * @param other Second vector to compare
 		 * @return True if the first vector is longer or equal, false if not
 		 */
-		[[nodiscard]] bool IsLongerOrEqual(const TVector2<T>& other) const { return !this->IsShorter(other); }
+		[[nodiscard]] constexpr bool IsLongerOrEqual(const TVector2<T>& other) const { return !this->IsShorter(other); }
 
 		/**
 		 * @brief Compare two vector length
 		 * @param other Second vector to compare
 		 * @return True if the first vector is shorter, false if not
 		 */
-		[[nodiscard]] bool IsShorter(const TVector2<T>& other) const { return SquareMagnitude() < other.SquareMagnitude(); }
+		[[nodiscard]] constexpr bool IsShorter(const TVector2<T>& other) const { return SquareMagnitude() < other.SquareMagnitude(); }
 
 		/**
 		 * @brief Compare two vector length
 		 * @param other Second vector to compare
 		 * @return True if the first vector is shorter or equal, false if not
 		 */
-		[[nodiscard]] bool IsShorterOrEqual(const TVector2<T>& other) const { return !this->IsLonger(other); }
+		[[nodiscard]] constexpr bool IsShorterOrEqual(const TVector2<T>& other) const { return !this->IsLonger(other); }
 
 		/**
 		* @brief Gets the result of component-wise addition of this and another vector.
@@ -138,7 +138,7 @@ namespace LibMath
 		* @param rhs The vector to add to this.
 		* @return The result of vector addition.
 		*/
-		TVector2<T>& operator+=(const TVector2<T>& rhs) { x += rhs.x; y += rhs.y; return *this; }
+		constexpr TVector2<T>& operator+=(const TVector2<T>& rhs) { x += rhs.x; y += rhs.y; return *this; }
 
 		/**
 		* @brief Gets the result of component-wise subtraction of this by another vector.
@@ -146,7 +146,7 @@ namespace LibMath
 		* @param rhs The vector to subtract from this.
 		* @return The result of vector subtraction.
 		*/
-		TVector2<T>& operator-=(const TVector2<T>& rhs) { x -= rhs.x; y -= rhs.y; return *this; }
+		constexpr TVector2<T>& operator-=(const TVector2<T>& rhs) { x -= rhs.x; y -= rhs.y; return *this; }
 
 		/**
 		* @brief Multiply the vector by three different value
@@ -154,7 +154,7 @@ namespace LibMath
 		* @param rhs Ratio to use
 		* @return The result of multiplication.
 		*/
-		TVector2<T>& operator*=(const TVector2<T>& rhs) { x *= rhs.x; y *= rhs.y; return *this; }
+		constexpr TVector2<T>& operator*=(const TVector2<T>& rhs) { x *= rhs.x; y *= rhs.y; return *this; }
 
 		/**
 		* @brief Divide the vector by three different value
@@ -162,7 +162,7 @@ namespace LibMath
 		* @param rhs Ratio to use
 		* @return The result of division.
 		*/
-		TVector2<T>& operator/=(const TVector2<T>& rhs)
+		constexpr TVector2<T>& operator/=(const TVector2<T>& rhs)
 		{
 			// TODO Optimize to only have check in debug
 			if (rhs.x == 0 || rhs.y == 0)
@@ -182,7 +182,7 @@ namespace LibMath
 		* @param rhs The negated vector
 		* @return A negated copy of the vector.
 		*/
-		friend TVector2<T> operator-(const TVector2<T>& rhs) { return TVector2<T>(-rhs.x, -rhs.y); }
+		friend constexpr TVector2<T> operator-(const TVector2<T>& rhs) { return TVector2<T>(-rhs.x, -rhs.y); }
 
 		/**
 		* @brief  Subtract two TVector2 together.
@@ -190,7 +190,7 @@ namespace LibMath
 		* @param rhs TVector2 on the right side of the operator.
 		* @return A TVector2 holding the sum of the subtraction
 		*/
-		friend TVector2<T> operator-(TVector2<T> lhs, const TVector2<T>& rhs) { lhs -= rhs; return lhs; }
+		friend constexpr TVector2<T> operator-(TVector2<T> lhs, const TVector2<T>& rhs) { lhs -= rhs; return lhs; }
 
 		/**
 		* @brief  Add two TVector2 together.
@@ -198,7 +198,7 @@ namespace LibMath
 		* @param rhs TVector2 on the right side of the operator.
 		* @return A TVector2 holding the sum of the addition
 		*/
-		friend TVector2<T> operator+(TVector2<T> lhs, const TVector2<T>& rhs) { lhs += rhs; return lhs; }
+		friend constexpr TVector2<T> operator+(TVector2<T> lhs, const TVector2<T>& rhs) { lhs += rhs; return lhs; }
 
 		/**
 		* @brief  Multiply two TVector2 together(x*x, y*y).
@@ -206,7 +206,7 @@ namespace LibMath
 		* @param rhs TVector2 on the right side of the operator.
 		* @return A TVector2 holding the sum of the multiplication
 		*/
-		friend TVector2<T> operator*(TVector2<T> lhs, const TVector2<T>& rhs) { lhs *= rhs; return lhs; }
+		friend constexpr TVector2<T> operator*(TVector2<T> lhs, const TVector2<T>& rhs) { lhs *= rhs; return lhs; }
 
 		/**
 		* @brief  Divide two TVector2 together(x/x, y/y).
@@ -214,7 +214,7 @@ namespace LibMath
 		* @param rhs TVector2 on the right side of the operator.
 		* @return A TVector2 holding the sum of the multiplication
 		*/
-		friend TVector2<T> operator/(TVector2<T> lhs, const TVector2<T>& rhs) { lhs /= rhs; return lhs; }
+		friend constexpr TVector2<T> operator/(TVector2<T> lhs, const TVector2<T>& rhs) { lhs /= rhs; return lhs; }
 
 		/**
 		* @brief Calculate the dot product of two vectors.
@@ -222,7 +222,7 @@ namespace LibMath
 		* @param rhs The first vector.
 		* @return The dot product.
 		*/
-		[[nodiscard]] float Dot(const TVector2<T>& rhs) const { return x * rhs.x + y * rhs.y; }
+		[[nodiscard]] constexpr float Dot(const TVector2<T>& rhs) const { return x * rhs.x + y * rhs.y; }
 
 		/**
 		* @brief Checks whether vector is normalized.
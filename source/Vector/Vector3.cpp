@@ -26,19 +26,12 @@ namespace LibMath
 
 	Radian Vector3::AngleBetween(Vector3 first, Vector3 second)
 	{
-		float firstSqSize = first.SquareMagnitude();
-		if (firstSqSize != 1.f)
-		{
-			first /= sqrt(firstSqSize);
-		}
-
-		float secondSqSize = second.SquareMagnitude();
-		if (secondSqSize != 1.f)
-		{
-			second /= sqrt(secondSqSize);
-		}
+		// Normalizing the dot product once avoids normalizing both Vector3, the product
+		// of the square magnitudes is kept in double so large vectors cannot overflow it
+		const double sqSizes = static_cast<double>(first.SquareMagnitude()) * second.SquareMagnitude();
+		const float cosine = sqSizes != 1.0 ? static_cast<float>(first.Dot(second) / std::sqrt(sqSizes)) : first.Dot(second);
 
-		return acos(first.Dot(second));
+		return acos(Clamp(cosine, -1.f, 1.f));
 	}
 
 
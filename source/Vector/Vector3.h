@@ -28,14 +28,14 @@ namespace LibMath
 		/**
 		* Default constructor. All components are zeros.
 		*/
-		Vector3() = default;
+		constexpr Vector3() = default;
 		
 		/**
 		* Default copy constructor.
 		*
 		* @param other	Vector3 to copied
 		*/
-		Vector3(const Vector3& other) = default;
+		constexpr Vector3(const Vector3& other) = default;
 		
 		/**
 		* Default assignment operator.
@@ -43,7 +43,7 @@ namespace LibMath
 		* @param other	Vector3 to copied
 		* @return		A reference to this Vector3
 		*/
-		Vector3& operator=(const Vector3& other) = default;
+		constexpr Vector3& operator=(const Vector3& other) = default;
 		
 		/**
 		* Default destructor.
@@ -55,7 +55,7 @@ namespace LibMath
 		*
 		* @param value	float value for all component
 		*/
-		explicit Vector3(const float value) : x(value), y(value), z(value) {}
+		explicit constexpr Vector3(const float value) : x(value), y(value), z(value) {}
 		
 		/**
 		* Constructor with a specific value for each components
@@ -67,7 +67,7 @@ namespace LibMath
 		* @param pz		position of this Vector3 on the Forward-Backward Axis also known
 		*				as the Z-Axis
 		*/
-		Vector3(const float px, const float py, const float pz) : x(px), y(py), z(pz) {}
+		constexpr Vector3(const float px, const float py, const float pz) : x(px), y(py), z(pz) {}
 
 		/**
 		* Constructor converting a Vector4 into a Vector3. This constructor just drop the
@@ -150,7 +150,7 @@ namespace LibMath
 		* @param other	Vector3 use as a comparison
 		* @return		Whether or not both Vector3 have the exact same component values.
 		*/
-		[[nodiscard]] bool operator==(const Vector3& other) const { return x == other.x && y == other.y && z == other.z; }
+		[[nodiscard]] constexpr bool operator==(const Vector3& other) const { return x == other.x && y == other.y && z == other.z; }
 		
 		/**
 		* Compare this Vector3 with an other one
@@ -159,7 +159,7 @@ namespace LibMath
 		* @return		Whether or not at least one of the component have a different
 		*				value in both Vector
 		*/
-		[[nodiscard]] bool operator!=(Vector3 const& other) const { return !(*this == other); }
+		[[nodiscard]] constexpr bool operator!=(Vector3 const& other) const { return !(*this == other); }
 		
 		/**
 		* Add an other Vector3 to this Vector3. This Vector3 component values will be
@@ -170,8 +170,8 @@ namespace LibMath
 		* @return		A reference on this Vector3
 		*/
 		/*@{*/
-		friend Vector3& operator+=(Vector3& lhs, const Vector3& rhs) { lhs.x += rhs.x; lhs.y += rhs.y; lhs.z += rhs.z; return lhs; }
-		friend Vector3& operator+=(Vector3& lhs, float rhs) { lhs.x += rhs; lhs.y += rhs; lhs.z += rhs; return lhs; }
+		friend constexpr Vector3& operator+=(Vector3& lhs, const Vector3& rhs) { lhs.x += rhs.x; lhs.y += rhs.y; lhs.z += rhs.z; return lhs; }
+		friend constexpr Vector3& operator+=(Vector3& lhs, float rhs) { lhs.x += rhs; lhs.y += rhs; lhs.z += rhs; return lhs; }
 		/*@}*/
 		
 		/**
@@ -182,8 +182,8 @@ namespace LibMath
 		* @return		A reference on this Vector3
 		*/
 		/*@{*/
-		friend Vector3& operator-=(Vector3& lhs, const Vector3& rhs) { lhs.x -= rhs.x; lhs.y -= rhs.y; lhs.z -= rhs.z; return lhs; }
-		friend Vector3& operator-=(Vector3& lhs, float rhs) { lhs.x -= rhs; lhs.y -= rhs; lhs.z -= rhs; return lhs; }
+		friend constexpr Vector3& operator-=(Vector3& lhs, const Vector3& rhs) { lhs.x -= rhs.x; lhs.y -= rhs.y; lhs.z -= rhs.z; return lhs; }
+		friend constexpr Vector3& operator-=(Vector3& lhs, float rhs) { lhs.x -= rhs; lhs.y -= rhs; lhs.z -= rhs; return lhs; }
 		/*@}*/
 		
 		/**
@@ -194,8 +194,8 @@ namespace LibMath
 		* @return		A reference on this Vector3
 		*/
 		/*@{*/
-		friend Vector3& operator*=(Vector3& lhs, const Vector3& rhs) { lhs.x *= rhs.x; lhs.y *= rhs.y; lhs.z *= rhs.z; return lhs; }
-		friend Vector3& operator*=(Vector3& lhs, float rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; return lhs; }
+		friend constexpr Vector3& operator*=(Vector3& lhs, const Vector3& rhs) { lhs.x *= rhs.x; lhs.y *= rhs.y; lhs.z *= rhs.z; return lhs; }
+		friend constexpr Vector3& operator*=(Vector3& lhs, float rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; return lhs; }
 		/*@}*/
 		
 		/**
@@ -206,8 +206,8 @@ namespace LibMath
 		* @return		A reference on this Vector3
 		*/
 		/*@{*/
-		friend Vector3& operator/=(Vector3& lhs, const Vector3& rhs) { lhs.x /= rhs.x; lhs.y /= rhs.y; lhs.z /= rhs.z; return lhs; }
-		friend Vector3& operator/=(Vector3& lhs, float rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; return lhs; }
+		friend constexpr Vector3& operator/=(Vector3& lhs, const Vector3& rhs) { lhs.x /= rhs.x; lhs.y /= rhs.y; lhs.z /= rhs.z; return lhs; }
+		friend constexpr Vector3& operator/=(Vector3& lhs, float rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; return lhs; }
 		/*@}*/
 
 		/**
@@ -220,9 +220,9 @@ namespace LibMath
 		* @return		A Vector3 holding the sum of the addition
 		*/
 		/*@{*/
-		[[nodiscard]] friend Vector3 operator+(Vector3 lhs, const Vector3& rhs) { lhs.x += rhs.x; lhs.y += rhs.y; lhs.z += rhs.z; return lhs; }
-		[[nodiscard]] friend Vector3 operator+(Vector3 lhs, float rhs) { lhs.x += rhs; lhs.y += rhs; lhs.z += rhs; return lhs; }
-		[[nodiscard]] friend Vector3 operator+(float lhs, Vector3 rhs) { rhs.x += lhs; rhs.y += lhs; rhs.z += lhs; return rhs; }
+		[[nodiscard]] friend constexpr Vector3 operator+(Vector3 lhs, const Vector3& rhs) { lhs.x += rhs.x; lhs.y += rhs.y; lhs.z += rhs.z; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator+(Vector3 lhs, float rhs) { lhs.x += rhs; lhs.y += rhs; lhs.z += rhs; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator+(float lhs, Vector3 rhs) { rhs.x += lhs; rhs.y += lhs; rhs.z += lhs; return rhs; }
 		/*@}*/
 		
 		/**
@@ -232,7 +232,7 @@ namespace LibMath
 		* @param rhs	Vector3 on the right side of the operator.
 		* @return		A Vector3 holding the Inverse
 		*/
-		[[nodiscard]] friend Vector3 operator-(const Vector3& rhs) { return Vector3(-rhs.x, -rhs.y, -rhs.z); }
+		[[nodiscard]] friend constexpr Vector3 operator-(const Vector3& rhs) { return Vector3(-rhs.x, -rhs.y, -rhs.z); }
 		/**
 		* Subtract a Vector3 from an other. The resulting Vector3's component values
 		* will be the difference of the component of both Vector3.
@@ -242,9 +242,9 @@ namespace LibMath
 		* @return		A Vector3 holding the difference of the subtraction
 		*/
 		/*@{*/
-		[[nodiscard]] friend Vector3 operator-(Vector3 lhs, const Vector3& rhs) { lhs.x -= rhs.x; lhs.y -= rhs.y; lhs.z -= rhs.z; return lhs; }
-		[[nodiscard]] friend Vector3 operator-(Vector3 lhs, float rhs) { lhs.x -= rhs; lhs.y -= rhs; lhs.z -= rhs; return lhs; }
-		[[nodiscard]] friend Vector3 operator-(float lhs, Vector3 rhs) { rhs.x = lhs - rhs.x; rhs.y = lhs - rhs.y; rhs.z = lhs - rhs.z; return rhs; }
+		[[nodiscard]] friend constexpr Vector3 operator-(Vector3 lhs, const Vector3& rhs) { lhs.x -= rhs.x; lhs.y -= rhs.y; lhs.z -= rhs.z; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator-(Vector3 lhs, float rhs) { lhs.x -= rhs; lhs.y -= rhs; lhs.z -= rhs; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator-(float lhs, Vector3 rhs) { rhs.x = lhs - rhs.x; rhs.y = lhs - rhs.y; rhs.z = lhs - rhs.z; return rhs; }
 		/*@}*/
 		
 		/**
@@ -256,9 +256,9 @@ namespace LibMath
 		* @return		A Vector3 holding the product of the multiplication
 		*/
 		/*@{*/
-		[[nodiscard]] friend Vector3 operator*(Vector3 lhs, const Vector3& rhs) { lhs.x *= rhs.x; lhs.y *= rhs.y; lhs.z *= rhs.z; return lhs; }
-		[[nodiscard]] friend Vector3 operator*(Vector3 lhs, float rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; return lhs; }
-		[[nodiscard]] friend Vector3 operator*(float lhs, Vector3 rhs) { rhs.x *= lhs; rhs.y *= lhs; rhs.z *= lhs; return rhs; }
+		[[nodiscard]] friend constexpr Vector3 operator*(Vector3 lhs, const Vector3& rhs) { lhs.x *= rhs.x; lhs.y *= rhs.y; lhs.z *= rhs.z; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator*(Vector3 lhs, float rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator*(float lhs, Vector3 rhs) { rhs.x *= lhs; rhs.y *= lhs; rhs.z *= lhs; return rhs; }
 		/*@}*/
 		
 		/**
@@ -270,9 +270,9 @@ namespace LibMath
 		* @return		A Vector3 holding the difference of the subtraction
 		*/
 		/*@{*/
-		[[nodiscard]] friend Vector3 operator/(Vector3 lhs, const Vector3& rhs) { lhs.x /= rhs.x; lhs.y /= rhs.y; lhs.z /= rhs.z; return lhs; }
-		[[nodiscard]] friend Vector3 operator/(Vector3 lhs, float rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; return lhs; }
-		[[nodiscard]] friend Vector3 operator/(float lhs, Vector3 rhs) { rhs.x = lhs / rhs.x; rhs.y = lhs / rhs.y; rhs.z = lhs / rhs.z; return rhs; }
+		[[nodiscard]] friend constexpr Vector3 operator/(Vector3 lhs, const Vector3& rhs) { lhs.x /= rhs.x; lhs.y /= rhs.y; lhs.z /= rhs.z; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator/(Vector3 lhs, float rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; return lhs; }
+		[[nodiscard]] friend constexpr Vector3 operator/(float lhs, Vector3 rhs) { rhs.x = lhs / rhs.x; rhs.y = lhs / rhs.y; rhs.z = lhs / rhs.z; return rhs; }
 		/*@}*/
 
 		/**
@@ -283,8 +283,8 @@ namespace LibMath
 		*				the two Vector3
 		*/
 		/*@{*/
-		[[nodiscard]] Vector3 Cross(const Vector3& other) const { return Vector3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x); }
-		[[nodiscard]] static Vector3 Cross(const Vector3& lhs, const Vector3& rhs) { return Vector3(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x); }
+		[[nodiscard]] constexpr Vector3 Cross(const Vector3& other) const { return Vector3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x); }
+		[[nodiscard]] static constexpr Vector3 Cross(const Vector3& lhs, const Vector3& rhs) { return Vector3(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x); }
 		/*@}*/
 
 		/**
@@ -294,8 +294,8 @@ namespace LibMath
 		* @return		the result of the dot product between the two Vector3
 		*/
 		/*@{*/
-		[[nodiscard]] float Dot(const Vector3& other) const { return x * other.x + y * other.y + z * other.z; }
-		[[nodiscard]] static float Dot(const Vector3& lhs, const Vector3& rhs) { return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z; }
+		[[nodiscard]] constexpr float Dot(const Vector3& other) const { return x * other.x + y * other.y + z * other.z; }
+		[[nodiscard]] static constexpr float Dot(const Vector3& lhs, const Vector3& rhs) { return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z; }
 		/*@}*/
 
 		/**
@@ -318,8 +318,8 @@ namespace LibMath
 		* @see			Magnitude()
 		*/
 		/*@{*/
-		[[nodiscard]] float SquareMagnitude() const { return x * x + y * y + z * z; }
-		[[nodiscard]] static float SquareMagnitude(const Vector3& vector) { return vector.x * vector.x + vector.y * vector.y + vector.z * vector.z; }
+		[[nodiscard]] constexpr float SquareMagnitude() const { return x * x + y * y + z * z; }
+		[[nodiscard]] static constexpr float SquareMagnitude(const Vector3& vector) { return vector.x * vector.x + vector.y * vector.y + vector.z * vector.z; }
 		/*@}*/
 
 		/**
@@ -328,28 +328,28 @@ namespace LibMath
 		* @param other	Vector3 use as a comparaison
 		* @return		Wheter or not this vector is shorter than the other
 		*/
-		[[nodiscard]] bool IsShorterThan(Vector3 const& other) const { return SquareMagnitude() < other.SquareMagnitude(); }
+		[[nodiscard]] constexpr bool IsShorterThan(Vector3 const& other) const { return SquareMagnitude() < other.SquareMagnitude(); }
 		/**
 		* Compare this Vector3 magnitude with the magnitude an other one
 		*
 		* @param other	Vector3 use as a comparaison
 		* @return		Wheter or not this vector is shorter or as long as the other
 		*/
-		[[nodiscard]] bool IsShorterOrEqualTo(Vector3 const& other) const { return SquareMagnitude() <= other.SquareMagnitude(); }
+		[[nodiscard]] constexpr bool IsShorterOrEqualTo(Vector3 const& other) const { return SquareMagnitude() <= other.SquareMagnitude(); }
 		/**
 		* Compare this Vector3 magnitude with the magnitude an other one
 		*
 		* @param other	Vector3 use as a comparaison
 		* @return		Wheter or not this vector is longer than the other
 		*/
-		[[nodiscard]] bool IsLongerThan(Vector3 const& other) const { return SquareMagnitude() > other.SquareMagnitude(); }
+		[[nodiscard]] constexpr bool IsLongerThan(Vector3 const& other) const { return SquareMagnitude() > other.SquareMagnitude(); }
 		/**
 		* Compare this Vector3 magnitude with the magnitude an other one
 		*
 		* @param other	Vector3 use as a comparaison
 		* @return		Wheter or not this vector is longer or as long as the other
 		*/
-		[[nodiscard]] bool IsLongerOrEqualTo(Vector3 const& other) const { return SquareMagnitude() >= other.SquareMagnitude(); }
+		[[nodiscard]] constexpr bool IsLongerOrEqualTo(Vector3 const& other) const { return SquareMagnitude() >= other.SquareMagnitude(); }
 		
 		/**
 		* Assuming this Vector3 is not a point, determine if this Vector3 is a unit
@@ -364,7 +364,7 @@ namespace LibMath
 		* Assuming this Vector3 is not a point, change this Vector3 into proportional
 		* unit vector version of itself.
 		*/
-		Vector3& Normalize() { *this /= Magnitude(); return *this; }
+		Vector3& Normalize() { *this *= InverseSqrt(SquareMagnitude(), SqrtPrecision::EXACT); return *this; }
 		/**
 		* Assuming this Vector3 is not a point, create a unit Vector3 proportional to
 		* this Vector3.
@@ -372,10 +372,68 @@ namespace LibMath
 		* @return		A unit Vector3
 		*/
 		/*@{*/
-		[[nodiscard]] Vector3 GetNormalize() const { const float size = Magnitude(); return Vector3(x / size, y / size, z / size); }
-		[[nodiscard]] static Vector3 Normalize(Vector3 vector) { const float size = vector.Magnitude(); vector.x /= size; vector.y /= size; vector.z /= size; return vector; }
+		[[nodiscard]] Vector3 GetNormalize() const { return *this * InverseSqrt(SquareMagnitude(), SqrtPrecision::EXACT); }
+		[[nodiscard]] static Vector3 Normalize(Vector3 vector) { return vector.Normalize(); }
 		/*@}*/
 
+		/**
+		* Change this Vector3 into a unit vector using a reciprocal square root estimate
+		* and a single multiplication. Much cheaper than Normalize() when a few ulp of
+		* error are acceptable. This Vector3 must not be zero.
+		*
+		* @param precision	Accuracy of the reciprocal square root
+		* @return			A reference on this Vector3
+		* @see				SafeNormalize()
+		*/
+		Vector3& FastNormalize(SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON) { *this *= InverseSqrt(SquareMagnitude(), precision); return *this; }
+		/**
+		* Create a unit Vector3 proportional to this Vector3 using a reciprocal square
+		* root estimate. This Vector3 must not be zero.
+		*
+		* @param precision	Accuracy of the reciprocal square root
+		* @return			A unit Vector3
+		*/
+		[[nodiscard]] Vector3 GetFastNormalize(SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON) const { return *this * InverseSqrt(SquareMagnitude(), precision); }
+
+		/**
+		* Same as FastNormalize() but a Vector3 too short to be normalized (including
+		* zero) is replaced by the fallback instead of producing NaN or infinity.
+		*
+		* @param fallback	Value used when this Vector3 is too short, zero if omitted
+		* @param precision	Accuracy of the reciprocal square root
+		* @return			A reference on this Vector3
+		*/
+		/*@{*/
+		Vector3& SafeNormalize(const Vector3& fallback, SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON) { *this = GetSafeNormalize(fallback, precision); return *this; }
+		Vector3& SafeNormalize(SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON) { *this = GetSafeNormalize(precision); return *this; }
+		/*@}*/
+		/**
+		* Same as GetFastNormalize() but a Vector3 too short to be normalized (including
+		* zero) gives the fallback instead of NaN or infinity.
+		*
+		* @param fallback	Value returned when this Vector3 is too short, zero if omitted
+		* @param precision	Accuracy of the reciprocal square root
+		* @return			A unit Vector3 or the fallback
+		*/
+		/*@{*/
+		[[nodiscard]] Vector3 GetSafeNormalize(const Vector3& fallback, SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON) const
+		{
+			const float squareMagnitude = SquareMagnitude();
+			return squareMagnitude > MIN_NORMALIZE_SQUARE_MAGNITUDE ? *this * InverseSqrt(squareMagnitude, precision) : fallback;
+		}
+		[[nodiscard]] Vector3 GetSafeNormalize(SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON) const
+		{
+			const float squareMagnitude = SquareMagnitude();
+			return squareMagnitude > MIN_NORMALIZE_SQUARE_MAGNITUDE ? *this * InverseSqrt(squareMagnitude, precision) : Vector3(0.f);
+		}
+		/*@}*/
+
+		/**
+		* Smallest square magnitude SafeNormalize() still accepts. Below it the
+		* reciprocal square root would overflow.
+		*/
+		static constexpr float MIN_NORMALIZE_SQUARE_MAGNITUDE = 1e-30f;
+
 		/**
 		* Assuming both this Vector3 and the other are point, calculate the distance
 		* between those two points
@@ -447,18 +505,18 @@ namespace LibMath
 		float z = 0.f;
 
 
-		/*todo: test*/[[nodiscard]] static Vector3 Lerp(Vector3 const& lhs, Vector3 const& rhs, float alpha) { return Vector3((1 - alpha) * lhs.x + alpha * rhs.x, (1 - alpha) * lhs.y + alpha * rhs.y, (1 - alpha) * lhs.z + alpha * rhs.z); }
+		/*todo: test*/[[nodiscard]] static constexpr Vector3 Lerp(Vector3 const& lhs, Vector3 const& rhs, float alpha) { return Vector3((1 - alpha) * lhs.x + alpha * rhs.x, (1 - alpha) * lhs.y + alpha * rhs.y, (1 - alpha) * lhs.z + alpha * rhs.z); }
 
 		// todo: glm reflect
 		// todo: glm refract
 	};
 
-	inline Vector3 const Vector3::Zero = Vector3(0.f, 0.f, 0.f);
-	inline Vector3 const Vector3::One = Vector3(1.f, 1.f, 1.f);
-	inline Vector3 const Vector3::Right = Vector3(1.f, 0.f, 0.f);
-	inline Vector3 const Vector3::Left = Vector3(-1.f, 0.f, 0.f);
-	inline Vector3 const Vector3::Up = Vector3(0.f, 1.f, 0.f);
-	inline Vector3 const Vector3::Down = Vector3(0.f, -1.f, 0.f);
-	inline Vector3 const Vector3::Front = Vector3(0.f, 0.f, 1.f);
-	inline Vector3 const Vector3::Back = Vector3(0.f, 0.f, -1.f);
+	inline constexpr Vector3 Vector3::Zero = Vector3(0.f, 0.f, 0.f);
+	inline constexpr Vector3 Vector3::One = Vector3(1.f, 1.f, 1.f);
+	inline constexpr Vector3 Vector3::Right = Vector3(1.f, 0.f, 0.f);
+	inline constexpr Vector3 Vector3::Left = Vector3(-1.f, 0.f, 0.f);
+	inline constexpr Vector3 Vector3::Up = Vector3(0.f, 1.f, 0.f);
+	inline constexpr Vector3 Vector3::Down = Vector3(0.f, -1.f, 0.f);
+	inline constexpr Vector3 Vector3::Front = Vector3(0.f, 0.f, 1.f);
+	inline constexpr Vector3 Vector3::Back = Vector3(0.f, 0.f, -1.f);
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "Vector3SoA.h"
+
+#include "Core/SIMD.h"
+
+namespace LibMath
+{
+	Vector3SoA::Vector3SoA(const Vector3* vectors, const size_t count)
+	{
+		Assign(vectors, count);
+	}
+
+	void Vector3SoA::Assign(const Vector3* vectors, const size_t count)
+	{
+		Resize(count);
+
+		size_t i = 0;
+#if LIBMATH_SSE
+		const float* data = reinterpret_cast<const float*>(vectors);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x, y, z;
+			SIMD::LoadVector3x4(data + i * 3, x, y, z);
+			_mm_storeu_ps(m_x.data() + i, x);
+			_mm_storeu_ps(m_y.data() + i, y);
+			_mm_storeu_ps(m_z.data() + i, z);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			Set(i, vectors[i]);
+		}
+	}
+
+	void Vector3SoA::CopyTo(Vector3* output) const
+	{
+		const size_t count = Size();
+
+		size_t i = 0;
+#if LIBMATH_SSE
+		float* data = reinterpret_cast<float*>(output);
+		for (; i + 4 <= count; i += 4)
+		{
+			SIMD::StoreVector3x4(data + i * 3, _mm_loadu_ps(m_x.data() + i), _mm_loadu_ps(m_y.data() + i), _mm_loadu_ps(m_z.data() + i));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			output[i] = Get(i);
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Vector/Vector3.h"
+
+namespace LibMath
+{
+	/**
+	* Array of Vector3 stored as three separate arrays of x, y and z components.
+	* <p>
+	* This layout lets the batched kernels load four components of the same axis
+	* with a single instruction, without the shuffles an array of Vector3 needs.
+	*/
+	class Vector3SoA
+	{
+	public:
+		Vector3SoA() = default;
+
+		/**
+		* Constructor creating count zero vectors
+		*
+		* @param count	Number of Vector3
+		*/
+		explicit Vector3SoA(const size_t count) : m_x(count), m_y(count), m_z(count) {}
+
+		/**
+		* Constructor copying an array of Vector3
+		*
+		* @param vectors	Array of Vector3
+		* @param count		Number of Vector3 in the array
+		*/
+		Vector3SoA(const Vector3* vectors, size_t count);
+
+		[[nodiscard]] size_t Size() const { return m_x.size(); }
+		[[nodiscard]] bool Empty() const { return m_x.empty(); }
+
+		void Resize(const size_t count) { m_x.resize(count); m_y.resize(count); m_z.resize(count); }
+		void Reserve(const size_t count) { m_x.reserve(count); m_y.reserve(count); m_z.reserve(count); }
+		void Clear() { m_x.clear(); m_y.clear(); m_z.clear(); }
+		void PushBack(const Vector3& vector) { m_x.push_back(vector.x); m_y.push_back(vector.y); m_z.push_back(vector.z); }
+
+		[[nodiscard]] Vector3 Get(const size_t index) const { return Vector3(m_x[index], m_y[index], m_z[index]); }
+		void Set(const size_t index, const Vector3& vector) { m_x[index] = vector.x; m_y[index] = vector.y; m_z[index] = vector.z; }
+
+		/*
+		* @name Component arrays, Size() values each
+		*/
+		/*@{*/
+		[[nodiscard]] float* X() { return m_x.data(); }
+		[[nodiscard]] float* Y() { return m_y.data(); }
+		[[nodiscard]] float* Z() { return m_z.data(); }
+		[[nodiscard]] const float* X() const { return m_x.data(); }
+		[[nodiscard]] const float* Y() const { return m_y.data(); }
+		[[nodiscard]] const float* Z() const { return m_z.data(); }
+		/*@}*/
+
+		/**
+		* Replace the content by a copy of an array of Vector3
+		*
+		* @param vectors	Array of Vector3
+		* @param count		Number of Vector3 in the array
+		*/
+		void Assign(const Vector3* vectors, size_t count);
+
+		/**
+		* Copy the content in an array of Vector3
+		*
+		* @param output		Array of Size() Vector3 receiving the vectors
+		*/
+		void CopyTo(Vector3* output) const;
+
+	private:
+		std::vector<float> m_x;
+		std::vector<float> m_y;
+		std::vector<float> m_z;
+	};
+}
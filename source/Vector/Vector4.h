@@ -29,14 +29,14 @@ namespace LibMath
 		/**
 		* Default constructor. All components are zeros.
 		*/
-		Vector4() = default;
+		constexpr Vector4() = default;
 
 		/**
 		* Default copy constructor.
 		*
 		* @param other	Vector4 to copied
 		*/
-		Vector4(const Vector4& other) = default;
+		constexpr Vector4(const Vector4& other) = default;
 
 		/**
 		* Default assignment operator.
@@ -44,7 +44,7 @@ namespace LibMath
 		* @param other	Vector4 to copied
 		* @return		A reference to this Vector4
 		*/
-		Vector4& operator=(const Vector4& other) = default;
+		constexpr Vector4& operator=(const Vector4& other) = default;
 		/**
 		* Default destructor.
 		*/
@@ -55,7 +55,7 @@ namespace LibMath
 		*
 		* @param value	float value for all component
 		*/
-		Vector4(const float value) : x(value), y(value), z(value), w(value) {}
+		constexpr Vector4(const float value) : x(value), y(value), z(value), w(value) {}
 
 		/**
 		* Constructor with a specific value for each compponents
@@ -68,7 +68,7 @@ namespace LibMath
 		*				as the Z-Axis
 		* @param pw		homogeneous component of this vector
 		*/
-		Vector4(const float px, const float py, const float pz, const float pw) : x(px), y(py), z(pz), w(pw) {}
+		constexpr Vector4(const float px, const float py, const float pz, const float pw) : x(px), y(py), z(pz), w(pw) {}
 
 		/**
 		* Array subscript operator that match the following index with the following
@@ -93,7 +93,7 @@ namespace LibMath
 		*				as the Z-Axis
 		* @return		A Vector4 with w == 0.f
 		*/
-		static Vector4 Direction(const float px, const float py, const float pz) { return Vector4(px, py, pz, 0.f); }
+		static constexpr Vector4 Direction(const float px, const float py, const float pz) { return Vector4(px, py, pz, 0.f); }
 		/**
 		* Create a Vector4 representing a direction from a Vector3 base (w == 0.f)
 		*
@@ -113,7 +113,7 @@ namespace LibMath
 		*				as the Z-Axis
 		* @return		A Vector4 with w == 1.f
 		*/
-		static Vector4 Point(const float x, const float y, const float z) { return Vector4(x, y, z, 1.f); }
+		static constexpr Vector4 Point(const float x, const float y, const float z) { return Vector4(x, y, z, 1.f); }
 
 		/**
 		* Create a Vector4 representing a point from a Vector3 base (w == 1.f)
@@ -129,7 +129,7 @@ namespace LibMath
 		* @param other	Vector4 use as a comparaison
 		* @return		Whether or not both Vector4 have the exact same component values.
 		*/
-		bool operator==(const Vector4& other) const { return w == other.w && x == other.x && y == other.y && z == other.z; }
+		constexpr bool operator==(const Vector4& other) const { return w == other.w && x == other.x && y == other.y && z == other.z; }
 		/**
 		* Compare this Vector4 with an other one
 		*
@@ -137,7 +137,7 @@ namespace LibMath
 		* @return		Wheter or not at least one of the component have a different
 		*				value in both Vector
 		*/
-		bool operator!=(const Vector4& other) const { return w != other.w || x != other.x || y != other.y || z != other.z; }
+		constexpr bool operator!=(const Vector4& other) const { return w != other.w || x != other.x || y != other.y || z != other.z; }
 
 		/**
 		* Add an other Vector4 to this Vector4. This Vector4 component values will be
@@ -147,7 +147,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A reference on this Vector4
 		*/
-		Vector4& operator+=(const Vector4& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w; return *this; }
+		constexpr Vector4& operator+=(const Vector4& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w; return *this; }
 		/**
 		* Substract an other Vector4 from this Vector4. This Vector4 component values
 		* will be decreased by the other Vector4 component values.
@@ -155,7 +155,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A reference on this Vector4
 		*/
-		Vector4& operator-=(const Vector4& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this; }
+		constexpr Vector4& operator-=(const Vector4& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this; }
 		/**
 		* Multiply an other Vector4 to this Vector4. This Vector4 component values will
 		* be multiply by the other Vector4 component values.
@@ -163,7 +163,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A reference on this Vector4
 		*/
-		Vector4& operator*=(const Vector4& rhs) { x *= rhs.x; y *= rhs.y; z *= rhs.z; w *= rhs.w; return *this; }
+		constexpr Vector4& operator*=(const Vector4& rhs) { x *= rhs.x; y *= rhs.y; z *= rhs.z; w *= rhs.w; return *this; }
 		/**
 		* Divide an other Vector4 from this Vector4. This Vector4 component values will
 		* be decreased by the other Vector4 component values.
@@ -171,7 +171,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A reference on this Vector4
 		*/
-		Vector4& operator/=(const Vector4& rhs) { x /= rhs.x; y /= rhs.y; z /= rhs.z; w /= rhs.w; return *this; }
+		constexpr Vector4& operator/=(const Vector4& rhs) { x /= rhs.x; y /= rhs.y; z /= rhs.z; w /= rhs.w; return *this; }
 
 		/**
 		* Add two Vector4 together. The resulting Vector4's component values will be the
@@ -182,7 +182,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A Vector4 holding the sum of the addition
 		*/
-		friend Vector4 operator+(Vector4 lhs, const Vector4& rhs) { lhs += rhs; return lhs; }
+		friend constexpr Vector4 operator+(Vector4 lhs, const Vector4& rhs) { lhs += rhs; return lhs; }
 		/**
 		* Create an inverse copy of this Vector4. The resulting Vector4's component values will
 		* be the inveres values of the component of this Vector4.
@@ -190,7 +190,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A Vector4 holding the Inverse
 		*/
-		friend Vector4 operator-(const Vector4& rhs) { return Vector4(-rhs.x, -rhs.y, -rhs.z, -rhs.w); }
+		friend constexpr Vector4 operator-(const Vector4& rhs) { return Vector4(-rhs.x, -rhs.y, -rhs.z, -rhs.w); }
 		/**
 		* Substract a Vector4 from an other. The resulting Vector4's component values
 		* will be the difference of the component of both Vector4.
@@ -199,7 +199,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A Vector4 holding the difference of the substraction
 		*/
-		friend Vector4 operator-(Vector4 lhs, const Vector4& rhs) { lhs -= rhs; return lhs; }
+		friend constexpr Vector4 operator-(Vector4 lhs, const Vector4& rhs) { lhs -= rhs; return lhs; }
 		/**
 		* Multiply two Vector4 together. The resulting Vector4's component values will
 		* be the product of the component of both Vector4.
@@ -208,7 +208,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A Vector4 holding the product of the multiplication
 		*/
-		friend Vector4 operator*(Vector4 lhs, const Vector4& rhs) { lhs *= rhs; return lhs; }
+		friend constexpr Vector4 operator*(Vector4 lhs, const Vector4& rhs) { lhs *= rhs; return lhs; }
 		/**
 		* Divide a Vector4 by an other. The resulting Vector4's component values will be
 		* the quotient of the component of both Vector4.
@@ -217,7 +217,7 @@ namespace LibMath
 		* @param rhs	Vector4 on the right side of the operator.
 		* @return		A Vector4 holding the difference of the substraction
 		*/
-		friend Vector4 operator/(Vector4 lhs, const Vector4& rhs) { lhs /= rhs; return lhs; }
+		friend constexpr Vector4 operator/(Vector4 lhs, const Vector4& rhs) { lhs /= rhs; return lhs; }
 
 		/**
 		* Assuming this Vector4 is in 3D space, determine if this Vector4 is a direction
@@ -226,14 +226,14 @@ namespace LibMath
 		* @return		Whether or not this Vector4 represent a direction in a 3D
 		*				environment
 		*/
-		[[nodiscard]] bool IsDirection() const { return w == 0.f; }
+		[[nodiscard]] constexpr bool IsDirection() const { return w == 0.f; }
 		/**
 		* Assuming this Vector4 is in 3D space, determine if this Vector4 is a point or
 		* not.
 		*
 		* @return		Whether or not this Vector4 represent a point in a 3D environment
 		*/
-		[[nodiscard]] bool IsPoint() const { return w != 0.f; }
+		[[nodiscard]] constexpr bool IsPoint() const { return w != 0.f; }
 
 		/**
 		* Calculate de dot product between this Vector4 and an other one
@@ -241,7 +241,7 @@ namespace LibMath
 		* @param other	Vector4 use to do the dot product.
 		* @return		the result of the dot product between the two Vector4
 		*/
-		[[nodiscard]] float Dot(Vector4 const& other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+		[[nodiscard]] constexpr float Dot(Vector4 const& other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
 
 		/**
 		* Assuming this Vector4 is in 3D space and represent a point, determine if this
@@ -249,12 +249,12 @@ namespace LibMath
 		*
 		* @return		Whether or not this Vector4 represent a point in a 3D environment
 		*/
-		bool IsHomogenize() const { return w == 1.f; }
+		constexpr bool IsHomogenize() const { return w == 1.f; }
 		/**
 		* Assuming this Vector4 is in 3D space and represent a point, Change this Vector4
 		* to bring it in normal space coordinate.
 		*/
-		void Homogenize() { x /= w; y /= w; z /= w; w = 1.f; }
+		constexpr void Homogenize() { x /= w; y /= w; z /= w; w = 1.f; }
 		/**
 		* Assuming this Vector4 is in 3D space and represent a point, create a copy of
 		* this Vector4 in normal space coordinate.
@@ -262,7 +262,7 @@ namespace LibMath
 		* @return		A Vector4 representing the same point as this one but in normal
 		*				space coordinate.
 		*/
-		[[nodiscard]] Vector4 GetHomogenize() const { return Vector4(x / w, y / w, z / w, 1.f); }
+		[[nodiscard]] constexpr Vector4 GetHomogenize() const { return Vector4(x / w, y / w, z / w, 1.f); }
 
 		/*
 		* @name Coordinates
@@ -0,0 +1,283 @@
+#include "VectorBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+#include "Vector3.h"
+
+namespace LibMath::VectorBatch
+{
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Batched kernels expect tightly packed Vector3");
+
+	namespace
+	{
+		/**
+		 * @brief Number of Vector3 of b transposed at once by PairwiseSquaredDistances, 12KB of SoA data.
+		 * Also the size of the buffers converted to Half in one go.
+		 */
+		constexpr size_t DISTANCE_TILE_SIZE = 1024;
+
+		/**
+		 * @brief Distances computed by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_DISTANCE_COUNT = 1 << 15;
+
+		template <bool Root>
+		void DistancesToKernel(const Vector3& point, const Vector3* points, const size_t count, float* output)
+		{
+			size_t i = 0;
+#if LIBMATH_SSE
+			const __m128 pointX = _mm_set1_ps(point.x);
+			const __m128 pointY = _mm_set1_ps(point.y);
+			const __m128 pointZ = _mm_set1_ps(point.z);
+			const float* data = reinterpret_cast<const float*>(points);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 x, y, z;
+				SIMD::LoadVector3x4(data + i * 3, x, y, z);
+
+				x = _mm_sub_ps(x, pointX);
+				y = _mm_sub_ps(y, pointY);
+				z = _mm_sub_ps(z, pointZ);
+
+				__m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				if constexpr (Root)
+				{
+					result = _mm_sqrt_ps(result);
+				}
+				_mm_storeu_ps(output + i, result);
+			}
+#endif
+			for (; i < count; i++)
+			{
+				const float squareDistance = (points[i] - point).SquareMagnitude();
+				output[i] = Root ? std::sqrt(squareDistance) : squareDistance;
+			}
+		}
+
+		/**
+		 * @brief Square distances from point to the count Vector3 of a tile stored as SoA.
+		 */
+		void SquaredDistancesToTile(const Vector3& point, const float* tileX, const float* tileY, const float* tileZ, const size_t count, float* output)
+		{
+			size_t i = 0;
+#if LIBMATH_SSE
+			const __m128 pointX = _mm_set1_ps(point.x);
+			const __m128 pointY = _mm_set1_ps(point.y);
+			const __m128 pointZ = _mm_set1_ps(point.z);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 x = _mm_sub_ps(_mm_load_ps(tileX + i), pointX);
+				const __m128 y = _mm_sub_ps(_mm_load_ps(tileY + i), pointY);
+				const __m128 z = _mm_sub_ps(_mm_load_ps(tileZ + i), pointZ);
+				_mm_storeu_ps(output + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+			}
+#endif
+			for (; i < count; i++)
+			{
+				const float x = tileX[i] - point.x;
+				const float y = tileY[i] - point.y;
+				const float z = tileZ[i] - point.z;
+				output[i] = x * x + y * y + z * z;
+			}
+		}
+
+		template <bool Root, class TOutput>
+		void ComputeDistancesTo(const Vector3& point, const Vector3* points, const size_t count, TOutput* output)
+		{
+			Parallel::For(count, PARALLEL_DISTANCE_COUNT, [&point, points, output](const size_t begin, const size_t end)
+			{
+				if constexpr (std::is_same_v<TOutput, float>)
+				{
+					DistancesToKernel<Root>(point, points + begin, end - begin, output + begin);
+				}
+				else
+				{
+					float buffer[DISTANCE_TILE_SIZE];
+					for (size_t first = begin; first < end; first += DISTANCE_TILE_SIZE)
+					{
+						const size_t size = std::min(DISTANCE_TILE_SIZE, end - first);
+						DistancesToKernel<Root>(point, points + first, size, buffer);
+						ConvertToHalf(buffer, output + first, size);
+					}
+				}
+			});
+		}
+
+		template <class TOutput>
+		void ComputePairwiseSquaredDistances(const Vector3* a, const size_t countA, const Vector3* b, const size_t countB, TOutput* output)
+		{
+			if (countB == 0)
+			{
+				return;
+			}
+
+			const size_t minRowCount = std::max<size_t>(1, PARALLEL_DISTANCE_COUNT / countB);
+			Parallel::For(countA, minRowCount, [a, b, countB, output](const size_t begin, const size_t end)
+			{
+				alignas(16) float tileX[DISTANCE_TILE_SIZE];
+				alignas(16) float tileY[DISTANCE_TILE_SIZE];
+				alignas(16) float tileZ[DISTANCE_TILE_SIZE];
+				float row[DISTANCE_TILE_SIZE];
+
+				for (size_t tileBegin = 0; tileBegin < countB; tileBegin += DISTANCE_TILE_SIZE)
+				{
+					const size_t tileSize = std::min(DISTANCE_TILE_SIZE, countB - tileBegin);
+					for (size_t j = 0; j < tileSize; j++)
+					{
+						tileX[j] = b[tileBegin + j].x;
+						tileY[j] = b[tileBegin + j].y;
+						tileZ[j] = b[tileBegin + j].z;
+					}
+
+					for (size_t i = begin; i < end; i++)
+					{
+						TOutput* rowOutput = output + i * countB + tileBegin;
+						if constexpr (std::is_same_v<TOutput, float>)
+						{
+							SquaredDistancesToTile(a[i], tileX, tileY, tileZ, tileSize, rowOutput);
+						}
+						else
+						{
+							SquaredDistancesToTile(a[i], tileX, tileY, tileZ, tileSize, row);
+							ConvertToHalf(row, rowOutput, tileSize);
+						}
+					}
+				}
+			});
+		}
+	}
+
+#if LIBMATH_SSE
+	namespace
+	{
+		__m128 InverseSqrt4(const __m128 value, const SqrtPrecision precision)
+		{
+			if (precision == SqrtPrecision::EXACT)
+			{
+				return _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(value));
+			}
+
+			const __m128 estimate = _mm_rsqrt_ps(value);
+			if (precision == SqrtPrecision::ESTIMATE)
+			{
+				return estimate;
+			}
+
+			// estimate * (1.5 - 0.5 * value * estimate^2)
+			const __m128 halfValue = _mm_mul_ps(value, _mm_set1_ps(.5f));
+			const __m128 estimateSq = _mm_mul_ps(estimate, estimate);
+			return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfValue, estimateSq)));
+		}
+
+		template <bool Safe>
+		void NormalizeKernel(const float* input, float* output, const size_t count, const Vector3& fallback, const SqrtPrecision precision)
+		{
+			const __m128 minSquareMagnitude = _mm_set1_ps(Vector3::MIN_NORMALIZE_SQUARE_MAGNITUDE);
+			const __m128 fallbackX = _mm_set1_ps(fallback.x);
+			const __m128 fallbackY = _mm_set1_ps(fallback.y);
+			const __m128 fallbackZ = _mm_set1_ps(fallback.z);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 x, y, z;
+				SIMD::LoadVector3x4(input + i * 3, x, y, z);
+
+				const __m128 squareMagnitude = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				const __m128 factor = InverseSqrt4(squareMagnitude, precision);
+
+				x = _mm_mul_ps(x, factor);
+				y = _mm_mul_ps(y, factor);
+				z = _mm_mul_ps(z, factor);
+
+				if constexpr (Safe)
+				{
+					const __m128 valid = _mm_cmpgt_ps(squareMagnitude, minSquareMagnitude);
+					x = SIMD::Select(valid, x, fallbackX);
+					y = SIMD::Select(valid, y, fallbackY);
+					z = SIMD::Select(valid, z, fallbackZ);
+				}
+
+				SIMD::StoreVector3x4(output + i * 3, x, y, z);
+			}
+
+			const Vector3* inputTail = reinterpret_cast<const Vector3*>(input);
+			Vector3* outputTail = reinterpret_cast<Vector3*>(output);
+			for (; i < count; i++)
+			{
+				outputTail[i] = Safe ? inputTail[i].GetSafeNormalize(fallback, precision) : inputTail[i].GetFastNormalize(precision);
+			}
+		}
+	}
+#endif
+
+	void Normalize(Vector3* vectors, const size_t count, const SqrtPrecision precision)
+	{
+		Normalize(vectors, vectors, count, precision);
+	}
+
+	void Normalize(const Vector3* input, Vector3* output, const size_t count, const SqrtPrecision precision)
+	{
+#if LIBMATH_SSE
+		NormalizeKernel<false>(reinterpret_cast<const float*>(input), reinterpret_cast<float*>(output), count, Vector3::Zero, precision);
+#else
+		for (size_t i = 0; i < count; i++)
+		{
+			output[i] = input[i].GetFastNormalize(precision);
+		}
+#endif
+	}
+
+	void SafeNormalize(Vector3* vectors, const size_t count, const Vector3& fallback, const SqrtPrecision precision)
+	{
+		SafeNormalize(vectors, vectors, count, fallback, precision);
+	}
+
+	void SafeNormalize(const Vector3* input, Vector3* output, const size_t count, const Vector3& fallback, const SqrtPrecision precision)
+	{
+#if LIBMATH_SSE
+		NormalizeKernel<true>(reinterpret_cast<const float*>(input), reinterpret_cast<float*>(output), count, fallback, precision);
+#else
+		for (size_t i = 0; i < count; i++)
+		{
+			output[i] = input[i].GetSafeNormalize(fallback, precision);
+		}
+#endif
+	}
+
+	void SquaredDistancesTo(const Vector3& point, const Vector3* points, const size_t count, float* output)
+	{
+		ComputeDistancesTo<false>(point, points, count, output);
+	}
+
+	void SquaredDistancesTo(const Vector3& point, const Vector3* points, const size_t count, Half* output)
+	{
+		ComputeDistancesTo<false>(point, points, count, output);
+	}
+
+	void DistancesTo(const Vector3& point, const Vector3* points, const size_t count, float* output)
+	{
+		ComputeDistancesTo<true>(point, points, count, output);
+	}
+
+	void DistancesTo(const Vector3& point, const Vector3* points, const size_t count, Half* output)
+	{
+		ComputeDistancesTo<true>(point, points, count, output);
+	}
+
+	void PairwiseSquaredDistances(const Vector3* a, const size_t countA, const Vector3* b, const size_t countB, float* output)
+	{
+		ComputePairwiseSquaredDistances<float>(a, countA, b, countB, output);
+	}
+
+	void PairwiseSquaredDistances(const Vector3* a, const size_t countA, const Vector3* b, const size_t countB, Half* output)
+	{
+		ComputePairwiseSquaredDistances<Half>(a, countA, b, countB, output);
+	}
+}
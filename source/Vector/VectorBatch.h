@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Core/CMath.h"
+#include "Core/Half.h"
+
+namespace LibMath
+{
+	struct Vector3;
+
+	/**
+	 * @brief Kernels working on contiguous arrays of vectors at once.
+	 * Input and output arrays may be the same array but must not partially overlap.
+	 */
+	namespace VectorBatch
+	{
+		/**
+		 * @brief Normalize every Vector3 of an array in place. Vector3 must not be zero.
+		 *
+		 * @param vectors Array of Vector3 to normalize
+		 * @param count Number of Vector3 in the array
+		 * @param precision Accuracy of the reciprocal square root
+		 */
+		void Normalize(Vector3* vectors, size_t count, SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON);
+
+		/**
+		 * @brief Write the unit version of every input Vector3 in output. Vector3 must not be zero.
+		 *
+		 * @param input Array of Vector3 to normalize
+		 * @param output Array receiving the unit Vector3, can be input
+		 * @param count Number of Vector3 in both arrays
+		 * @param precision Accuracy of the reciprocal square root
+		 */
+		void Normalize(const Vector3* input, Vector3* output, size_t count, SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON);
+
+		/**
+		 * @brief Normalize every Vector3 of an array in place, Vector3 too short to be normalized are replaced by fallback.
+		 *
+		 * @param vectors Array of Vector3 to normalize
+		 * @param count Number of Vector3 in the array
+		 * @param fallback Value used for Vector3 too short to be normalized
+		 * @param precision Accuracy of the reciprocal square root
+		 * @see Vector3::SafeNormalize()
+		 */
+		void SafeNormalize(Vector3* vectors, size_t count, const Vector3& fallback, SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON);
+
+		/**
+		 * @brief Write the unit version of every input Vector3 in output, Vector3 too short to be normalized give fallback.
+		 *
+		 * @param input Array of Vector3 to normalize
+		 * @param output Array receiving the unit Vector3, can be input
+		 * @param count Number of Vector3 in both arrays
+		 * @param fallback Value used for Vector3 too short to be normalized
+		 * @param precision Accuracy of the reciprocal square root
+		 * @see Vector3::GetSafeNormalize()
+		 */
+		void SafeNormalize(const Vector3* input, Vector3* output, size_t count, const Vector3& fallback, SqrtPrecision precision = SqrtPrecision::NEWTON_RAPHSON);
+
+		/**
+		 * @brief Square distance from point to every Vector3 of an array. Large arrays are processed in parallel.
+		 *
+		 * @param point Point to measure from
+		 * @param points Array of Vector3
+		 * @param count Number of Vector3 in points and values in output
+		 * @param output Array receiving the square distances
+		 */
+		void SquaredDistancesTo(const Vector3& point, const Vector3* points, size_t count, float* output);
+		void SquaredDistancesTo(const Vector3& point, const Vector3* points, size_t count, Half* output);
+
+		/**
+		 * @brief Distance from point to every Vector3 of an array. Large arrays are processed in parallel.
+		 *
+		 * @param point Point to measure from
+		 * @param points Array of Vector3
+		 * @param count Number of Vector3 in points and values in output
+		 * @param output Array receiving the distances
+		 */
+		void DistancesTo(const Vector3& point, const Vector3* points, size_t count, float* output);
+		void DistancesTo(const Vector3& point, const Vector3* points, size_t count, Half* output);
+
+		/**
+		 * @brief Square distance between every pair of Vector3 taken from a and b.
+		 * The square distance between a[i] and b[j] is written at output[i * countB + j].
+		 * b is processed by tiles that stay in L1 while the rows of a stream through them,
+		 * and the rows are spread over the threads.
+		 *
+		 * @param a First array of Vector3, one output row each
+		 * @param countA Number of Vector3 in a
+		 * @param b Second array of Vector3, one output column each
+		 * @param countB Number of Vector3 in b
+		 * @param output Array of countA * countB values receiving the square distances
+		 */
+		void PairwiseSquaredDistances(const Vector3* a, size_t countA, const Vector3* b, size_t countB, float* output);
+		void PairwiseSquaredDistances(const Vector3* a, size_t countA, const Vector3* b, size_t countB, Half* output);
+	}
+}
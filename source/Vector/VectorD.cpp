@@ -0,0 +1,65 @@
+#include "VectorD.h"
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+
+namespace LibMath
+{
+	namespace
+	{
+		/**
+		 * @brief Positions rebased by a thread before it is worth splitting the work.
+		 */
+		constexpr size_t PARALLEL_REBASE_COUNT = 1 << 15;
+
+		void RebaseScalar(const Vector3d* positions, const Vector3d& origin, Vector3* output, const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				output[i] = (positions[i] - origin).ToVector3();
+			}
+		}
+
+#if LIBMATH_SSE
+		/**
+		 * @brief Four positions, twelve doubles, per iteration: the origin is repeated to line up with three loads.
+		 */
+		LIBMATH_TARGET("avx2")
+		void RebaseAVX2(const Vector3d* positions, const Vector3d& origin, Vector3* output, size_t begin, const size_t end)
+		{
+			const __m256d originA = _mm256_setr_pd(origin.x, origin.y, origin.z, origin.x);
+			const __m256d originB = _mm256_setr_pd(origin.y, origin.z, origin.x, origin.y);
+			const __m256d originC = _mm256_setr_pd(origin.z, origin.x, origin.y, origin.z);
+
+			for (; begin + 4 <= end; begin += 4)
+			{
+				const double* source = &positions[begin].x;
+				float* target = &output[begin].x;
+				_mm_storeu_ps(target, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(source), originA)));
+				_mm_storeu_ps(target + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(source + 4), originB)));
+				_mm_storeu_ps(target + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(source + 8), originC)));
+			}
+
+			RebaseScalar(positions, origin, output, begin, end);
+		}
+#endif
+	}
+
+	void RebaseToFloat(const Vector3d* positions, const Vector3d& origin, Vector3* output, const size_t count)
+	{
+#if LIBMATH_SSE
+		if (SIMD::HasAVX2())
+		{
+			Parallel::For(count, PARALLEL_REBASE_COUNT, [positions, &origin, output](const size_t begin, const size_t end)
+			{
+				RebaseAVX2(positions, origin, output, begin, end);
+			});
+			return;
+		}
+#endif
+		Parallel::For(count, PARALLEL_REBASE_COUNT, [positions, &origin, output](const size_t begin, const size_t end)
+		{
+			RebaseScalar(positions, origin, output, begin, end);
+		});
+	}
+}
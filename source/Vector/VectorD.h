@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "Vector/Vector3.h"
+#include "Vector/Vector4.h"
+
+namespace LibMath
+{
+	/**
+	* Vector3 with double precision components, for positions in worlds too large
+	* for a float to keep a millimetre precision.
+	* <p>
+	* Simulation state is kept in Vector3d, rendering converts it to Vector3
+	* relative to an origin close to the camera with RebaseToFloat(), which keeps
+	* the precision where it is visible.
+	*/
+	struct Vector3d
+	{
+		constexpr Vector3d() = default;
+
+		/**
+		* Constructor with a specific value for each component
+		*
+		* @param px		x component
+		* @param py		y component
+		* @param pz		z component
+		*/
+		constexpr Vector3d(const double px, const double py, const double pz) : x(px), y(py), z(pz) {}
+
+		/**
+		* Constructor widening a Vector3, exactly
+		*
+		* @param other	Vector3 to widen
+		*/
+		explicit constexpr Vector3d(const Vector3& other) : x(other.x), y(other.y), z(other.z) {}
+
+		/**
+		* Round this Vector3d to a Vector3
+		*
+		* @return		The nearest Vector3
+		*/
+		[[nodiscard]] constexpr Vector3 ToVector3() const { return Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)); }
+
+		[[nodiscard]] constexpr bool operator==(const Vector3d& other) const { return x == other.x && y == other.y && z == other.z; }
+		[[nodiscard]] constexpr bool operator!=(const Vector3d& other) const { return !(*this == other); }
+
+		/*
+		* @name Component-wise arithmetic, scaling by a double
+		*/
+		/*@{*/
+		[[nodiscard]] constexpr Vector3d operator+(const Vector3d& other) const { return Vector3d(x + other.x, y + other.y, z + other.z); }
+		[[nodiscard]] constexpr Vector3d operator-(const Vector3d& other) const { return Vector3d(x - other.x, y - other.y, z - other.z); }
+		[[nodiscard]] constexpr Vector3d operator*(const double scale) const { return Vector3d(x * scale, y * scale, z * scale); }
+		[[nodiscard]] constexpr Vector3d operator-() const { return Vector3d(-x, -y, -z); }
+		constexpr Vector3d& operator+=(const Vector3d& other) { x += other.x; y += other.y; z += other.z; return *this; }
+		constexpr Vector3d& operator-=(const Vector3d& other) { x -= other.x; y -= other.y; z -= other.z; return *this; }
+		constexpr Vector3d& operator*=(const double scale) { x *= scale; y *= scale; z *= scale; return *this; }
+		/*@}*/
+
+		[[nodiscard]] constexpr double Dot(const Vector3d& other) const { return x * other.x + y * other.y + z * other.z; }
+		[[nodiscard]] constexpr Vector3d Cross(const Vector3d& other) const { return Vector3d(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x); }
+		[[nodiscard]] constexpr double SquareMagnitude() const { return x * x + y * y + z * z; }
+		[[nodiscard]] double Magnitude() const { return std::sqrt(SquareMagnitude()); }
+
+		/**
+		* Normalize this Vector3d, a zero vector staying zero
+		*
+		* @return		A reference on this Vector3d
+		*/
+		Vector3d& Normalize()
+		{
+			const double magnitude = Magnitude();
+			if (magnitude > 0.0)
+			{
+				*this *= 1.0 / magnitude;
+			}
+			return *this;
+		}
+
+		[[nodiscard]] Vector3d GetNormalize() const { return Vector3d(*this).Normalize(); }
+
+		/*
+		* @name Coordinates
+		*/
+		/*@{*/
+		double x = 0.0;
+		double y = 0.0;
+		double z = 0.0;
+		/*@}*/
+	};
+
+	/**
+	* Vector4 with double precision components.
+	*
+	* @see Vector3d
+	*/
+	struct Vector4d
+	{
+		constexpr Vector4d() = default;
+
+		/**
+		* Constructor with a specific value for each component
+		*
+		* @param px		x component
+		* @param py		y component
+		* @param pz		z component
+		* @param pw		homogeneous component
+		*/
+		constexpr Vector4d(const double px, const double py, const double pz, const double pw) : x(px), y(py), z(pz), w(pw) {}
+
+		/**
+		* Constructor from a Vector3d and an homogeneous component
+		*
+		* @param vector	x, y and z components
+		* @param pw		homogeneous component, 1 for a point and 0 for a direction
+		*/
+		constexpr Vector4d(const Vector3d& vector, const double pw) : x(vector.x), y(vector.y), z(vector.z), w(pw) {}
+
+		/**
+		* Constructor widening a Vector4, exactly
+		*
+		* @param other	Vector4 to widen
+		*/
+		explicit constexpr Vector4d(const Vector4& other) : x(other.x), y(other.y), z(other.z), w(other.w) {}
+
+		/**
+		* Round this Vector4d to a Vector4
+		*
+		* @return		The nearest Vector4
+		*/
+		[[nodiscard]] constexpr Vector4 ToVector4() const { return Vector4(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z), static_cast<float>(w)); }
+
+		[[nodiscard]] constexpr bool operator==(const Vector4d& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
+		[[nodiscard]] constexpr bool operator!=(const Vector4d& other) const { return !(*this == other); }
+
+		/*
+		* @name Coordinates
+		*/
+		/*@{*/
+		double x = 0.0;
+		double y = 0.0;
+		double z = 0.0;
+		double w = 0.0;
+		/*@}*/
+	};
+
+	static_assert(sizeof(Vector3d) == 3 * sizeof(double), "Vector3d must stay tightly packed to be converted in batches");
+	static_assert(sizeof(Vector4d) == 4 * sizeof(double), "Vector4d must stay tightly packed to be converted in batches");
+
+	/**
+	* Convert positions to float relative to an origin, output[i] = positions[i] - origin rounded once.
+	* The subtraction is done in double, so positions close to the origin keep their full float
+	* precision whatever their distance to the world origin. Uses AVX2 when the CPU has it and
+	* processes large arrays in parallel.
+	*
+	* @param positions	Array of positions
+	* @param origin		New origin, usually the camera position
+	* @param output		Array receiving the relative positions
+	* @param count		Number of positions in both arrays
+	*/
+	void RebaseToFloat(const Vector3d* positions, const Vector3d& origin, Vector3* output, size_t count);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Core/Half.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector4.h"
+
+namespace LibMath
+{
+	/**
+	* Vector3 stored with half precision components, 6 bytes instead of 12.
+	* <p>
+	* Vector3H has no arithmetic: widen it with ToVector3() or the batched
+	* ConvertToFloat() to compute, and narrow the results back.
+	*/
+	struct Vector3H
+	{
+		Vector3H() = default;
+
+		/**
+		* Constructor rounding a Vector3 to half precision
+		*
+		* @param other	Vector3 to store
+		*/
+		explicit Vector3H(const Vector3& other) : x(other.x), y(other.y), z(other.z) {}
+
+		/**
+		* Widen this Vector3H to a Vector3, exactly
+		*
+		* @return		The Vector3 stored
+		*/
+		[[nodiscard]] Vector3 ToVector3() const { return Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)); }
+
+		/*
+		* @name Coordinates
+		*/
+		/*@{*/
+		Half x;
+		Half y;
+		Half z;
+		/*@}*/
+	};
+
+	/**
+	* Vector4 stored with half precision components, 8 bytes instead of 16.
+	*
+	* @see Vector3H
+	*/
+	struct Vector4H
+	{
+		Vector4H() = default;
+
+		/**
+		* Constructor rounding a Vector4 to half precision
+		*
+		* @param other	Vector4 to store
+		*/
+		explicit Vector4H(const Vector4& other) : x(other.x), y(other.y), z(other.z), w(other.w) {}
+
+		/**
+		* Widen this Vector4H to a Vector4, exactly
+		*
+		* @return		The Vector4 stored
+		*/
+		[[nodiscard]] Vector4 ToVector4() const { return Vector4(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z), static_cast<float>(w)); }
+
+		/*
+		* @name Coordinates
+		*/
+		/*@{*/
+		Half x;
+		Half y;
+		Half z;
+		Half w;
+		/*@}*/
+	};
+
+	static_assert(sizeof(Vector3H) == 3 * sizeof(Half), "Vector3H must stay tightly packed to be converted in batches");
+	static_assert(sizeof(Vector4H) == 4 * sizeof(Half), "Vector4H must stay tightly packed to be converted in batches");
+	static_assert(sizeof(Vector3) == 3 * sizeof(float) && sizeof(Vector4) == 4 * sizeof(float), "Batched conversions expect tightly packed vectors");
+
+	/*
+	* @name Batched conversions between arrays of vectors and their half precision storage, with F16C when the CPU has it
+	*/
+	/*@{*/
+	inline void ConvertToHalf(const Vector3* input, Vector3H* output, const size_t count) { ConvertToHalf(&input->x, &output->x, count * 3); }
+	inline void ConvertToHalf(const Vector4* input, Vector4H* output, const size_t count) { ConvertToHalf(&input->x, &output->x, count * 4); }
+	inline void ConvertToFloat(const Vector3H* input, Vector3* output, const size_t count) { ConvertToFloat(&input->x, &output->x, count * 3); }
+	inline void ConvertToFloat(const Vector4H* input, Vector4* output, const size_t count) { ConvertToFloat(&input->x, &output->x, count * 4); }
+	/*@}*/
+}
@@ -0,0 +1,411 @@
+#include "VectorReduction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Core/Parallel.h"
+#include "Core/SIMD.h"
+
+namespace LibMath::VectorBatch
+{
+	static_assert(sizeof(Vector3) == 3 * sizeof(float), "Batched kernels expect tightly packed Vector3");
+	static_assert(sizeof(Vector4) == 4 * sizeof(float), "Batched kernels expect tightly packed Vector4");
+
+	namespace
+	{
+		/**
+		 * @brief Number of points reduced by one task. Fixed so the results do not depend on the thread count.
+		 */
+		constexpr size_t REDUCTION_CHUNK_SIZE = 1 << 16;
+
+		/**
+		 * @brief Number of points summed in float lanes before the lanes are added to the double accumulators.
+		 */
+		constexpr size_t ACCUMULATION_BLOCK_SIZE = 64;
+
+		/*
+		* @name Uniform access to the supported layouts: one point at a time or four at once, one register per component
+		*/
+		/*@{*/
+		struct Vector3Source
+		{
+			const Vector3* data;
+
+			[[nodiscard]] Vector3 Get(const size_t i) const { return data[i]; }
+#if LIBMATH_SSE
+			void Load4(const size_t i, __m128& x, __m128& y, __m128& z) const { SIMD::LoadVector3x4(reinterpret_cast<const float*>(data + i), x, y, z); }
+#endif
+		};
+
+		struct Vector4Source
+		{
+			const Vector4* data;
+
+			[[nodiscard]] Vector3 Get(const size_t i) const { return Vector3(data[i].x, data[i].y, data[i].z); }
+#if LIBMATH_SSE
+			void Load4(const size_t i, __m128& x, __m128& y, __m128& z) const
+			{
+				x = _mm_loadu_ps(&data[i].x);
+				y = _mm_loadu_ps(&data[i + 1].x);
+				z = _mm_loadu_ps(&data[i + 2].x);
+				__m128 w = _mm_loadu_ps(&data[i + 3].x);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+			}
+#endif
+		};
+
+		struct SoASource
+		{
+			const float* x;
+			const float* y;
+			const float* z;
+
+			[[nodiscard]] Vector3 Get(const size_t i) const { return Vector3(x[i], y[i], z[i]); }
+#if LIBMATH_SSE
+			void Load4(const size_t i, __m128& outX, __m128& outY, __m128& outZ) const
+			{
+				outX = _mm_loadu_ps(x + i);
+				outY = _mm_loadu_ps(y + i);
+				outZ = _mm_loadu_ps(z + i);
+			}
+#endif
+		};
+		/*@}*/
+
+		struct Sums
+		{
+			double x = 0.0;
+			double y = 0.0;
+			double z = 0.0;
+		};
+
+		struct Moments
+		{
+			double xx = 0.0;
+			double xy = 0.0;
+			double xz = 0.0;
+			double yy = 0.0;
+			double yz = 0.0;
+			double zz = 0.0;
+		};
+
+		struct SquareMagnitudeRange
+		{
+			float min = std::numeric_limits<float>::infinity();
+			float max = 0.f;
+		};
+
+#if LIBMATH_SSE
+		float HorizontalMin(const __m128 value)
+		{
+			const __m128 half = _mm_min_ps(value, _mm_movehl_ps(value, value));
+			return _mm_cvtss_f32(_mm_min_ss(half, _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		float HorizontalMax(const __m128 value)
+		{
+			const __m128 half = _mm_max_ps(value, _mm_movehl_ps(value, value));
+			return _mm_cvtss_f32(_mm_max_ss(half, _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		double HorizontalSum(const __m128 value)
+		{
+			alignas(16) float lanes[4];
+			_mm_store_ps(lanes, value);
+			return (static_cast<double>(lanes[0]) + lanes[1]) + (static_cast<double>(lanes[2]) + lanes[3]);
+		}
+
+		/**
+		 * @brief End of the next block of whole groups of four points accumulated in float.
+		 */
+		size_t BlockEnd(const size_t i, const size_t end)
+		{
+			return i + std::min(ACCUMULATION_BLOCK_SIZE, (end - i) & ~size_t(3));
+		}
+#endif
+
+		template <class Source>
+		AABB BoundsRange(const Source& source, const size_t begin, const size_t end)
+		{
+			AABB bounds;
+			size_t i = begin;
+#if LIBMATH_SSE
+			if (end - begin >= 4)
+			{
+				__m128 minX = _mm_set1_ps(std::numeric_limits<float>::infinity());
+				__m128 minY = minX;
+				__m128 minZ = minX;
+				__m128 maxX = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+				__m128 maxY = maxX;
+				__m128 maxZ = maxX;
+
+				for (; i + 4 <= end; i += 4)
+				{
+					__m128 x, y, z;
+					source.Load4(i, x, y, z);
+					minX = _mm_min_ps(minX, x);
+					minY = _mm_min_ps(minY, y);
+					minZ = _mm_min_ps(minZ, z);
+					maxX = _mm_max_ps(maxX, x);
+					maxY = _mm_max_ps(maxY, y);
+					maxZ = _mm_max_ps(maxZ, z);
+				}
+
+				bounds = AABB(Vector3(HorizontalMin(minX), HorizontalMin(minY), HorizontalMin(minZ)), Vector3(HorizontalMax(maxX), HorizontalMax(maxY), HorizontalMax(maxZ)));
+			}
+#endif
+			for (; i < end; i++)
+			{
+				bounds.Extend(source.Get(i));
+			}
+			return bounds;
+		}
+
+		template <class Source>
+		Sums SumRange(const Source& source, const size_t begin, const size_t end)
+		{
+			Sums sums;
+			size_t i = begin;
+#if LIBMATH_SSE
+			while (i + 4 <= end)
+			{
+				__m128 sumX = _mm_setzero_ps();
+				__m128 sumY = _mm_setzero_ps();
+				__m128 sumZ = _mm_setzero_ps();
+
+				for (const size_t blockEnd = BlockEnd(i, end); i < blockEnd; i += 4)
+				{
+					__m128 x, y, z;
+					source.Load4(i, x, y, z);
+					sumX = _mm_add_ps(sumX, x);
+					sumY = _mm_add_ps(sumY, y);
+					sumZ = _mm_add_ps(sumZ, z);
+				}
+
+				sums.x += HorizontalSum(sumX);
+				sums.y += HorizontalSum(sumY);
+				sums.z += HorizontalSum(sumZ);
+			}
+#endif
+			for (; i < end; i++)
+			{
+				const Vector3 point = source.Get(i);
+				sums.x += point.x;
+				sums.y += point.y;
+				sums.z += point.z;
+			}
+			return sums;
+		}
+
+		template <class Source>
+		Moments MomentsRange(const Source& source, const size_t begin, const size_t end, const Vector3& center)
+		{
+			Moments moments;
+			size_t i = begin;
+#if LIBMATH_SSE
+			const __m128 centerX = _mm_set1_ps(center.x);
+			const __m128 centerY = _mm_set1_ps(center.y);
+			const __m128 centerZ = _mm_set1_ps(center.z);
+
+			while (i + 4 <= end)
+			{
+				__m128 xx = _mm_setzero_ps();
+				__m128 xy = _mm_setzero_ps();
+				__m128 xz = _mm_setzero_ps();
+				__m128 yy = _mm_setzero_ps();
+				__m128 yz = _mm_setzero_ps();
+				__m128 zz = _mm_setzero_ps();
+
+				for (const size_t blockEnd = BlockEnd(i, end); i < blockEnd; i += 4)
+				{
+					__m128 x, y, z;
+					source.Load4(i, x, y, z);
+					x = _mm_sub_ps(x, centerX);
+					y = _mm_sub_ps(y, centerY);
+					z = _mm_sub_ps(z, centerZ);
+
+					xx = _mm_add_ps(xx, _mm_mul_ps(x, x));
+					xy = _mm_add_ps(xy, _mm_mul_ps(x, y));
+					xz = _mm_add_ps(xz, _mm_mul_ps(x, z));
+					yy = _mm_add_ps(yy, _mm_mul_ps(y, y));
+					yz = _mm_add_ps(yz, _mm_mul_ps(y, z));
+					zz = _mm_add_ps(zz, _mm_mul_ps(z, z));
+				}
+
+				moments.xx += HorizontalSum(xx);
+				moments.xy += HorizontalSum(xy);
+				moments.xz += HorizontalSum(xz);
+				moments.yy += HorizontalSum(yy);
+				moments.yz += HorizontalSum(yz);
+				moments.zz += HorizontalSum(zz);
+			}
+#endif
+			for (; i < end; i++)
+			{
+				const Vector3 delta = source.Get(i) - center;
+				moments.xx += delta.x * delta.x;
+				moments.xy += delta.x * delta.y;
+				moments.xz += delta.x * delta.z;
+				moments.yy += delta.y * delta.y;
+				moments.yz += delta.y * delta.z;
+				moments.zz += delta.z * delta.z;
+			}
+			return moments;
+		}
+
+		template <class Source>
+		SquareMagnitudeRange MagnitudeRange(const Source& source, const size_t begin, const size_t end)
+		{
+			SquareMagnitudeRange range;
+			size_t i = begin;
+#if LIBMATH_SSE
+			if (end - begin >= 4)
+			{
+				__m128 minimum = _mm_set1_ps(std::numeric_limits<float>::infinity());
+				__m128 maximum = _mm_setzero_ps();
+
+				for (; i + 4 <= end; i += 4)
+				{
+					__m128 x, y, z;
+					source.Load4(i, x, y, z);
+					const __m128 squareMagnitude = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+					minimum = _mm_min_ps(minimum, squareMagnitude);
+					maximum = _mm_max_ps(maximum, squareMagnitude);
+				}
+
+				range.min = HorizontalMin(minimum);
+				range.max = HorizontalMax(maximum);
+			}
+#endif
+			for (; i < end; i++)
+			{
+				const float squareMagnitude = source.Get(i).SquareMagnitude();
+				range.min = std::min(range.min, squareMagnitude);
+				range.max = std::max(range.max, squareMagnitude);
+			}
+			return range;
+		}
+
+		template <class Source>
+		AABB Bounds(const Source& source, const size_t count)
+		{
+			return Parallel::Reduce(count, REDUCTION_CHUNK_SIZE, AABB(),
+				[&source](const size_t begin, const size_t end) { return BoundsRange(source, begin, end); },
+				[](AABB first, const AABB& second) { first.Merge(second); return first; });
+		}
+
+		template <class Source>
+		Vector3 Mean(const Source& source, const size_t count)
+		{
+			if (count == 0)
+			{
+				return Vector3(0.f);
+			}
+
+			const Sums sums = Parallel::Reduce(count, REDUCTION_CHUNK_SIZE, Sums(),
+				[&source](const size_t begin, const size_t end) { return SumRange(source, begin, end); },
+				[](const Sums& first, const Sums& second) { return Sums{ first.x + second.x, first.y + second.y, first.z + second.z }; });
+
+			const double inverseCount = 1.0 / static_cast<double>(count);
+			return Vector3(static_cast<float>(sums.x * inverseCount), static_cast<float>(sums.y * inverseCount), static_cast<float>(sums.z * inverseCount));
+		}
+
+		template <class Source>
+		Matrix3 Covariance(const Source& source, const size_t count)
+		{
+			if (count == 0)
+			{
+				return Matrix3();
+			}
+
+			const Vector3 center = Mean(source, count);
+			const Moments moments = Parallel::Reduce(count, REDUCTION_CHUNK_SIZE, Moments(),
+				[&source, &center](const size_t begin, const size_t end) { return MomentsRange(source, begin, end, center); },
+				[](const Moments& first, const Moments& second)
+				{
+					return Moments{ first.xx + second.xx, first.xy + second.xy, first.xz + second.xz, first.yy + second.yy, first.yz + second.yz, first.zz + second.zz };
+				});
+
+			const double inverseCount = 1.0 / static_cast<double>(count);
+			const float xx = static_cast<float>(moments.xx * inverseCount);
+			const float xy = static_cast<float>(moments.xy * inverseCount);
+			const float xz = static_cast<float>(moments.xz * inverseCount);
+			const float yy = static_cast<float>(moments.yy * inverseCount);
+			const float yz = static_cast<float>(moments.yz * inverseCount);
+			const float zz = static_cast<float>(moments.zz * inverseCount);
+			return Matrix3(xx, xy, xz, xy, yy, yz, xz, yz, zz);
+		}
+
+		template <class Source>
+		void MinMax(const Source& source, const size_t count, float& outMin, float& outMax)
+		{
+			const SquareMagnitudeRange range = Parallel::Reduce(count, REDUCTION_CHUNK_SIZE, SquareMagnitudeRange(),
+				[&source](const size_t begin, const size_t end) { return MagnitudeRange(source, begin, end); },
+				[](const SquareMagnitudeRange& first, const SquareMagnitudeRange& second) { return SquareMagnitudeRange{ std::min(first.min, second.min), std::max(first.max, second.max) }; });
+
+			outMin = std::sqrt(range.min);
+			outMax = std::sqrt(range.max);
+		}
+	}
+
+	AABB ComputeBounds(const Vector3* points, const size_t count)
+	{
+		return Bounds(Vector3Source{ points }, count);
+	}
+
+	AABB ComputeBounds(const Vector4* points, const size_t count)
+	{
+		return Bounds(Vector4Source{ points }, count);
+	}
+
+	AABB ComputeBounds(const Vector3SoA& points)
+	{
+		return Bounds(SoASource{ points.X(), points.Y(), points.Z() }, points.Size());
+	}
+
+	Vector3 Centroid(const Vector3* points, const size_t count)
+	{
+		return Mean(Vector3Source{ points }, count);
+	}
+
+	Vector3 Centroid(const Vector4* points, const size_t count)
+	{
+		return Mean(Vector4Source{ points }, count);
+	}
+
+	Vector3 Centroid(const Vector3SoA& points)
+	{
+		return Mean(SoASource{ points.X(), points.Y(), points.Z() }, points.Size());
+	}
+
+	Matrix3 Covariance3x3(const Vector3* points, const size_t count)
+	{
+		return Covariance(Vector3Source{ points }, count);
+	}
+
+	Matrix3 Covariance3x3(const Vector4* points, const size_t count)
+	{
+		return Covariance(Vector4Source{ points }, count);
+	}
+
+	Matrix3 Covariance3x3(const Vector3SoA& points)
+	{
+		return Covariance(SoASource{ points.X(), points.Y(), points.Z() }, points.Size());
+	}
+
+	void MinMaxMagnitude(const Vector3* vectors, const size_t count, float& outMin, float& outMax)
+	{
+		MinMax(Vector3Source{ vectors }, count, outMin, outMax);
+	}
+
+	void MinMaxMagnitude(const Vector4* vectors, const size_t count, float& outMin, float& outMax)
+	{
+		MinMax(Vector4Source{ vectors }, count, outMin, outMax);
+	}
+
+	void MinMaxMagnitude(const Vector3SoA& vectors, float& outMin, float& outMax)
+	{
+		MinMax(SoASource{ vectors.X(), vectors.Y(), vectors.Z() }, vectors.Size(), outMin, outMax);
+	}
+}
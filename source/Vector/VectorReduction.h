@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Matrix/Matrix3.h"
+#include "Spatial/AABB.h"
+#include "Vector/Vector3.h"
+#include "Vector/Vector3SoA.h"
+#include "Vector/Vector4.h"
+
+namespace LibMath
+{
+	/**
+	 * @brief Reductions over arrays of points, vectorized and spread over the worker threads.
+	 * The input is cut in fixed size chunks combined in a fixed order, so results do not depend
+	 * on the number of threads. Vector4 arrays are read as points: w is ignored.
+	 */
+	namespace VectorBatch
+	{
+		/**
+		 * @brief Smallest box containing every point.
+		 *
+		 * @param points Array of points
+		 * @param count Number of points
+		 * @return The bounds, an empty AABB if count is 0
+		 */
+		[[nodiscard]] AABB ComputeBounds(const Vector3* points, size_t count);
+		[[nodiscard]] AABB ComputeBounds(const Vector4* points, size_t count);
+		[[nodiscard]] AABB ComputeBounds(const Vector3SoA& points);
+
+		/**
+		 * @brief Average of the points, accumulated in double precision.
+		 *
+		 * @param points Array of points
+		 * @param count Number of points
+		 * @return The centroid, zero if count is 0
+		 */
+		[[nodiscard]] Vector3 Centroid(const Vector3* points, size_t count);
+		[[nodiscard]] Vector3 Centroid(const Vector4* points, size_t count);
+		[[nodiscard]] Vector3 Centroid(const Vector3SoA& points);
+
+		/**
+		 * @brief Covariance matrix of the points around their centroid, divided by the number of points.
+		 * The centroid is computed first so large coordinates do not cancel the result.
+		 *
+		 * @param points Array of points
+		 * @param count Number of points
+		 * @return The symmetric covariance matrix, zero if count is 0
+		 */
+		[[nodiscard]] Matrix3 Covariance3x3(const Vector3* points, size_t count);
+		[[nodiscard]] Matrix3 Covariance3x3(const Vector4* points, size_t count);
+		[[nodiscard]] Matrix3 Covariance3x3(const Vector3SoA& points);
+
+		/**
+		 * @brief Shortest and longest magnitude of the vectors.
+		 *
+		 * @param vectors Array of vectors
+		 * @param count Number of vectors, at least 1
+		 * @param outMin Receives the smallest magnitude
+		 * @param outMax Receives the largest magnitude
+		 */
+		void MinMaxMagnitude(const Vector3* vectors, size_t count, float& outMin, float& outMax);
+		void MinMaxMagnitude(const Vector4* vectors, size_t count, float& outMin, float& outMax);
+		void MinMaxMagnitude(const Vector3SoA& vectors, float& outMin, float& outMax);
+	}
+}